@@ -19,9 +19,12 @@
 // A set of inline byte swapping routines for arrays.                   //
 //                                                                      //
 // The bswapcpy16() and bswapcpy32() routines are used for packing      //
-// arrays of basic types into a buffer in a byte swapped order. Use     //
-// of asm and the `bswap' opcode (available on i486 and up) reduces     //
-// byte swapping overhead on linux.                                     //
+// arrays of basic types into a buffer in a byte swapped order.         //
+//                                                                      //
+// DEPRECATED: TBufferFile does not use these routines anymore, it byte //
+// swaps arrays of all sizes with its own vectorized kernel. They are   //
+// kept as portable C++ (instead of the former i386 assembler) for      //
+// code which still includes this header.                               //
 //                                                                      //
 // Use of routines is similar to that of memcpy.                        //
 //                                                                      //
@@ -38,44 +41,36 @@
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
-#if !defined(__CINT__)
-#include <sys/types.h>
-#endif
+#include <ROOT/RConfig.hxx>
+
+#include <cstddef>
 
-extern inline void * bswapcpy16(void * to, const void * from, size_t n)
+R__DEPRECATED(6, 20, "use TBuffer::ReadFastArray/WriteFastArray")
+inline void *bswapcpy16(void *to, const void *from, size_t n)
 {
-int d0, d1, d2, d3;
-__asm__ __volatile__(
-        "cld\n"
-        "1:\tlodsw\n\t"
-        "rorw $8, %%ax\n\t"
-        "stosw\n\t"
-        "loop 1b\n\t"
-        :"=&c" (d0), "=&D" (d1), "=&S" (d2), "=&a" (d3)
-        :"0" (n), "1" ((long) to),"2" ((long) from)
-        :"memory");
-return (to);
+   unsigned char *out = static_cast<unsigned char *>(to);
+   const unsigned char *in = static_cast<const unsigned char *>(from);
+   for (size_t i = 0; i < n; ++i, out += 2, in += 2) {
+      const unsigned char b0 = in[0];
+      out[0] = in[1];
+      out[1] = b0;
+   }
+   return to;
 }
 
-extern inline void * bswapcpy32(void * to, const void * from, size_t n)
+R__DEPRECATED(6, 20, "use TBuffer::ReadFastArray/WriteFastArray")
+inline void *bswapcpy32(void *to, const void *from, size_t n)
 {
-int d0, d1, d2, d3;
-__asm__ __volatile__(
-        "cld\n"
-        "1:\tlodsl\n\t"
-#if !defined __i486__ && !defined __pentium__ && !defined __pentiumpro__ && \
-    !defined __pentium4__ && !defined __x86_64__
-        "rorw $8, %%ax\n\t"
-        "rorl $16, %%eax\n\t"
-        "rorw $8, %%ax\n\t"
-#else
-        "bswap %%eax\n\t"
-#endif
-        "stosl\n\t"
-        "loop 1b\n\t"
-        :"=&c" (d0), "=&D" (d1), "=&S" (d2), "=&a" (d3)
-        :"0" (n), "1" ((long) to),"2" ((long) from)
-        :"memory");
-return (to);
+   unsigned char *out = static_cast<unsigned char *>(to);
+   const unsigned char *in = static_cast<const unsigned char *>(from);
+   for (size_t i = 0; i < n; ++i, out += 4, in += 4) {
+      const unsigned char b0 = in[0], b1 = in[1];
+      out[0] = in[3];
+      out[1] = in[2];
+      out[2] = b1;
+      out[3] = b0;
+   }
+   return to;
 }
+
 #endif
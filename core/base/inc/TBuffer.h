@@ -129,7 +129,9 @@ public:
    virtual Version_t  ReadVersion(UInt_t *start = 0, UInt_t *bcnt = 0, const TClass *cl = 0) = 0;
    virtual Version_t  ReadVersionNoCheckSum(UInt_t *start = 0, UInt_t *bcnt = 0) = 0;
    virtual Version_t  ReadVersionForMemberWise(const TClass *cl = 0) = 0;
+   virtual Bool_t     ReadVersionForCompiledStreamer(const TClass * /* cl */, Version_t /* compiledVersion */, const char *const * /* members */, UInt_t * /* start */, UInt_t * /* bcnt */) { return kFALSE; }
    virtual UInt_t     WriteVersion(const TClass *cl, Bool_t useBcnt = kFALSE) = 0;
+   virtual Bool_t     WriteVersionForCompiledStreamer(const TClass * /* cl */, Version_t /* compiledVersion */, const char *const * /* members */, UInt_t * /* bcnt */) { return kFALSE; }
    virtual UInt_t     WriteVersionMemberWise(const TClass *cl, Bool_t useBcnt = kFALSE) = 0;
 
    virtual void      *ReadObjectAny(const TClass* cast) = 0;
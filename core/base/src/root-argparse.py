@@ -18,6 +18,7 @@ An extensive Users Guide is available from that site (see below).
 	parser.add_argument('-h','-?', '--help', help='Show summary of options')
 	parser.add_argument('--version', help='Show the ROOT version')
 	parser.add_argument('--notebook', help='Execute ROOT notebook')
+	parser.add_argument('--fork-server <socket> [libs]', help='Load libs once, then fork a batch session for each job sent to socket')
 	parser.add_argument('--web', help='Display graphics in a default web browser')
 	parser.add_argument('--web=<browser>', help='Display graphics in specified web browser')
 	parser.add_argument('[dir]', help='if dir is a valid directory cd to it before executing')
@@ -634,6 +634,9 @@ TProtoClass *TClassTable::GetProto(const char *cname)
    }
 
    TClassRec *r = FindElement(cname);
+   // the protoclass might be in a PCM not read yet (Root.LazyPCM)
+   if ((!r || !r->fProto) && gCling && gCling->LoadDeferredPCMs(cname, r && r->fDict))
+      r = FindElement(cname);
    if (r) return r->fProto;
    return 0;
 }
@@ -655,6 +658,9 @@ TProtoClass *TClassTable::GetProtoNorm(const char *cname)
    }
 
    TClassRec *r = FindElementImpl(cname,kFALSE);
+   // the protoclass might be in a PCM not read yet (Root.LazyPCM)
+   if ((!r || !r->fProto) && gCling && gCling->LoadDeferredPCMs(cname, r && r->fDict))
+      r = FindElementImpl(cname,kFALSE);
    if (r) return r->fProto;
    return 0;
 }
@@ -134,6 +134,11 @@ This allows the header to be inlined within the dictionary
 	parser.add_argument('-interpreteronly', help='No IO information in the dictionary\n')
 	parser.add_argument('-noIncludePaths', help="""Do not store the headers' directories in the dictionary
 Instead, rely on the environment variable $ROOT_INCLUDE_PATH at runtime
+""")
+	parser.add_argument('-compiledStreamers', help="""Inline the reading and writing of the data members in the generated Streamer()
+of classes made only of fundamental types and fixed size arrays thereof.
+The inlined code is used when the data has the in-memory layout of the
+class, otherwise the usual schema evolution applies.
 """)
 	parser.add_argument('-excludePath', help="""Specify a path to be excluded from the include paths
 specified for building this dictionary
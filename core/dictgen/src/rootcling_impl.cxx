@@ -125,6 +125,7 @@ const std::string gPathSeparator(ROOT::TMetaUtils::GetPathSeparator());
 #endif
 
 bool gBuildingROOT = false;
+bool gCompiledStreamers = false; // -compiledStreamers: inline the read and write of simple classes in their Streamer()
 const ROOT::Internal::RootCling::DriverConfig* gDriverConfig = nullptr;
 
 namespace {
@@ -1830,6 +1831,95 @@ void WriteStreamer(const ROOT::TMetaUtils::AnnotatedRecordDecl &cl,
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write into readCode and writeCode the statements reading and writing, in
+/// the order of the StreamerInfo, the persistent data members of a class made
+/// only of fundamental types and fixed size arrays thereof, with at most
+/// TObject as base class, and into members the quoted names of the
+/// corresponding StreamerInfo elements. Return false if the class does not
+/// have such a simple layout, in which case only the generic ReadClassBuffer
+/// and WriteClassBuffer can be used.
+///
+/// The comments of the data members are not available for declarations coming
+/// from a PCH or a module, so a transient member may be taken as persistent
+/// here. The generated code is therefore only used when the elements of the
+/// StreamerInfo are exactly the listed members, see
+/// TBufferFile::ReadVersionForCompiledStreamer.
+
+bool WriteCompiledStreamerCode(const clang::CXXRecordDecl *clxx, std::ostream &readCode, std::ostream &writeCode,
+                               std::ostream &members)
+{
+   for (auto &&base : clxx->bases()) {
+      const clang::CXXRecordDecl *baseDecl = base.getType()->getAsCXXRecordDecl();
+      std::string baseName;
+      if (baseDecl) ROOT::TMetaUtils::GetQualifiedName(baseName, *baseDecl);
+      if (base.isVirtual() || baseName != "TObject" || clxx->getNumBases() != 1)
+         return false;
+      readCode << "         TObject::Streamer(R__b);" << std::endl;
+      writeCode << "         TObject::Streamer(R__b);" << std::endl;
+      members << "\"TObject\", ";
+   }
+
+   const clang::ASTContext &ctxt = clxx->getASTContext();
+   for (auto &&field : clxx->fields()) {
+      const char *comment = ROOT::TMetaUtils::GetComment(*field).data();
+      if (comment[0] == '!') continue; // Transient.
+      if (comment[0] == '[' || field->isBitField() || field->getName() == "fBits") return false;
+
+      clang::QualType type = field->getType();
+      std::string type_name = type.getAsString(ctxt.getPrintingPolicy());
+      // Opaque typedefs with their own on-file representation.
+      if (strstr(type_name.c_str(), "Float16_t") || strstr(type_name.c_str(), "Double32_t")) return false;
+
+      size_t arrayLength = 0;
+      bool multiDim = false;
+      if (const clang::ConstantArrayType *arrayType = ctxt.getAsConstantArrayType(type)) {
+         arrayLength = GetFullArrayLength(arrayType);
+         multiDim = arrayType->getElementType()->isArrayType();
+      } else if (type->isArrayType()) {
+         return false;
+      }
+      clang::QualType element = ctxt.getBaseElementType(type);
+      if (element.isConstQualified()) return false;
+      const clang::BuiltinType *builtin = llvm::dyn_cast<clang::BuiltinType>(element.getCanonicalType().getTypePtr());
+      if (!builtin) return false;
+      switch (builtin->getKind()) {
+         case clang::BuiltinType::Bool:
+         case clang::BuiltinType::Char_S:
+         case clang::BuiltinType::Char_U:
+         case clang::BuiltinType::UChar:
+         case clang::BuiltinType::Short:
+         case clang::BuiltinType::UShort:
+         case clang::BuiltinType::Int:
+         case clang::BuiltinType::UInt:
+         case clang::BuiltinType::LongLong:
+         case clang::BuiltinType::ULongLong:
+         case clang::BuiltinType::Float:
+         case clang::BuiltinType::Double:
+            break;
+         default:
+            // long (special on-file size), enums are not enumerated here, etc.
+            return false;
+      }
+
+      const std::string name = field->getName().str();
+      if (!arrayLength) {
+         readCode << "         R__b >> " << name << ";" << std::endl;
+         writeCode << "         R__b << " << name << ";" << std::endl;
+      } else if (multiDim) {
+         readCode << "         R__b.ReadFastArray((" << ROOT::TMetaUtils::TrueName(*field) << "*)" << name << ", "
+                  << arrayLength << ");" << std::endl;
+         writeCode << "         R__b.WriteFastArray((" << ROOT::TMetaUtils::TrueName(*field) << "*)" << name << ", "
+                   << arrayLength << ");" << std::endl;
+      } else {
+         readCode << "         R__b.ReadFastArray(" << name << ", " << arrayLength << ");" << std::endl;
+         writeCode << "         R__b.WriteFastArray(" << name << ", " << arrayLength << ");" << std::endl;
+      }
+      members << "\"" << name << "\", ";
+   }
+   return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void WriteAutoStreamer(const ROOT::TMetaUtils::AnnotatedRecordDecl &cl,
@@ -1868,13 +1958,40 @@ void WriteAutoStreamer(const ROOT::TMetaUtils::AnnotatedRecordDecl &cl,
    if (add_template_keyword) dictStream << "template <> ";
    dictStream << "void " << clsname << "::Streamer(TBuffer &R__b)" << std::endl
               << "{" << std::endl
-              << "   // Stream an object of class " << fullname << "." << std::endl << std::endl
-              << "   if (R__b.IsReading()) {" << std::endl
-              << "      R__b.ReadClassBuffer(" << fullname << "::Class(),this);" << std::endl
-              << "   } else {" << std::endl
-              << "      R__b.WriteClassBuffer(" << fullname << "::Class(),this);" << std::endl
-              << "   }" << std::endl
-              << "}" << std::endl << std::endl;
+              << "   // Stream an object of class " << fullname << "." << std::endl << std::endl;
+
+   // When requested, read and write the members directly if the data has the in-memory layout.
+   int version = ROOT::TMetaUtils::GetClassVersion(clxx, interp);
+   std::ostringstream readCode, writeCode, members;
+   if (gCompiledStreamers && version > 0 && WriteCompiledStreamerCode(clxx, readCode, writeCode, members)) {
+      dictStream << "   static const char *const R__members[] = {" << members.str() << "nullptr};" << std::endl
+                 << "   if (R__b.IsReading()) {" << std::endl
+                 << "      UInt_t R__s, R__c;" << std::endl
+                 << "      if (R__b.ReadVersionForCompiledStreamer(" << fullname << "::Class(), " << version
+                 << ", R__members, &R__s, &R__c)) {" << std::endl
+                 << readCode.str()
+                 << "         R__b.CheckByteCount(R__s, R__c, " << fullname << "::Class());" << std::endl
+                 << "      } else {" << std::endl
+                 << "         R__b.ReadClassBuffer(" << fullname << "::Class(),this);" << std::endl
+                 << "      }" << std::endl
+                 << "   } else {" << std::endl
+                 << "      UInt_t R__c;" << std::endl
+                 << "      if (R__b.WriteVersionForCompiledStreamer(" << fullname << "::Class(), " << version
+                 << ", R__members, &R__c)) {" << std::endl
+                 << writeCode.str()
+                 << "         R__b.SetByteCount(R__c, kTRUE);" << std::endl
+                 << "      } else {" << std::endl
+                 << "         R__b.WriteClassBuffer(" << fullname << "::Class(),this);" << std::endl
+                 << "      }" << std::endl
+                 << "   }" << std::endl;
+   } else {
+      dictStream << "   if (R__b.IsReading()) {" << std::endl
+                 << "      R__b.ReadClassBuffer(" << fullname << "::Class(),this);" << std::endl
+                 << "   } else {" << std::endl
+                 << "      R__b.WriteClassBuffer(" << fullname << "::Class(),this);" << std::endl
+                 << "   }" << std::endl;
+   }
+   dictStream << "}" << std::endl << std::endl;
 
    while (enclSpaceNesting) {
       dictStream << "} // namespace " << nsname << std::endl;
@@ -4114,6 +4231,13 @@ int RootClingMain(int argc,
             continue;
          }
 
+         if (strcmp("-compiledStreamers", argv[ic]) == 0) {
+            // Inline the reading and writing of simple classes in their Streamer()
+            gCompiledStreamers = true;
+            ic += 1;
+            continue;
+         }
+
          if ((ic + 1) < argc && strcmp("-isysroot", argv[ic]) == 0) {
             clingArgs.push_back(argv[ic++]);
             clingArgs.push_back(argv[ic++]);
@@ -150,7 +150,16 @@ namespace TClassEdit {
       TSplitType &operator=(const TSplitType &); // intentionally not implemented
    };
 
+   /// Usage statistics of the caches behind GetNormalizedName, ResolveTypedef and ShortType.
+   struct NormalizationCacheStats {
+      unsigned long long fHits = 0;    ///< Number of lookups answered from the cache
+      unsigned long long fMisses = 0;  ///< Number of lookups that had to compute the result
+      unsigned long long fEntries = 0; ///< Number of results currently stored
+   };
+
    void        Init(TClassEdit::TInterpreterLookupHelper *helper);
+   void        ResetNormalizationCache();
+   NormalizationCacheStats GetNormalizationCacheStats();
 
    std::string CleanType (const char *typeDesc,int mode = 0,const char **tail=0);
    bool        IsDefAlloc(const char *alloc, const char *classname);
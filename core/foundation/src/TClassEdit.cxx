@@ -16,9 +16,125 @@
 #include <memory>
 #include "ROOT/RStringView.hxx"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 namespace {
    static TClassEdit::TInterpreterLookupHelper *gInterpreterHelper = 0;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Memoization of the type name transformations (GetNormalizedName,
+   /// ResolveTypedef and ShortType) keyed by the spelling of the input.
+   ///
+   /// The map is split into shards, each protected by its own mutex, so that
+   /// concurrent lookups of different names rarely contend. The results depend
+   /// on what the interpreter knows (typedefs, scopes, default template
+   /// arguments), so the whole cache is reset when such declarations are added
+   /// to the interpreter (see TClassEdit::ResetNormalizationCache); a result
+   /// computed before a reset is not stored after it thanks to the generation
+   /// counter.
+
+   template <typename Key, typename Hash = std::hash<Key>>
+   class TNormalizationCache {
+      static constexpr unsigned int kNShards = 16;
+      static constexpr size_t kMaxShardSize = 4096; // Beyond this we simply stop caching.
+
+      struct TShard {
+         std::mutex fMutex;
+         std::unordered_map<Key, std::string, Hash> fMap;
+      };
+
+      TShard fShards[kNShards];
+      std::atomic<unsigned long> fGeneration{0};
+      std::atomic<unsigned long long> fHits{0};
+      std::atomic<unsigned long long> fMisses{0};
+
+      TShard &GetShard(size_t hash) { return fShards[(hash >> 8) % kNShards]; }
+
+   public:
+      template <typename F>
+      std::string Get(Key key, F &&compute)
+      {
+         TShard &shard = GetShard(Hash()(key));
+         {
+            std::lock_guard<std::mutex> lock(shard.fMutex);
+            auto iter = shard.fMap.find(key);
+            if (iter != shard.fMap.end()) {
+               fHits.fetch_add(1, std::memory_order_relaxed);
+               return iter->second;
+            }
+         }
+         fMisses.fetch_add(1, std::memory_order_relaxed);
+
+         // Compute outside of the lock, the transformations call each other.
+         const unsigned long generation = fGeneration.load(std::memory_order_acquire);
+         std::string result = compute();
+
+         std::lock_guard<std::mutex> lock(shard.fMutex);
+         if (generation == fGeneration.load(std::memory_order_acquire) && shard.fMap.size() < kMaxShardSize)
+            shard.fMap.emplace(std::move(key), result);
+         return result;
+      }
+
+      void Reset()
+      {
+         fGeneration.fetch_add(1, std::memory_order_acq_rel);
+         for (auto &shard : fShards) {
+            std::lock_guard<std::mutex> lock(shard.fMutex);
+            shard.fMap.clear();
+         }
+      }
+
+      void GetStats(TClassEdit::NormalizationCacheStats &stats)
+      {
+         stats.fHits += fHits.load(std::memory_order_relaxed);
+         stats.fMisses += fMisses.load(std::memory_order_relaxed);
+         for (auto &shard : fShards) {
+            std::lock_guard<std::mutex> lock(shard.fMutex);
+            stats.fEntries += shard.fMap.size();
+         }
+      }
+   };
+
+   /// Key of the ShortType cache: the result depends on the mode.
+   struct TShortTypeKey {
+      std::string fName;
+      int fMode;
+      bool operator==(const TShortTypeKey &other) const { return fMode == other.fMode && fName == other.fName; }
+   };
+
+   struct TShortTypeKeyHash {
+      // Fibonacci hashing constant (2^N / golden ratio) matching the width of size_t
+      static constexpr size_t kGolden = sizeof(size_t) == 8 ? size_t(0x9E3779B97F4A7C15ULL) : size_t(0x9E3779B9UL);
+
+      size_t operator()(const TShortTypeKey &key) const
+      {
+         return std::hash<std::string>()(key.fName) ^ (std::hash<int>()(key.fMode) * kGolden);
+      }
+   };
+
+   using TNameCache = TNormalizationCache<std::string>;
+   using TShortTypeCache = TNormalizationCache<TShortTypeKey, TShortTypeKeyHash>;
+
+   // Intentionally leaked, they can be used during the tear down of other statics.
+   TNameCache &GetNormalizedNameCache()
+   {
+      static TNameCache *cache = new TNameCache;
+      return *cache;
+   }
+
+   TNameCache &GetResolveTypedefCache()
+   {
+      static TNameCache *cache = new TNameCache;
+      return *cache;
+   }
+
+   TShortTypeCache &GetShortTypeCache()
+   {
+      static TShortTypeCache *cache = new TShortTypeCache;
+      return *cache;
+   }
 }
 
 namespace std {} using namespace std;
@@ -121,6 +237,33 @@ TClassEdit::EComplexType TClassEdit::GetComplexType(const char* clName)
 void TClassEdit::Init(TClassEdit::TInterpreterLookupHelper *helper)
 {
    gInterpreterHelper = helper;
+   ResetNormalizationCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the memoized results of GetNormalizedName, ResolveTypedef and
+/// ShortType. This must be called whenever the information available to the
+/// interpreter lookup helper changes: TCling calls it for the transactions
+/// declaring typedefs, scopes or class templates, and when code is unloaded.
+
+void TClassEdit::ResetNormalizationCache()
+{
+   GetNormalizedNameCache().Reset();
+   GetResolveTypedefCache().Reset();
+   GetShortTypeCache().Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of hits, misses and stored entries of the caches used by
+/// GetNormalizedName, ResolveTypedef and ShortType.
+
+TClassEdit::NormalizationCacheStats TClassEdit::GetNormalizationCacheStats()
+{
+   NormalizationCacheStats stats;
+   GetNormalizedNameCache().GetStats(stats);
+   GetResolveTypedefCache().GetStats(stats);
+   GetShortTypeCache().GetStats(stats);
+   return stats;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -785,16 +928,9 @@ bool TClassEdit::IsDefHash(const char *hashname, const char *classname)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the normalized name.  See TMetaUtils::GetNormalizedName.
-///
-/// Return the type name normalized for ROOT,
-/// keeping only the ROOT opaque typedef (Double32_t, etc.) and
-/// removing the STL collections default parameter if any.
-///
-/// Compare to TMetaUtils::GetNormalizedName, this routines does not
-/// and can not add default template parameters.
+/// Implementation of GetNormalizedName, without memoization.
 
-void TClassEdit::GetNormalizedName(std::string &norm_name, std::string_view name)
+static void GetNormalizedNameImpl(std::string &norm_name, std::string_view name)
 {
    norm_name = std::string(name); // NOTE: Is that the shortest version?
 
@@ -820,6 +956,25 @@ void TClassEdit::GetNormalizedName(std::string &norm_name, std::string_view name
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the normalized name.  See TMetaUtils::GetNormalizedName.
+///
+/// Return the type name normalized for ROOT,
+/// keeping only the ROOT opaque typedef (Double32_t, etc.) and
+/// removing the STL collections default parameter if any.
+///
+/// Compare to TMetaUtils::GetNormalizedName, this routines does not
+/// and can not add default template parameters.
+
+void TClassEdit::GetNormalizedName(std::string &norm_name, std::string_view name)
+{
+   norm_name = GetNormalizedNameCache().Get(std::string(name), [name]() {
+      std::string result;
+      GetNormalizedNameImpl(result, name);
+      return result;
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Replace 'long long' and 'unsigned long long' by 'Long64_t' and 'ULong64_t'
 
@@ -1203,15 +1358,16 @@ string TClassEdit::CleanType(const char *typeDesc, int mode, const char **tail)
 
 string TClassEdit::ShortType(const char *typeDesc, int mode)
 {
-   string answer;
+   if (!typeDesc)
+      return "";
 
-   // get list of all arguments
-   if (typeDesc) {
+   return GetShortTypeCache().Get({typeDesc, mode}, [typeDesc, mode]() {
+      string answer;
+      // get list of all arguments
       TSplitType arglist(typeDesc, (EModType) mode);
       arglist.ShortType(answer, mode);
-   }
-
-   return answer;
+      return answer;
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1652,20 +1808,10 @@ static void ResolveTypedefImpl(const char *tname,
 
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Implementation of ResolveTypedef, without memoization.
 
-string TClassEdit::ResolveTypedef(const char *tname, bool /* resolveAll */)
+static string ResolveTypedefUncached(const char *tname)
 {
-   // Return the name of type 'tname' with all its typedef components replaced
-   // by the actual type its points to
-   // For example for "typedef MyObj MyObjTypedef;"
-   //    vector<MyObjTypedef> return vector<MyObj>
-   //
-
-   if (tname == 0 || tname[0] == 0)
-      return "";
-   if (!gInterpreterHelper)
-      return tname;
-
    std::string result;
 
    // Check if we already know it is a normalized typename or a registered
@@ -1686,6 +1832,24 @@ string TClassEdit::ResolveTypedef(const char *tname, bool /* resolveAll */)
    else return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+string TClassEdit::ResolveTypedef(const char *tname, bool /* resolveAll */)
+{
+   // Return the name of type 'tname' with all its typedef components replaced
+   // by the actual type its points to
+   // For example for "typedef MyObj MyObjTypedef;"
+   //    vector<MyObjTypedef> return vector<MyObj>
+   //
+
+   if (tname == 0 || tname[0] == 0)
+      return "";
+   if (!gInterpreterHelper)
+      return tname;
+
+   return GetResolveTypedefCache().Get(tname, [tname]() { return ResolveTypedefUncached(tname); });
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -256,3 +256,26 @@ TEST(TClassEdit, GetNameForIO)
          << "Failure in transforming typename " << namesp.first << " into " << namesp.second;
    }
 }
+
+TEST(TClassEdit, NormalizationCache)
+{
+   const int mode = TClassEdit::kDropStd | TClassEdit::kDropStlDefault;
+   const char *name = "std::vector<std::pair<int,float>,std::allocator<std::pair<int,float> > >";
+
+   TClassEdit::ResetNormalizationCache();
+   const auto first = TClassEdit::ShortType(name, mode);
+   const auto before = TClassEdit::GetNormalizationCacheStats();
+   EXPECT_LE(1u, before.fMisses);
+
+   EXPECT_EQ(first, TClassEdit::ShortType(name, mode));
+   const auto after = TClassEdit::GetNormalizationCacheStats();
+   EXPECT_EQ(before.fHits + 1, after.fHits);
+   EXPECT_EQ(before.fMisses, after.fMisses);
+
+   // The mode is part of the key.
+   EXPECT_NE(first, TClassEdit::ShortType(name, TClassEdit::kNone));
+
+   TClassEdit::ResetNormalizationCache();
+   EXPECT_EQ(0u, TClassEdit::GetNormalizationCacheStats().fEntries);
+   EXPECT_EQ(first, TClassEdit::ShortType(name, mode));
+}
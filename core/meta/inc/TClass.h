@@ -588,6 +588,8 @@ TClass *GetClassHelper(Bool_t load, Bool_t silent, std::false_type)
    return TClass::GetClass(typeid(T), load, silent);
 }
 
+std::size_t GetClassLookupCacheMemoryUsage();
+
 } // namespace Internal
 } // namespace ROOT
 
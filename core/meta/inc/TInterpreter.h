@@ -134,6 +134,7 @@ public:
    virtual Bool_t   Declare(const char* code) = 0;
    virtual void     EnableAutoLoading() = 0;
    virtual void     EndOfLineAction() = 0;
+   virtual Bool_t   LoadDeferredPCMs(const char * /* classname */, Bool_t /* hasDictionary */) { return kFALSE; }
    virtual TClass  *GetClass(const std::type_info& typeinfo, Bool_t load) const = 0;
    virtual Int_t    GetExitCode() const = 0;
    virtual TEnv    *GetMapfile() const { return 0; }
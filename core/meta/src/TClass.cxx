@@ -79,12 +79,16 @@ a 'using namespace std;' has been applied to and with:
 #include "TSystem.h"
 #include "TThreadSlots.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cctype>
+#include <cstring>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <typeinfo>
 #include <cmath>
 #include <assert.h>
@@ -134,6 +138,180 @@ namespace {
          fSave(ROOT::Internal::gMmallocDesc) { ROOT::Internal::gMmallocDesc = value; }
       ~TMmallocDescTemp() { ROOT::Internal::gMmallocDesc = fSave; }
    };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Map from a class name as requested (not necessarily normalized) or from a
+   /// typeid name to the corresponding loaded TClass, readable without any lock.
+   ///
+   /// Lookups probe an open addressing table whose slots, once set, always point
+   /// to the same entry. Insertions, done only the first time a name is resolved,
+   /// are serialized and publish a bigger copy of the table when it gets half full.
+   /// When a class is removed, only the entries resolving to it are reset; they are
+   /// reused if their name is resolved again. Entries are thus never freed while
+   /// a concurrent reader may see them, and the memory is bounded by the number of
+   /// distinct names looked up: the tables replaced when growing are kept alive
+   /// too, but their total size is less than the size of the current table.
+
+   class TClassLookupCache {
+      struct TEntry {
+         std::size_t          fHash;
+         std::string          fName;
+         std::atomic<TClass*> fClass;
+
+         TEntry(std::size_t hash, const char *name, TClass *cl) : fHash(hash), fName(name), fClass(cl) {}
+      };
+      struct TTable {
+         const std::size_t fMask;
+         std::size_t       fCount = 0; // Only used by the writers
+         std::unique_ptr<std::atomic<TEntry *>[]> fSlots;
+
+         TTable(std::size_t size) : fMask(size - 1), fSlots(new std::atomic<TEntry *>[size])
+         {
+            for (std::size_t i = 0; i < size; ++i)
+               fSlots[i].store(nullptr, std::memory_order_relaxed);
+         }
+         void Store(TEntry *entry)
+         {
+            std::size_t i = entry->fHash & fMask;
+            while (fSlots[i].load(std::memory_order_relaxed))
+               i = (i + 1) & fMask;
+            fSlots[i].store(entry, std::memory_order_release);
+            ++fCount;
+         }
+         TEntry *Find(const char *name, std::size_t hash) const
+         {
+            for (std::size_t i = hash & fMask;; i = (i + 1) & fMask) {
+               TEntry *entry = fSlots[i].load(std::memory_order_acquire);
+               if (!entry || (entry->fHash == hash && entry->fName == name))
+                  return entry;
+            }
+         }
+      };
+
+      static constexpr std::size_t kInitialSize = 1024;
+
+      std::atomic<TTable *>                fTable;
+      std::mutex                           fWriteMutex;
+      std::vector<std::unique_ptr<TTable>> fTables;  // Current and replaced tables
+      std::vector<std::unique_ptr<TEntry>> fEntries;
+      std::unordered_multimap<TClass *, TEntry *> fEntriesOfClass; // Entries currently resolving to a class
+
+      static std::size_t Hash(const char *name)
+      {
+         // FNV-1a
+         std::size_t hash = 14695981039346656037ULL;
+         for (; *name; ++name)
+            hash = (hash ^ (unsigned char)*name) * 1099511628211ULL;
+         return hash;
+      }
+
+      void Publish(TTable *table)
+      {
+         fTables.emplace_back(table);
+         fTable.store(table, std::memory_order_release);
+      }
+
+      void ForgetEntryOfClass(TEntry *entry, TClass *cl)
+      {
+         auto range = fEntriesOfClass.equal_range(cl);
+         for (auto iter = range.first; iter != range.second; ++iter) {
+            if (iter->second == entry) {
+               fEntriesOfClass.erase(iter);
+               return;
+            }
+         }
+      }
+
+   public:
+      TClassLookupCache() : fTable(nullptr) { Publish(new TTable(kInitialSize)); }
+
+      TClass *Find(const char *name) const
+      {
+         const TEntry *entry = fTable.load(std::memory_order_acquire)->Find(name, Hash(name));
+         return entry ? entry->fClass.load(std::memory_order_acquire) : nullptr;
+      }
+
+      void Insert(const char *name, TClass *cl)
+      {
+         std::lock_guard<std::mutex> lock(fWriteMutex);
+         const std::size_t hash = Hash(name);
+         TTable *table = fTable.load(std::memory_order_relaxed);
+         if (TEntry *entry = table->Find(name, hash)) {
+            // Known name, possibly reset when its class was removed.
+            TClass *old = entry->fClass.load(std::memory_order_relaxed);
+            if (old == cl)
+               return;
+            if (old)
+               ForgetEntryOfClass(entry, old);
+            entry->fClass.store(cl, std::memory_order_release);
+            fEntriesOfClass.emplace(cl, entry);
+            return;
+         }
+         if (2 * (table->fCount + 1) > table->fMask + 1) {
+            TTable *bigger = new TTable(2 * (table->fMask + 1));
+            for (std::size_t i = 0; i <= table->fMask; ++i) {
+               if (TEntry *entry = table->fSlots[i].load(std::memory_order_relaxed))
+                  bigger->Store(entry);
+            }
+            Publish(bigger);
+            table = bigger;
+         }
+         fEntries.emplace_back(new TEntry(hash, name, cl));
+         table->Store(fEntries.back().get());
+         fEntriesOfClass.emplace(cl, fEntries.back().get());
+      }
+
+      // Reset the entries resolving to cl.
+      void Remove(TClass *cl)
+      {
+         std::lock_guard<std::mutex> lock(fWriteMutex);
+         auto range = fEntriesOfClass.equal_range(cl);
+         for (auto iter = range.first; iter != range.second; ++iter)
+            iter->second->fClass.store(nullptr, std::memory_order_release);
+         fEntriesOfClass.erase(range.first, range.second);
+      }
+
+      // Number of bytes allocated by the cache.
+      std::size_t GetMemoryUsage()
+      {
+         std::lock_guard<std::mutex> lock(fWriteMutex);
+         std::size_t size = 0;
+         for (auto &table : fTables)
+            size += sizeof(TTable) + (table->fMask + 1) * sizeof(std::atomic<TEntry *>);
+         for (auto &entry : fEntries)
+            size += sizeof(TEntry) + entry->fName.capacity();
+         return size + fEntriesOfClass.size() * (sizeof(TClass *) + sizeof(TEntry *));
+      }
+   };
+
+   // Never deleted: TClass objects are still removed during the tear down.
+   TClassLookupCache &GetClassByNameCache()
+   {
+      static TClassLookupCache *cache = new TClassLookupCache;
+      return *cache;
+   }
+
+   TClassLookupCache &GetClassByTypeinfoCache()
+   {
+      static TClassLookupCache *cache = new TClassLookupCache;
+      return *cache;
+   }
+
+   // Record cl as the result of the lookup of name if it is loaded.
+   TClass *CacheLoadedClass(TClassLookupCache &cache, const char *name, TClass *cl)
+   {
+      if (cl && cl->IsLoaded())
+         cache.Insert(name, cl);
+      return cl;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes allocated by the caches of TClass::GetClass.
+
+std::size_t ROOT::Internal::GetClassLookupCacheMemoryUsage()
+{
+   return GetClassByNameCache().GetMemoryUsage() + GetClassByTypeinfoCache().GetMemoryUsage();
 }
 
 std::atomic<Int_t> TClass::fgClassCount;
@@ -479,6 +657,9 @@ void TClass::RemoveClass(TClass *oldcl)
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
    }
+   // Forget the names resolved to this class.
+   GetClassByNameCache().Remove(oldcl);
+   GetClassByTypeinfoCache().Remove(oldcl);
    if (oldcl->fClassInfo) {
       //GetDeclIdMap()->Remove((void*)(oldcl->fClassInfo));
    }
@@ -2884,6 +3065,9 @@ TVirtualIsAProxy* TClass::GetIsAProxy() const
 /// If silent is 'true', do not warn about missing dictionary for the class.
 /// (typically used for class that are used only for transient members)
 /// Returns 0 in case class is not found.
+///
+/// Once a name has been resolved to a loaded class, the subsequent lookups
+/// of that same name do not take any lock (see TClassLookupCache).
 
 TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 {
@@ -2895,6 +3079,9 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    if (!gROOT->GetListOfClasses())  return 0;
 
+   TClassLookupCache &cache = GetClassByNameCache();
+   if (TClass *cached = cache.Find(name)) return cached;
+
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -2902,7 +3089,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
-   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
+   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return CacheLoadedClass(cache, name, cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -2911,7 +3098,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
    if (cl) {
-      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return CacheLoadedClass(cache, name, cl);
 
       // We could speed-up some of the search by adding (the equivalent of)
       //
@@ -2944,7 +3131,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
       TClass *loadedcl = (dict)();
       if (loadedcl) {
          loadedcl->PostLoadCheck();
-         return loadedcl;
+         return CacheLoadedClass(cache, name, loadedcl);
       }
 
       // We should really not fall through to here, but if we do, let's just
@@ -2963,7 +3150,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          cl = (TClass*)gROOT->GetListOfClasses()->FindObject(normalizedName.c_str());
 
          if (cl) {
-            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return CacheLoadedClass(cache, name, cl);
 
             //we may pass here in case of a dummy class created by TVirtualStreamerInfo
             load = kTRUE;
@@ -3013,11 +3200,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          }
       }
    }
-   if (loadedcl) return loadedcl;
+   if (loadedcl) return CacheLoadedClass(cache, name, loadedcl);
 
    // See if the TClassGenerator can produce the TClass we need.
    loadedcl = LoadClassCustom(normalizedName.c_str(),silent);
-   if (loadedcl) return loadedcl;
+   if (loadedcl) return CacheLoadedClass(cache, name, loadedcl);
 
    // We have not been able to find a loaded TClass, return the Emulated
    // TClass if we have one.
@@ -3108,12 +3295,15 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return 0;
 
+   TClassLookupCache &cache = GetClassByTypeinfoCache();
+   if (TClass *cached = cache.Find(typeinfo.name())) return cached;
+
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    TClass* cl = GetIdMap()->Find(typeinfo.name());
 
-   if (cl && cl->IsLoaded()) return cl;
+   if (cl && cl->IsLoaded()) return CacheLoadedClass(cache, typeinfo.name(), cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3123,7 +3313,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    cl = GetIdMap()->Find(typeinfo.name());
 
    if (cl) {
-      if (cl->IsLoaded()) return cl;
+      if (cl->IsLoaded()) return CacheLoadedClass(cache, typeinfo.name(), cl);
       //we may pass here in case of a dummy class created by TVirtualStreamerInfo
       load = kTRUE;
    } else {
@@ -3145,7 +3335,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (dict) {
       cl = (dict)();
       if (cl) cl->PostLoadCheck();
-      return cl;
+      return CacheLoadedClass(cache, typeinfo.name(), cl);
    }
    if (cl) return cl;
 
@@ -6054,6 +6244,9 @@ void TClass::SetUnloaded()
 
    // Make sure SetClassInfo, re-calculated the state.
    fState = kForwardDeclared;
+   // The class is not loaded anymore, forget the lookups that resolved to it.
+   GetClassByNameCache().Remove(this);
+   GetClassByTypeinfoCache().Remove(this);
 
    delete fIsA; fIsA = 0;
    // Disable the autoloader while calling SetClassInfo, to prevent
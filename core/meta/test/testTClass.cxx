@@ -1,6 +1,10 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
+
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -22,3 +26,51 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, ConcurrentLookup)
+{
+   // The second and later lookups of a name are served without locking,
+   // also for names that are not normalized.
+   auto named = TClass::GetClass("TNamed");
+   auto vec = TClass::GetClass("std::vector<int>");
+   ASSERT_NE(named, nullptr);
+   ASSERT_NE(vec, nullptr);
+
+   std::vector<std::thread> threads;
+   std::vector<int> failures(8, 0);
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&, t]() {
+         for (int i = 0; i < 10000; ++i) {
+            if (TClass::GetClass("TNamed") != named || TClass::GetClass(typeid(TNamed)) != named ||
+                TClass::GetClass("std::vector<int>") != vec || TClass::GetClass("vector<int>") != vec)
+               ++failures[t];
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   for (auto f : failures)
+      EXPECT_EQ(f, 0);
+}
+
+TEST(TClass, LookupCacheBounded)
+{
+   // Removing a class only forgets the lookups resolved to it: cloning a class
+   // (which removes and adds it again) or adding and removing classes must not
+   // make the cache grow.
+   auto named = TClass::GetClass("TNamed");
+   ASSERT_NE(named, nullptr);
+   auto cycle = [named]() {
+      EXPECT_EQ(TClass::GetClass("TNamed"), named);
+      EXPECT_EQ(TClass::GetClass(typeid(TNamed)), named);
+      delete named->Clone("TNamedClone");
+      EXPECT_EQ(TClass::GetClass("TNamed"), named);
+      EXPECT_EQ(TClass::GetClass(typeid(TNamed)), named);
+   };
+   for (int i = 0; i < 10; ++i)
+      cycle();
+   const auto usage = ROOT::Internal::GetClassLookupCacheMemoryUsage();
+   for (int i = 0; i < 1000; ++i)
+      cycle();
+   EXPECT_EQ(usage, ROOT::Internal::GetClassLookupCacheMemoryUsage());
+}
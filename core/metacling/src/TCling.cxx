@@ -118,6 +118,7 @@ clang/LLVM technology.
 #include "llvm/Object/SymbolicFile.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <cassert>
 #include <map>
@@ -258,6 +259,44 @@ using namespace std;
 using namespace clang;
 using namespace ROOT;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Measures the time spent in one step of the interpreter startup (construction,
+/// rootmap file, dictionary module or PCM) and reports it when Root.StartupTiming
+/// is set in the rootrc file.
+
+class TStartupStepTimer {
+   const char *fKind;
+   std::string fName;
+   std::chrono::steady_clock::time_point fStart;
+
+public:
+   static bool IsEnabled()
+   {
+      static const bool enabled = gEnv && gEnv->GetValue("Root.StartupTiming", 0);
+      return enabled;
+   }
+
+   TStartupStepTimer(const char *kind, const char *name) : fKind(kind)
+   {
+      if (IsEnabled()) {
+         fName = name ? name : "";
+         fStart = std::chrono::steady_clock::now();
+      }
+   }
+
+   ~TStartupStepTimer()
+   {
+      if (!IsEnabled())
+         return;
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - fStart;
+      ::Info("TCling::StartupTiming", "%-8s %9.3f ms  %s", fKind, elapsed.count(), fName.c_str());
+   }
+};
+
+} // unnamed namespace
+
 namespace {
   static const std::string gInterpreterClassDef = R"ICF(
 #undef ClassDef
@@ -1146,8 +1185,13 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
    fClingCallbacks(0), fAutoLoadCallBack(0),
    fTransactionCount(0), fHeaderParsingOnDemand(true), fIsAutoParsingSuspended(kFALSE)
 {
+   TStartupStepTimer startupTimer("TCling", name);
+
    const bool fromRootCling = IsFromRootCling();
 
+   // In lazy mode the ROOT PCMs are only read when a class description is first requested.
+   fLazyPCMs = !fromRootCling && gEnv && gEnv->GetValue("Root.LazyPCM", 0);
+
    fCxxModulesEnabled = false;
 #ifdef R__USE_CXXMODULES
    fCxxModulesEnabled = true;
@@ -1485,10 +1529,13 @@ static bool R__InitStreamerInfoFactory()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Tries to load a PCM; returns true on success.
+/// If replaceClasses is true, the existing TClass objects of the classes described
+/// by the PCM which were not created by their dictionary are replaced.
 
 bool TCling::LoadPCM(TString pcmFileName,
                      const char** headers,
-                     void (*triggerFunc)()) const {
+                     void (*triggerFunc)(),
+                     bool replaceClasses /* = true */) const {
    // pcmFileName is an intentional copy; updated by FindFile() below.
 
    TString searchPath;
@@ -1511,6 +1558,8 @@ bool TCling::LoadPCM(TString pcmFileName,
    if (!gSystem->FindFile(searchPath, pcmFileName))
       return kFALSE;
 
+   TStartupStepTimer startupTimer("PCM", pcmFileName);
+
    // Prevent the ROOT-PCMs hitting this during auto-load during
    // JITting - which will cause recursive compilation.
    // Avoid to call the plugin manager at all.
@@ -1565,6 +1614,8 @@ bool TCling::LoadPCM(TString pcmFileName,
          // a dependency graph the addition to the TClassTable above allows us
          // to create these dependent TClasses as needed below.
          for (auto proto : *protoClasses) {
+            if (!replaceClasses)
+               break;
             if (TClass* existingCl
                 = (TClass*)gROOT->GetListOfClasses()->FindObject(proto->GetName())) {
                // We have an existing TClass object. It might be emulated
@@ -1713,6 +1764,77 @@ static const std::unordered_set<std::string> gIgnoredPCMNames = {"libCore",
                                                                  "G__GenVector32",
                                                                  "G__Smatrix32"};
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read a ROOT PCM deferred in lazy mode (Root.LazyPCM), if not read yet.
+///
+/// This happens while a TClass is being set up, so the existing TClass objects
+/// are not replaced: RegisterModule() reads the PCM right away if one of its
+/// classes had a TClass already, and TClass objects created later come from
+/// the dictionary of the module, as it is registered.
+
+void TCling::LoadDeferredPCM(DeferredPCM_t &pcm)
+{
+   if (pcm.fLoaded)
+      return;
+   // Reading the PCM creates TClass objects, which may request other PCMs.
+   pcm.fLoaded = true;
+   fHasDeferredPCMs = std::any_of(fDeferredPCMs.begin(), fDeferredPCMs.end(),
+                                  [](const std::unique_ptr<DeferredPCM_t> &other) { return !other->fLoaded; });
+   if (gDebug > 0)
+      ::Info("TCling::LoadDeferredPCMs", "reading the deferred PCM %s", pcm.fFileName.Data());
+   if (!LoadPCM(pcm.fFileName, pcm.fHeaders, pcm.fTriggerFunc, /*replaceClasses=*/ false))
+      ::Error("TCling::LoadDeferredPCMs", "cannot find dictionary module %s", pcm.fFileName.Data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the ROOT PCM describing the class classname, if its module was
+/// registered in lazy mode (Root.LazyPCM) and the PCM was not read yet.
+/// Return true if a PCM was read.
+///
+/// The PCMs list the classes selected for their dictionary. A class which is not
+/// listed is looked up in the rootmap files, unless hasDictionary is true: its
+/// dictionary is then registered by a module whose PCM was read or is not used
+/// (e.g. TObject), and reading PCMs would not provide its protoclass. Only the
+/// PCM of the library the rootmap names is read, never all of them.
+/// Called by TClassTable when the protoclass of classname is requested but unknown.
+
+Bool_t TCling::LoadDeferredPCMs(const char *classname, Bool_t hasDictionary)
+{
+   if (!fHasDeferredPCMs || !classname)
+      return kFALSE;
+
+   // The names listed by the PCMs are normalized, as in TClassTable.
+   std::string normalized;
+   TClassEdit::GetNormalizedName(normalized, classname);
+
+   R__LOCKGUARD(gInterpreterMutex);
+   DeferredPCM_t *pcm = nullptr;
+   auto iter = fDeferredPCMClasses.find(normalized);
+   if (iter != fDeferredPCMClasses.end()) {
+      pcm = iter->second;
+   } else if (!hasDictionary) {
+      // e.g. an automatically selected class of a deferred module
+      if (const char *libs = GetClassSharedLibs(normalized.c_str())) {
+         // the first library is the one of the class, the others its dependencies
+         TString path(libs);
+         Ssiz_t end = path.First(' ');
+         if (end != kNPOS)
+            path.Remove(end);
+         TString lib = gSystem->BaseName(path);
+         Ssiz_t dot = lib.First('.');
+         if (dot != kNPOS)
+            lib.Remove(dot);
+         auto libIter = fDeferredPCMLibraries.find(lib.Data());
+         if (libIter != fDeferredPCMLibraries.end())
+            pcm = libIter->second;
+      }
+   }
+   if (!pcm || pcm->fLoaded)
+      return kFALSE;
+   LoadDeferredPCM(*pcm);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Inject the module named "modulename" into cling; load all headers.
 /// headers is a 0-terminated array of header files to #include after
@@ -1740,6 +1862,8 @@ void TCling::RegisterModule(const char* modulename,
    // I/O; see rootcling.cxx after the call to TCling__GetInterpreter().
    if (fromRootCling) return;
 
+   TStartupStepTimer startupTimer("module", modulename);
+
    // When we cannot provide a module for the library we should enable header
    // parsing. This 'mixed' mode ensures gradual migration to modules.
    llvm::SaveAndRestore<bool> SaveHeaderParsing(fHeaderParsingOnDemand);
@@ -1975,7 +2099,31 @@ void TCling::RegisterModule(const char* modulename,
 
    if (gIgnoredPCMNames.find(modulename) == gIgnoredPCMNames.end()) {
       TString pcmFileName(ROOT::TMetaUtils::GetModuleFileName(modulename).c_str());
-      if (!LoadPCM(pcmFileName, headers, triggerFunc)) {
+      // The PCM is read right away if one of its classes has a TClass already,
+      // which must be replaced now rather than while another class is set up.
+      bool deferPCM = fLazyPCMs && !isACLiC && classesHeaders && *classesHeaders;
+      std::vector<std::string> pcmClasses;
+      for (const char** classesHeader = classesHeaders; deferPCM && *classesHeader; ++classesHeader) {
+         // The names are the normalized names, as in TClassTable.
+         pcmClasses.emplace_back(*classesHeader);
+         if (gROOT->GetListOfClasses()->FindObject(*classesHeader))
+            deferPCM = false;
+         while (*classesHeader && strcmp(*classesHeader, "@") != 0)
+            ++classesHeader;
+         if (!*classesHeader)
+            break;
+      }
+      if (deferPCM) {
+         // Remember which classes are described by the PCM, it is read when
+         // the first of them is requested (see LoadDeferredPCMs()).
+         R__LOCKGUARD(gInterpreterMutex);
+         fDeferredPCMs.emplace_back(new DeferredPCM_t{pcmFileName, headers, triggerFunc, false});
+         DeferredPCM_t *pcm = fDeferredPCMs.back().get();
+         for (auto &pcmClass : pcmClasses)
+            fDeferredPCMClasses.emplace(pcmClass, pcm);
+         fDeferredPCMLibraries.emplace(gSystem->BaseName(modulename), pcm);
+         fHasDeferredPCMs = true;
+      } else if (!LoadPCM(pcmFileName, headers, triggerFunc)) {
          ::Error("TCling::RegisterModule", "cannot find dictionary module %s",
                  ROOT::TMetaUtils::GetModuleFileName(modulename).c_str());
       }
@@ -5028,6 +5176,8 @@ int TCling::ReadRootmapFile(const char *rootmapfile, TUniqueString *uniqueString
       if (fRootmapFiles->FindObject(rootmapfileNoBackslash.c_str()))
          return -1;
 
+      TStartupStepTimer startupTimer("rootmap", rootmapfileNoBackslash.c_str());
+
       if (uniqueString)
          uniqueString->Append(std::string("\n#line 1 \"Forward declarations from ") + rootmapfileNoBackslash + "\"\n");
 
@@ -5366,7 +5516,11 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 
    // Process the forward declarations collected
    cling::Transaction* T = nullptr;
-   auto compRes= fInterpreter->declare(uniqueString.Data(), &T);
+   cling::Interpreter::CompilationResult compRes;
+   {
+      TStartupStepTimer startupTimer("rootmap", "forward declarations of all rootmap files");
+      compRes = fInterpreter->declare(uniqueString.Data(), &T);
+   }
    assert(cling::Interpreter::kSuccess == compRes && "A declaration in a rootmap could not be compiled");
 
    if (compRes!=cling::Interpreter::kSuccess){
@@ -6399,6 +6553,58 @@ void TCling::UpdateAllCanvases()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the declaration can change the names computed by
+/// TClassEdit::GetNormalizedName, ResolveTypedef or ShortType: typedefs and
+/// aliases, new scopes (namespaces, classes) and class templates, whose default
+/// arguments are dropped. Functions, variables and template instantiations,
+/// which make most of the transactions, cannot.
+
+static bool AffectsNameNormalization(const clang::Decl *D)
+{
+   if (isa<TypedefNameDecl>(D) || isa<TypeAliasTemplateDecl>(D) || isa<ClassTemplateDecl>(D)
+       || isa<NamespaceAliasDecl>(D) || isa<UsingDirectiveDecl>(D) || isa<UsingDecl>(D))
+      return true;
+   if (isa<ClassTemplateSpecializationDecl>(D))
+      return false;
+   if (isa<TagDecl>(D))
+      return true;
+   if (const NamespaceDecl *NSD = dyn_cast<NamespaceDecl>(D)) {
+      if (NSD->isOriginalNamespace())
+         return true;
+   } else if (!isa<LinkageSpecDecl>(D)) {
+      return false;
+   }
+   // Reopened namespace or extern "C++" block: look at what it declares,
+   // without triggering any deserialization.
+   for (const clang::Decl *Inner : cast<DeclContext>(D)->noload_decls())
+      if (AffectsNameNormalization(Inner))
+         return true;
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the transaction (or one of its nested transactions) declares
+/// something that can change the type names normalized by TClassEdit.
+/// Deserialized declarations are not considered: the lookups done for
+/// TClassEdit already see the content of the PCH and modules.
+
+static bool AffectsNameNormalization(const cling::Transaction &T)
+{
+   for (cling::Transaction::const_iterator I = T.decls_begin(), E = T.decls_end(); I != E; ++I) {
+      if (I->m_Call != cling::Transaction::kCCIHandleTopLevelDecl
+          && I->m_Call != cling::Transaction::kCCIHandleTagDeclDefinition)
+         continue;
+      for (DeclGroupRef::const_iterator DI = I->m_DGR.begin(), DE = I->m_DGR.end(); DI != DE; ++DI)
+         if (AffectsNameNormalization(*DI))
+            return true;
+   }
+   for (auto NI = T.nested_begin(), NE = T.nested_end(); NI != NE; ++NI)
+      if (AffectsNameNormalization(**NI))
+         return true;
+   return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
@@ -6417,6 +6623,10 @@ void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
       }
    }
 
+   // New typedefs, scopes or templates can change how names normalize.
+   if (isTUTransaction || AffectsNameNormalization(T))
+      TClassEdit::ResetNormalizationCache();
+
    std::set<const void*> TransactionDeclSet;
    if (!isTUTransaction && T.decls_end() - T.decls_begin()) {
       const clang::Decl* WrapperFD = T.getWrapperFD();
@@ -6542,6 +6752,7 @@ void TCling::UnloadClassMembers(TClass* cl, const clang::DeclContext* DC) {
 void TCling::UpdateListsOnUnloaded(const cling::Transaction &T)
 {
    HandleNewTransaction(T);
+   TClassEdit::ResetNormalizationCache();
 
    // Unload the objects from the lists and update the objects' state.
    TListOfFunctions* functions = (TListOfFunctions*)gROOT->GetListOfGlobalFunctions();
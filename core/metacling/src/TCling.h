@@ -26,10 +26,12 @@
 
 #include "TInterpreter.h"
 
+#include <atomic>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
+#include <memory>
 #include <vector>
 
 #ifndef WIN32
@@ -157,6 +159,18 @@ private: // Data Members
    Bool_t fHeaderParsingOnDemand;
    Bool_t fIsAutoParsingSuspended;
 
+   struct DeferredPCM_t {
+      TString fFileName;
+      const char **fHeaders;
+      void (*fTriggerFunc)();
+      bool fLoaded;
+   };
+   Bool_t fLazyPCMs = kFALSE;                   // True if ROOT PCMs are read on first use (Root.LazyPCM)
+   std::vector<std::unique_ptr<DeferredPCM_t>> fDeferredPCMs; // ROOT PCMs of modules registered in lazy mode
+   std::unordered_map<std::string, DeferredPCM_t*> fDeferredPCMClasses; // Normalized names of the classes described by each deferred PCM
+   std::unordered_map<std::string, DeferredPCM_t*> fDeferredPCMLibraries; // Library names (without extension) of the deferred PCMs
+   std::atomic<bool> fHasDeferredPCMs{false};   // True if a deferred PCM was not read yet
+
    UInt_t AutoParseImplRecurse(const char *cls, bool topLevel);
    constexpr static const char* kNullArgv[] = {nullptr};
 
@@ -185,6 +199,7 @@ public: // Public Interface
    void    ClearStack(); // Delete existing temporary values
    Bool_t  Declare(const char* code);
    void    EnableAutoLoading();
+   Bool_t  LoadDeferredPCMs(const char *classname, Bool_t hasDictionary);
    void    EndOfLineAction();
    TClass *GetClass(const std::type_info& typeinfo, Bool_t load) const;
    Int_t   GetExitCode() const { return fExitCode; }
@@ -568,7 +583,8 @@ private: // Private Utility Functions and Classes
    void AddFriendToClass(clang::FunctionDecl*, clang::CXXRecordDecl*) const;
 
    bool LoadPCM(TString pcmFileName, const char** headers,
-                void (*triggerFunc)()) const;
+                void (*triggerFunc)(), bool replaceClasses = true) const;
+   void LoadDeferredPCM(DeferredPCM_t &pcm);
    void InitRootmapFile(const char *name);
    int  ReadRootmapFile(const char *rootmapfile, TUniqueString* uniqueString = nullptr);
    Bool_t HandleNewTransaction(const cling::Transaction &T);
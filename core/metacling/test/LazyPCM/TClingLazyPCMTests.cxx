@@ -0,0 +1,68 @@
+#include "TClass.h"
+#include "TClassTable.h"
+#include "TEnv.h"
+#include "TProtoClass.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+// The .rootrc of this directory enables Root.LazyPCM.
+TEST(TClingLazyPCM, Enabled)
+{
+   ASSERT_EQ(1, gEnv->GetValue("Root.LazyPCM", 0));
+}
+
+// The PCM of a library loaded in lazy mode is read for its normalized class names.
+TEST(TClingLazyPCM, NormalizedName)
+{
+   ASSERT_LE(0, gSystem->Load("libMatrix"));
+
+   // not normalized: Double_t is a typedef
+   TProtoClass *proto = TClassTable::GetProto("TVectorT<Double_t>");
+   ASSERT_NE(nullptr, proto);
+   EXPECT_STREQ("TVectorT<double>", proto->GetName());
+
+   EXPECT_NE(nullptr, TClassTable::GetProto("TMatrixT<double>"));
+}
+
+// A TClass requested through a typedef is set up from the PCM.
+TEST(TClingLazyPCM, Typedef)
+{
+   ASSERT_LE(0, gSystem->Load("libMatrix"));
+
+   TClass *cl = TClass::GetClass("TMatrixDSym");
+   ASSERT_NE(nullptr, cl);
+   EXPECT_STREQ("TMatrixTSym<double>", cl->GetName());
+   EXPECT_TRUE(cl->HasDictionary());
+   EXPECT_NE(nullptr, cl->GetListOfDataMembers()->FindObject("fDataStack"));
+   EXPECT_NE(nullptr, cl->GetListOfBases()->FindObject("TMatrixTBase<double>"));
+}
+
+// Classes which are not listed by the deferred PCMs, e.g. the classes of the
+// modules whose PCM is not used or unknown names, do not cause any PCM to be read.
+TEST(TClingLazyPCM, Unlisted)
+{
+   ASSERT_LE(0, gSystem->Load("libHist"));
+
+   const Int_t oldDebug = gDebug;
+   gDebug = 1;
+   testing::internal::CaptureStderr();
+   EXPECT_EQ(nullptr, TClassTable::GetProto("TObject"));
+   EXPECT_EQ(nullptr, TClassTable::GetProtoNorm("TNamed"));
+   EXPECT_EQ(nullptr, TClassTable::GetProto("NotAClassOfAnyLibrary"));
+   std::string output = testing::internal::GetCapturedStderr();
+   EXPECT_EQ(std::string::npos, output.find("reading the deferred PCM")) << output;
+
+   // only the PCM of libHist is read for its classes
+   testing::internal::CaptureStderr();
+   EXPECT_NE(nullptr, TClassTable::GetProtoNorm("TH1F"));
+   output = testing::internal::GetCapturedStderr();
+   gDebug = oldDebug;
+   EXPECT_NE(std::string::npos, output.find("reading the deferred PCM libHist_rdict.pcm")) << output;
+   EXPECT_EQ(std::string::npos, output.find("reading the deferred PCM libMatrix")) << output;
+
+   TClass *cl = TClass::GetClass("TH1F");
+   ASSERT_NE(nullptr, cl);
+   EXPECT_NE(nullptr, cl->GetListOfBases()->FindObject("TH1"));
+}
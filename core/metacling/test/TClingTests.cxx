@@ -1,4 +1,5 @@
 #include "TClass.h"
+#include "TClassEdit.h"
 #include "TInterpreter.h"
 #include "TSystem.h"
 
@@ -122,3 +123,47 @@ TEST_F(TClingTests, MakeInterpreterValue)
    ASSERT_THAT(v->ToString(), testing::HasSubstr("void my_func_to_print"));
 }
 #endif
+
+// The normalization caches of TClassEdit survive the declarations which cannot
+// change the normalized names, and are reset by new typedefs.
+TEST_F(TClingTests, NormalizationCache)
+{
+   gInterpreter->Declare("struct NormCacheA {};");
+   EXPECT_EQ("NormCacheTypedef_t", TClassEdit::ResolveTypedef("NormCacheTypedef_t"));
+
+   const char *names[] = {"vector<int>", "std::vector<double>", "vector<vector<float> >", "list<int>",
+                          "std::map<int,float>", "map<string,int>", "std::set<long>", "deque<short>",
+                          "unordered_map<int,int>", "pair<int,double>", "vector<NormCacheA>",
+                          "map<int,vector<NormCacheA> >", "std::multimap<char,int>", "vector<string>",
+                          "vector<pair<int,float> >", "set<unsigned int>", "std::list<NormCacheA*>",
+                          "vector<bool>", "map<long,std::string>", "vector<Long64_t>"};
+   auto normalizeAll = [&names]() {
+      for (const char *name : names) {
+         std::string norm;
+         TClassEdit::GetNormalizedName(norm, name);
+         TClassEdit::ResolveTypedef(name, true);
+         TClassEdit::ShortType(name, TClassEdit::kDropStlDefault);
+      }
+   };
+
+   // Typical session: names are normalized again after each new function.
+   normalizeAll();
+   const auto before = TClassEdit::GetNormalizationCacheStats();
+   for (int i = 0; i < 10; ++i) {
+      gInterpreter->Declare(("int NormCacheFunc" + std::to_string(i) + "() { return 0; }").c_str());
+      normalizeAll();
+   }
+   const auto after = TClassEdit::GetNormalizationCacheStats();
+   const double hits = after.fHits - before.fHits;
+   const double misses = after.fMisses - before.fMisses;
+   ASSERT_GT(hits + misses, 0.);
+   EXPECT_GE(hits / (hits + misses), 0.95) << hits << " hits, " << misses << " misses";
+   EXPECT_GE(after.fEntries, before.fEntries);
+
+   // A new typedef invalidates the cached results.
+   gInterpreter->Declare("typedef NormCacheA NormCacheTypedef_t;");
+   EXPECT_EQ("NormCacheA", TClassEdit::ResolveTypedef("NormCacheTypedef_t"));
+   std::string norm;
+   TClassEdit::GetNormalizedName(norm, "vector<NormCacheTypedef_t>");
+   EXPECT_EQ("vector<NormCacheA>", norm);
+}
@@ -16,6 +16,7 @@
 #pragma link off all functions;
 
 #pragma link C++ class TMPClient;
+#pragma link C++ class TMPForkServer;
 #pragma link C++ class TMPWorker;
 #pragma link C++ class ROOT::TProcessExecutor;
 #pragma link C++ class TProcPool;  // Deprecated but still needed for backward compatibility
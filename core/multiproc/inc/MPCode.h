@@ -20,7 +20,7 @@ namespace MPCode {
    //////////////////////////////////////////////////////////////////////////
    ///
    /// An enumeration of the message codes handled by TProcessExecutor,
-   /// TTreeProcessorMP, TMPWorker, TMPWorkerTree and by the low level
+   /// TTreeProcessorMP, TMPForkServer, TMPWorker, TMPWorkerTree and by the low level
    /// classes TMPClient and TMPWorker.
    ///
    //////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,9 @@ namespace MPCode {
       kProcResult,      ///< The message contains the result of the processing of a TTree
       kProcEnded,       ///< Tell the client we are done processing (i.e. we have reached the target number of entries to process)
       kProcError,       ///< Tell the client there was an error while processing
+      /* TMPForkServer */
+      kForkJob = 300,   ///< Tell a TMPForkServer to fork and run a job. The object sent is the command to execute
+      kJobResult,       ///< The message contains the value returned by the job
       /* Generic messages, including errors */
       kMessage = 1000,  ///< Generic message
       kError,           ///< Error message
@@ -0,0 +1,52 @@
+/* @(#)root/multiproc:$Id$ */
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMPForkServer
+#define ROOT_TMPForkServer
+
+#include "MPSendRecv.h"
+#include "TServerSocket.h"
+#include <memory> //unique_ptr
+#include <string>
+#include <unistd.h> //pid_t
+#include <vector>
+
+class TMPForkServer {
+public:
+   explicit TMPForkServer(const char *sockpath);
+   ~TMPForkServer();
+   //it doesn't make sense to copy a TMPForkServer
+   TMPForkServer(const TMPForkServer &) = delete;
+   TMPForkServer &operator=(const TMPForkServer &) = delete;
+
+   bool IsValid() const { return fServer && fServer->IsValid(); }
+   bool Preload(const char *library);
+   int Run();
+   /// Number of jobs started since construction
+   unsigned GetNJobs() const { return fNJobs; }
+   /// Milliseconds to wait for the request of a new connection
+   long GetRecvTimeout() const { return fRecvTimeout; }
+   void SetRecvTimeout(long ms) { fRecvTimeout = ms; }
+
+   static Long64_t Submit(const char *sockpath, const char *cmd);
+   static bool Shutdown(const char *sockpath);
+
+private:
+   void RunJob(TSocket *s, const char *cmd);
+   void ReapJobs(bool wait);
+
+   std::string fSockPath; ///< Path of the Unix socket on which job requests are received
+   std::unique_ptr<TServerSocket> fServer; ///< The listening socket
+   std::vector<pid_t> fJobPids; ///< The PIDs of the jobs which have not been reaped yet
+   unsigned fNJobs; ///< Number of jobs started
+   long fRecvTimeout; ///< Milliseconds to wait for the request of a new connection
+};
+
+#endif
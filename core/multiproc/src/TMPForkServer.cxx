@@ -0,0 +1,285 @@
+/* @(#)root/multiproc:$Id$ */
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "MPCode.h"
+#include "TError.h"
+#include "TGuiFactory.h" //gGuiFactory
+#include "TMPForkServer.h"
+#include "TROOT.h" //gROOT, ROOT::IsImplicitMTEnabled
+#include "TSocket.h"
+#include "TSystem.h" //gSystem
+#include "TVirtualX.h" //gVirtualX
+#include <errno.h>
+#include <stdio.h> //fflush
+#include <sys/wait.h> // waitpid
+#include <unistd.h> // fork
+
+namespace {
+/// Milliseconds to wait for a connection before reaping the finished jobs again
+constexpr long kReapInterval = 1000;
+}
+
+//////////////////////////////////////////////////////////////////////////
+///
+/// \class TMPForkServer
+///
+/// A ROOT session that is initialized once and then forked for every job
+/// request it receives on a local Unix socket. Each job runs in a child
+/// process which inherits the warm state of the server (TROOT, TCling,
+/// the preloaded libraries) instead of paying the full initialization.
+///
+/// The server is started with `root.exe --fork-server <socket path> [libraries]`
+/// or by creating a TMPForkServer and calling Run(). Jobs are submitted with
+/// Submit(), which sends the command to execute (e.g. `.x job.C("run1")`),
+/// and returns its result once the job is done. Shutdown() stops the server.
+///
+/// Requests and replies are exchanged with MPSend() and MPRecv(), using the
+/// MPCode::kForkJob and MPCode::kJobResult codes.
+///
+/// The socket is only accessible by the user running the server. Requests
+/// which do not arrive within GetRecvTimeout() milliseconds of the connection
+/// are dropped, and jobs are refused while implicit multi-threading is enabled
+/// in the server, as its thread pool does not survive fork().
+///
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+/// Class constructor.
+/// \param sockpath the absolute path of the Unix socket on which job
+/// requests are received. An existing file with that name is removed.
+/// The socket file gets mode 0600.
+TMPForkServer::TMPForkServer(const char *sockpath)
+   : fSockPath(sockpath ? sockpath : ""), fServer(), fJobPids(), fNJobs(0), fRecvTimeout(10000)
+{
+   if (fSockPath.empty() || fSockPath[0] != '/') {
+      Error("TMPForkServer::TMPForkServer", "[E] the socket path must be absolute: \"%s\"\n", fSockPath.c_str());
+      return;
+   }
+   //no other user may connect, not even between bind() and chmod()
+   int oldmask = gSystem->Umask(077);
+   fServer.reset(new TServerSocket(fSockPath.c_str()));
+   gSystem->Umask(oldmask);
+   if (!fServer->IsValid()) {
+      Error("TMPForkServer::TMPForkServer", "[E] could not listen on %s\n", fSockPath.c_str());
+   } else if (gSystem->Chmod(fSockPath.c_str(), 0600)) {
+      Error("TMPForkServer::TMPForkServer", "[E] could not restrict the access to %s\n", fSockPath.c_str());
+      fServer->Close();
+      gSystem->Unlink(fSockPath.c_str());
+   }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Class destructor.
+/// Wait for the running jobs and remove the socket file.
+TMPForkServer::~TMPForkServer()
+{
+   ReapJobs(true);
+   if (IsValid()) {
+      fServer->Close();
+      gSystem->Unlink(fSockPath.c_str());
+   }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Load a library in the server, so that the jobs find it already loaded.
+/// \return true if the library was loaded
+bool TMPForkServer::Preload(const char *library)
+{
+   if (gSystem->Load(library) < 0) {
+      Error("TMPForkServer::Preload", "[E] could not load %s\n", library);
+      return false;
+   }
+   return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Serve job requests until a MPCode::kShutdownOrder is received.
+/// For each MPCode::kForkJob request the session is forked: the child runs
+/// the job and replies to the requester, the server goes back to waiting.
+/// Finished jobs are reaped at least every second, also while no request
+/// arrives, so that they do not linger as zombies.
+/// \return 0 if the server was shut down, 1 if it could not start
+int TMPForkServer::Run()
+{
+   if (!IsValid())
+      return 1;
+
+   while (true) {
+      ReapJobs(false);
+      if (fServer->Select(TSocket::kRead, kReapInterval) != 1)
+         continue;
+      TSocket *s = fServer->Accept();
+      if (!s || s == (TSocket *)-1)
+         continue;
+
+      //do not let a silent client block the server
+      if (s->Select(TSocket::kRead, fRecvTimeout) != 1) {
+         Warning("TMPForkServer::Run", "[W] no request received within %ld ms, closing the connection\n", fRecvTimeout);
+         delete s;
+         continue;
+      }
+
+      MPCodeBufPair msg = MPRecv(s);
+      unsigned code = msg.first;
+      if (code == MPCode::kForkJob && ROOT::IsImplicitMTEnabled()) {
+         MPSend(s, MPCode::kError, "cannot fork while implicit multi-threading is enabled");
+      } else if (code == MPCode::kForkJob) {
+         const char *cmd = ReadBuffer<const char *>(msg.second.get());
+         pid_t pid = fork();
+         if (!pid)
+            RunJob(s, cmd); // does not return
+         if (pid < 0) {
+            std::string reply = "could not fork, error n. " + std::to_string(errno);
+            MPSend(s, MPCode::kError, reply.c_str());
+         } else {
+            fJobPids.push_back(pid);
+            ++fNJobs;
+         }
+         delete [] cmd;
+      } else if (code == MPCode::kShutdownOrder) {
+         MPSend(s, MPCode::kShutdownNotice, fSockPath.c_str());
+         delete s;
+         break;
+      } else if (code != MPCode::kRecvError) {
+         std::string reply = "unknown code received. code=" + std::to_string(code);
+         MPSend(s, MPCode::kError, reply.c_str());
+      }
+      // the connection is now owned by the job, if any
+      delete s;
+   }
+
+   ReapJobs(true);
+   return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Run a job in the forked child process: execute cmd with TROOT::ProcessLine
+/// and send back its result as a MPCode::kJobResult message.
+/// The child exits with status 1 if the interpreter reported an error.
+void TMPForkServer::RunJob(TSocket *s, const char *cmd)
+{
+   //only the parent listens for new jobs
+   fServer->Close();
+   fJobPids.clear();
+
+   //override signal handler (make the jobs exit on SIGINT)
+   TSeqCollection *signalHandlers = gSystem->GetListOfSignalHandlers();
+   TSignalHandler *sh = nullptr;
+   if (signalHandlers && signalHandlers->GetSize() > 0)
+      sh = (TSignalHandler *)signalHandlers->First();
+   if (sh)
+      gSystem->RemoveSignalHandler(sh);
+
+   //disable graphics, as in TMPClient::Fork
+   gROOT->SetBatch();
+   if (gGuiFactory != gBatchGuiFactory)
+      delete gGuiFactory;
+   gGuiFactory = gBatchGuiFactory;
+#ifndef R__WIN32
+   if (gVirtualX != gGXBatch)
+      delete gVirtualX;
+#endif
+   gVirtualX = gGXBatch;
+
+   Int_t error = 0;
+   Long64_t result = gROOT->ProcessLine(cmd, &error);
+   if (error)
+      result = -1;
+   fflush(stdout);
+   fflush(stderr);
+
+   MPSend(s, MPCode::kJobResult, result);
+   delete s;
+   gSystem->Exit(error ? 1 : 0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Wait on terminated jobs and remove their pids from fJobPids.
+/// \param wait if true block until all jobs are done, otherwise only
+/// reap the jobs that already terminated
+void TMPForkServer::ReapJobs(bool wait)
+{
+   for (auto it = fJobPids.begin(); it != fJobPids.end();) {
+      pid_t ret = waitpid(*it, nullptr, wait ? 0 : WNOHANG);
+      if (ret == 0)
+         ++it;
+      else
+         it = fJobPids.erase(it);
+   }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Ask the fork server listening on sockpath to run cmd in a new process,
+/// and wait for the job to finish.
+/// \param sockpath the path of the socket passed to the server
+/// \param cmd the line to execute, e.g. `.x job.C("run1")`
+/// \return the value returned by cmd, or -1 if the job failed
+Long64_t TMPForkServer::Submit(const char *sockpath, const char *cmd)
+{
+   TSocket s(sockpath);
+   if (!s.IsValid()) {
+      Error("TMPForkServer::Submit", "[E] could not connect to %s\n", sockpath);
+      return -1;
+   }
+   if (MPSend(&s, MPCode::kForkJob, cmd) <= 0) {
+      Error("TMPForkServer::Submit", "[E] could not send the job to %s\n", sockpath);
+      return -1;
+   }
+
+   MPCodeBufPair msg = MPRecv(&s);
+   if (msg.first == MPCode::kJobResult)
+      return ReadBuffer<Long64_t>(msg.second.get());
+
+   if (msg.first == MPCode::kError) {
+      const char *str = ReadBuffer<const char *>(msg.second.get());
+      Error("TMPForkServer::Submit", "[E] error message received: %s\n", str);
+      delete [] str;
+   } else {
+      Error("TMPForkServer::Submit", "[E] the job did not complete\n");
+   }
+   return -1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Ask the fork server listening on sockpath to stop. Running jobs
+/// are not interrupted.
+/// \return true if the server acknowledged the request
+bool TMPForkServer::Shutdown(const char *sockpath)
+{
+   TSocket s(sockpath);
+   if (!s.IsValid() || MPSend(&s, MPCode::kShutdownOrder) <= 0)
+      return false;
+   return MPRecv(&s).first == MPCode::kShutdownNotice;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Entry point of `root.exe --fork-server`, which loads libMultiProc only
+/// in that mode: create a TMPForkServer listening on sockpath, preload the
+/// nlibs libraries and Run() it.
+/// \return the value returned by Run(), or 1 if the server could not start
+extern "C" int RunTMPForkServer(const char *sockpath, int nlibs, char **libs)
+{
+   TMPForkServer server(sockpath);
+   if (!server.IsValid())
+      return 1;
+   for (int i = 0; i < nlibs; ++i) {
+      if (!server.Preload(libs[i]))
+         return 1;
+   }
+   return server.Run();
+}
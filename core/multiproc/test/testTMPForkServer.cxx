@@ -0,0 +1,105 @@
+#include "TMPForkServer.h"
+#include "TROOT.h"
+#include "TSocket.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+std::string SocketPath(const char *name)
+{
+   return std::string(gSystem->TempDirectory()) + "/testTMPForkServer_" + std::to_string(gSystem->GetPid()) + "_" +
+          name;
+}
+
+// Run a TMPForkServer in a child process; setup is called on it before Run().
+template <typename F>
+pid_t StartServer(const std::string &path, F setup)
+{
+   pid_t pid = fork();
+   if (!pid) {
+      int ret = 1;
+      {
+         TMPForkServer server(path.c_str());
+         setup(server);
+         ret = server.Run();
+      }
+      _exit(ret);
+   }
+   // wait for the server to listen
+   for (int i = 0; i < 1000 && gSystem->AccessPathName(path.c_str()); ++i)
+      gSystem->Sleep(10);
+   return pid;
+}
+
+// Stop the server and return its exit status.
+int StopServer(const std::string &path, pid_t pid)
+{
+   EXPECT_TRUE(TMPForkServer::Shutdown(path.c_str()));
+   int status = -1;
+   waitpid(pid, &status, 0);
+   return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+} // namespace
+
+TEST(TMPForkServer, Submit)
+{
+   const std::string path = SocketPath("Submit");
+   pid_t pid = StartServer(path, [](TMPForkServer &) {});
+   ASSERT_LT(0, pid);
+
+   EXPECT_EQ(3, TMPForkServer::Submit(path.c_str(), "1+2"));
+   EXPECT_EQ(6, TMPForkServer::Submit(path.c_str(), "2*3"));
+   // the result is not narrowed to int
+   EXPECT_EQ(1LL << 40, TMPForkServer::Submit(path.c_str(), "1LL << 40"));
+
+   EXPECT_EQ(0, StopServer(path, pid));
+   EXPECT_TRUE(gSystem->AccessPathName(path.c_str())) << "the socket file was not removed";
+}
+
+// Other users cannot connect to the server.
+TEST(TMPForkServer, SocketMode)
+{
+   const std::string path = SocketPath("SocketMode");
+   pid_t pid = StartServer(path, [](TMPForkServer &) {});
+   ASSERT_LT(0, pid);
+
+   ASSERT_EQ(3, TMPForkServer::Submit(path.c_str(), "1+2"));
+   FileStat_t st;
+   ASSERT_EQ(0, gSystem->GetPathInfo(path.c_str(), st));
+   EXPECT_EQ(0600, st.fMode & 0777);
+
+   EXPECT_EQ(0, StopServer(path, pid));
+}
+
+// A client which connects without sending a request does not block the server.
+TEST(TMPForkServer, RecvTimeout)
+{
+   const std::string path = SocketPath("RecvTimeout");
+   pid_t pid = StartServer(path, [](TMPForkServer &server) { server.SetRecvTimeout(100); });
+   ASSERT_LT(0, pid);
+
+   TSocket silent(path.c_str());
+   ASSERT_TRUE(silent.IsValid());
+   EXPECT_EQ(3, TMPForkServer::Submit(path.c_str(), "1+2"));
+
+   EXPECT_EQ(0, StopServer(path, pid));
+}
+
+#ifdef R__USE_IMT
+// The thread pool of implicit multi-threading does not survive fork().
+TEST(TMPForkServer, RefuseWithIMT)
+{
+   const std::string path = SocketPath("RefuseWithIMT");
+   pid_t pid = StartServer(path, [](TMPForkServer &) { ROOT::EnableImplicitMT(2); });
+   ASSERT_LT(0, pid);
+
+   EXPECT_EQ(-1, TMPForkServer::Submit(path.c_str(), "1+2"));
+
+   EXPECT_EQ(0, StopServer(path, pid));
+}
+#endif
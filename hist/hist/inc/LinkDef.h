@@ -95,6 +95,12 @@
 #pragma link C++ class TNDArrayT<ULong_t>+;
 #pragma link C++ class TNDArrayT<UInt_t>+;
 #pragma link C++ class TNDArrayT<UShort_t>+;
+#pragma link C++ class TNDArrayOnDisk-;
+#pragma link C++ class TNDArrayOnDiskT<Float_t>+;
+#pragma link C++ class TNDArrayOnDiskT<Double_t>+;
+#pragma link C++ class TNDArrayOnDiskT<Int_t>+;
+#pragma link C++ class TNDArrayOnDiskT<Short_t>+;
+#pragma link C++ class TNDArrayOnDiskT<Char_t>+;
 #pragma link C++ class TNDArrayRef<Float_t>+;
 //#pragma link C++ class TNDArrayRef<Float16_t>+;
 #pragma link C++ class TNDArrayRef<Double_t>+;
@@ -138,6 +144,11 @@
 #pragma link C++ class THnT<ULong_t>+;
 #pragma link C++ class THnT<UInt_t>+;
 #pragma link C++ class THnT<UShort_t>+;
+#pragma link C++ class THnOnDiskT<Float_t>+;
+#pragma link C++ class THnOnDiskT<Double_t>+;
+#pragma link C++ class THnOnDiskT<Int_t>+;
+#pragma link C++ class THnOnDiskT<Short_t>+;
+#pragma link C++ class THnOnDiskT<Char_t>+;
 #pragma link C++ class THnSparse+;
 #pragma link C++ class THnSparseT<TArrayD>+;
 #pragma link C++ class THnSparseT<TArrayF>+;
@@ -122,6 +122,9 @@ namespace ROOT {
          // evaluate the derivative of the function with respect to the parameters
          void ParameterGradient(const T *x, const double *par, T *grad) const;
 
+         // evaluate the function at n points using TF1::EvalParBatch when possible
+         void EvalBatch(unsigned int n, const T *x, const double *p, T *result) const;
+
          /// precision value used for calculating the derivative step-size
          /// h = eps * |x|. The default is 0.001, give a smaller in case function changes rapidly
          static void SetDerivPrecision(double eps);
@@ -207,6 +210,47 @@ namespace ROOT {
          }
       };
 
+      /**
+       * Auxiliar class to call TF1::EvalParBatch, which exists only for double, from
+       * WrappedMultiTF1Templ::EvalBatch; other types use the default point-by-point evaluation.
+       */
+      template <class T>
+      struct TF1BatchEvaluation {
+         static bool EvalBatch(TF1 *, unsigned int, const T *, const double *, T *)
+         {
+            return false;
+         }
+      };
+
+      template <>
+      struct TF1BatchEvaluation<double> {
+         static bool EvalBatch(TF1 *f, unsigned int n, const double *x, const double *p, double *result)
+         {
+            f->EvalParBatch(n, x, p, result);
+            return true;
+         }
+      };
+
+      /**
+       * Auxiliar class to call TF1::GradientParAD, which exists only for double, from
+       * WrappedMultiTF1Templ::ParameterGradient; other types use the numerical derivatives.
+       */
+      template <class T>
+      struct TF1GradientAD {
+         static bool ParameterGradient(TF1 *, const T *, T *)
+         {
+            return false;
+         }
+      };
+
+      template <>
+      struct TF1GradientAD<double> {
+         static bool ParameterGradient(TF1 *f, const double *x, double *grad)
+         {
+            return f->GradientParAD(x, grad);
+         }
+      };
+
       // implementations for WrappedMultiTF1Templ<T>
       template<class T>
       WrappedMultiTF1Templ<T>::WrappedMultiTF1Templ(TF1 &f, unsigned int dim)  :
@@ -267,6 +311,15 @@ namespace ROOT {
          return *this;
       }
 
+      template <class T>
+      void WrappedMultiTF1Templ<T>::EvalBatch(unsigned int n, const T *x, const double *p, T *result) const
+      {
+         // the TF1 must use the same layout of the coordinates
+         if (fDim == (unsigned int) fFunc->GetNdim() && TF1BatchEvaluation<T>::EvalBatch(fFunc, n, x, p, result))
+            return;
+         BaseParamFunc::EvalBatch(n, x, p, result);
+      }
+
       template <class T>
       void WrappedMultiTF1Templ<T>::ParameterGradient(const T *x, const double *par, T *grad) const
       {
@@ -278,6 +331,9 @@ namespace ROOT {
          if (!fLinear) {
             // need to set parameter values
             fFunc->SetParameters(par);
+            // use the exact gradient of the formula when it can be generated
+            if (fDim == (unsigned int) fFunc->GetNdim() && TF1GradientAD<T>::ParameterGradient(fFunc, x, grad))
+               return;
             // no need to call InitArgs (it is called in TF1::GradientPar)
             double prec = this->GetDerivPrecision();
             fFunc->GradientPar(x, grad, prec);
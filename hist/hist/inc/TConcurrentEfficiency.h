@@ -0,0 +1,40 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TConcurrentEfficiency
+#define ROOT_TConcurrentEfficiency
+
+#include "TConcurrentHist.h"
+
+class TEfficiency;
+
+class TConcurrentEfficiency {
+public:
+   TConcurrentEfficiency(const TEfficiency &model, TConcurrentHist::EStorage storage = TConcurrentHist::kSharded,
+                         UInt_t nshards = 0);
+   ~TConcurrentEfficiency();
+   TConcurrentEfficiency(const TConcurrentEfficiency &) = delete;
+   TConcurrentEfficiency &operator=(const TConcurrentEfficiency &) = delete;
+
+   void               Fill(Bool_t passed, Double_t x, Double_t y = 0, Double_t z = 0);
+   void               FillWeighted(Bool_t passed, Double_t weight, Double_t x, Double_t y = 0, Double_t z = 0);
+   Int_t              GetDimension() const { return fTotal.GetDimension(); }
+   const TEfficiency &GetModel() const { return *fModel; }
+   TEfficiency       *Merge(const char *name = nullptr) const;
+   void               Reset();
+
+private:
+   std::unique_ptr<TEfficiency> fModel; ///< Copy of the model, provides the statistic options
+   TConcurrentHist    fTotal;           ///< Total events
+   TConcurrentHist    fPassed;          ///< Events which passed the selection
+   std::atomic<bool>  fWeighted;        ///< True once FillWeighted was called
+};
+
+#endif
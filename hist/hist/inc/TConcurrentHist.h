@@ -0,0 +1,72 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TConcurrentHist
+#define ROOT_TConcurrentHist
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class TH1;
+
+class TConcurrentHist {
+public:
+   /// How the bin contents are stored
+   enum EStorage {
+      kSharded, ///< Each thread fills one of several copies of the bins, summed by Merge()
+      kAtomic   ///< All threads fill the same bins with atomic additions
+   };
+
+   TConcurrentHist(const TH1 &model, EStorage storage = kSharded, UInt_t nshards = 0);
+   ~TConcurrentHist();
+   TConcurrentHist(const TConcurrentHist &) = delete;
+   TConcurrentHist &operator=(const TConcurrentHist &) = delete;
+
+   Int_t       Fill(Double_t x, Double_t w = 1.);
+   Int_t       Fill(const Double_t *x, Double_t w = 1.);
+   Int_t       GetDimension() const { return fDimension; }
+   Double_t    GetEntries() const;
+   const TH1  &GetModel() const { return *fModel; }
+   UInt_t      GetNShards() const { return fShards.empty() ? 0 : fShards.size() - 1; }
+   ULong64_t   GetMemoryUsage() const;
+   EStorage    GetStorage() const { return fStorage; }
+   Bool_t      IsProfile() const { return fProfile; }
+   Bool_t      IsValid() const { return fValid; }
+   TH1        *Merge(const char *name = nullptr) const;
+   void        Reset();
+
+private:
+   struct Shard;
+
+   std::atomic<Double_t> *AllocateBins(Shard &shard);
+   Shard      &GetShard();
+   Bool_t      IsModelWeighted() const;
+
+   std::unique_ptr<TH1> fModel;                     ///< Empty copy of the model histogram, provides the axes
+   EStorage             fStorage;                   ///< Storage of the bin contents
+   Int_t                fDimension;                 ///< Dimension of the histogram
+   Int_t                fNcells;                    ///< Number of bins, including under/overflows
+   Int_t                fNsums;                     ///< Number of sums per bin: 2, or 4 for profiles
+   Bool_t               fValid;                     ///< Whether the model is supported
+   Bool_t               fProfile;                   ///< Whether the model is a TProfile or TProfile2D
+   Double_t             fVmin;                      ///< Lower limit of the profiled values (if fVmin != fVmax)
+   Double_t             fVmax;                      ///< Upper limit of the profiled values (if fVmin != fVmax)
+   Bool_t               fStatOverflows;             ///< Whether under/overflows enter the statistics
+   ULong64_t            fId;                        ///< Unique number of this object, identifies it in the threads
+   std::vector<std::unique_ptr<Shard>> fShards;     ///< Per thread bins (kSharded) and statistics; the last one is shared
+   std::atomic<UInt_t>  fNextShard;                 ///< Index of the shard given to the next thread filling
+   std::unique_ptr<std::atomic<Double_t>[]> fBins;  ///< Sums of all bins if kAtomic, fNsums per bin
+   std::atomic<bool>    fWeighted;                  ///< True once a weight different from 1 was filled
+};
+
+#endif
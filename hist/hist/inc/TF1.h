@@ -417,6 +417,7 @@ public:
    //template <class T> T Eval(T x, T y = 0, T z = 0, T t = 0) const; 
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = 0);
    template <class T> T EvalPar(const T *x, const Double_t *params = 0);
+   virtual void     EvalParBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *result);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    template <class T> T operator()(const T *x, const Double_t *params = nullptr);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
@@ -559,6 +560,7 @@ public:
    void GradientPar(const T *x, T *grad, Double_t eps = 0.01);
    template <class T>
    void GradientParTempl(const T *x, T *grad, Double_t eps = 0.01);
+   virtual Bool_t   GradientParAD(const Double_t *x, Double_t *grad);
 
    virtual void     InitArgs(const Double_t *x, const Double_t *params);
    static  void     InitStandardFunctions();
@@ -18,6 +18,7 @@
 #include "TObjArray.h"
 #include "TMethodCall.h"
 #include "TInterpreter.h"
+#include <atomic>
 #include <vector>
 #include <list>
 #include <map>
@@ -87,6 +88,7 @@ private:
    // All data members are transient apart from the string defining the formula and the parameter values
 
    TString           fClingInput;           //! input function passed to Cling
+   TString           fClingBody;            //! processed formula expression returned by the function in fClingInput
    std::vector<Double_t>  fClingVariables;       //!  cached variables
    std::vector<Double_t>  fClingParameters;      //  parameter values
    Bool_t            fReadyToExecute;       //! trasient to force initialization
@@ -101,13 +103,18 @@ private:
    using CallFuncSignature = TInterpreter::CallFuncIFacePtr_t::Generic_t;
    std::string       fGradGenerationInput; //! input query to clad to generate a gradient
    CallFuncSignature fFuncPtr = nullptr; //!  function pointer, owned by the JIT.
-   CallFuncSignature fGradFuncPtr = nullptr; //!  function pointer, owned by the JIT.
+   std::atomic<CallFuncSignature> fGradFuncPtr{nullptr}; //!  function pointer, owned by the JIT.
+   std::atomic<bool> fGradGenerationFailed{false}; //! true if clad could not generate the gradient
+   using BatchFuncSignature = void (*)(Int_t, Double_t *, Double_t *, Double_t *);
+   std::atomic<BatchFuncSignature> fBatchFuncPtr{nullptr}; //!  batched evaluation function pointer, owned by the JIT.
+   std::atomic<CallFuncSignature> fBatchFuncFor{nullptr};  //!  value of fFuncPtr for which fBatchFuncPtr was generated
    void *   fLambdaPtr = nullptr;            //!  pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
    void     FillDefaults();
+   BatchFuncSignature GenerateBatchEval() const;
    void     HandlePolN(TString &formula);
    void     HandleParametrizedFunctions(TString &formula);
    void HandleParamRanges(TString &formula);
@@ -125,7 +132,7 @@ private:
       return std::string(fClingName.Data()) + "_grad";
    }
    bool HasGradientGenerationFailed() const {
-      return !fGradMethod && !fGradGenerationInput.empty();
+      return fGradGenerationFailed.load(std::memory_order_acquire);
    }
 
 protected:
@@ -192,11 +199,15 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalParBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *result) const;
 
    /// Generate gradient computation routine with respect to the parameters.
    /// \returns true if a gradient was generated and GradientPar can be called.
    bool GenerateGradientPar();
 
+   /// \returns true if GenerateGradientPar succeeded for this formula.
+   bool HasGeneratedGradient() const { return fGradFuncPtr.load(std::memory_order_acquire) != nullptr; }
+
    /// Compute the gradient employing automatic differentiation.
    ///
    /// \param[in] x - The given variables, if nullptr the already stored
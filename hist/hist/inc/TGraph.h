@@ -35,9 +35,12 @@ class TH1F;
 class TCollection;
 class TF1;
 class TSpline;
+class TSpline3;
 
 #include "TFitResultPtr.h"
 
+#include <memory>
+
 class TGraph : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
 protected:
@@ -51,6 +54,9 @@ protected:
    Double_t           fMinimum;   ///< Minimum value for plotting along y
    Double_t           fMaximum;   ///< Maximum value for plotting along y
 
+   struct TEvalCache;
+   mutable std::shared_ptr<const TEvalCache> fEvalCache; ///<! What Eval found about the points, see GetEvalCache
+
    static void        SwapValues(Double_t* arr, Int_t pos1, Int_t pos2);
    virtual void       SwapPoints(Int_t pos1, Int_t pos2);
 
@@ -63,6 +69,8 @@ protected:
    virtual void       FillZero(Int_t begin, Int_t end, Bool_t from_ctor = kTRUE);
    Double_t         **ShrinkAndCopy(Int_t size, Int_t iend);
    virtual Bool_t     DoMerge(const TGraph * g);
+   Double_t           EvalLinear(Double_t x, const TEvalCache &cache) const;
+   std::shared_ptr<const TEvalCache> GetEvalCache(Bool_t withSpline) const;
 
 public:
    // TGraph status bits
@@ -103,6 +111,7 @@ public:
    virtual void          DrawGraph(Int_t n, const Double_t *x=0, const Double_t *y=0, Option_t *option="");
    virtual void          DrawPanel(); // *MENU*
    virtual Double_t      Eval(Double_t x, TSpline *spline=0, Option_t *option="") const;
+   virtual void          EvalN(Int_t n, const Double_t *x, Double_t *y, Option_t *option="") const;
    virtual void          ExecuteEvent(Int_t event, Int_t px, Int_t py);
    virtual void          Expand(Int_t newsize);
    virtual void          Expand(Int_t newsize, Int_t step);
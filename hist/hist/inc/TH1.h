@@ -81,6 +81,8 @@ public:
    };
 
    friend class TH1Merger;
+   friend class TConcurrentHist;
+   friend class TEfficiency;
 
 protected:
     Int_t         fNcells;          ///< number of bins(1D), cells (2D) +U/Overflows
@@ -145,6 +147,9 @@ protected:
                                Option_t * opt, Bool_t doerr = kFALSE) const;
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
+
+   enum { kNFillNChunk = 256 };  ///< Number of entries whose bins are found at once by the FillN methods
+
    Bool_t    GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; }
 
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
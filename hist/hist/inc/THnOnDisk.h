@@ -0,0 +1,142 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THnOnDisk
+#define ROOT_THnOnDisk
+
+#include "THn.h"
+#include "TNDArrayOnDisk.h"
+
+//______________________________________________________________________________
+/** \class THnOnDiskT
+ Out-of-core implementation of the abstract base THn.
+ All functionality and the interfaces to be used are in THn!
+
+ The bin contents (and errors, once Sumw2() is called) are not kept in
+ memory but in uncompressed backing files, see TNDArrayOnDisk. Only a
+ limited number of chunks of bins is resident at any time, so the
+ histogram can be much larger than the available RAM:
+
+     // 8 dimensions with 12 bins each: 1.5e9 bins, 12GB as THnD
+     THnOnDiskF hn("eff", "efficiency map", 8, nbins, xmin, xmax,
+                   "/scratch/eff.bins");
+     hn.Fill(x);
+     TH1D* h0 = hn.Projection(0);
+
+ Accesses are fast as long as they stay within the resident chunks; filling
+ with randomly distributed entries causes a chunk to be read and written
+ back for most entries. Projections iterate over the bins in storage order
+ and thus read each chunk once.
+
+ If a backing file name is given, that file holds the bin contents and the
+ file name with ".sumw2" appended holds the errors; both are kept when the
+ histogram is destroyed, and existing files provide the initial content.
+ Otherwise temporary files are used.
+ Writing the histogram stores the chunks of bins which are not all zero
+ together with the axes and statistics, so the ROOT file is self-contained;
+ the key of the histogram limits them to 1GB. A histogram read back uses
+ temporary backing files. Use THn::CreateHn() or THnSparse::CreateSparse()
+ to get an in-memory copy if it fits into memory.
+
+ Typedefs exist for template parematers with ROOT's generic types:
+
+ Templated name       |     Typedef   |    Bin content type
+ ---------------------|---------------|--------------------
+   THnOnDiskT<Char_t>   |   THnOnDiskC  |     Char_t
+   THnOnDiskT<Short_t>  |   THnOnDiskS  |     Short_t
+   THnOnDiskT<Int_t>    |   THnOnDiskI  |     Int_t
+   THnOnDiskT<Float_t>  |   THnOnDiskF  |     Float_t
+   THnOnDiskT<Double_t> |   THnOnDiskD  |     Double_t
+*/
+
+template <typename T>
+class THnOnDiskT: public THn {
+public:
+   THnOnDiskT() {}
+
+   THnOnDiskT(const char* name, const char* title,
+              Int_t dim, const Int_t* nbins,
+              const Double_t* xmin, const Double_t* xmax,
+              const char* fileName = 0,
+              Long64_t chunkSize = TNDArrayOnDisk::kDefaultChunkSize,
+              Int_t maxResidentChunks = TNDArrayOnDisk::kDefaultMaxResidentChunks):
+   THn(name, title, dim, nbins, xmin, xmax),
+   fArray(dim, nbins, true, chunkSize, maxResidentChunks, fileName),
+   fSumw2OnDisk(dim, nbins, true, chunkSize, maxResidentChunks,
+                fileName && fileName[0] ? TString(fileName) + ".sumw2" : TString()) {}
+
+   const TNDArray& GetArray() const { return fArray; }
+   TNDArray& GetArray() { return fArray; }
+
+   void FillBin(Long64_t bin, Double_t w) {
+      // Increment the bin content of "bin" by "w".
+      fArray.AddAt(bin, w);
+      if (GetCalculateErrors()) {
+         fSumw2OnDisk.AddAt(bin, w * w);
+      }
+      FillBinBase(w);
+   }
+   void SetBinError2(Long64_t bin, Double_t e2) {
+      if (!GetCalculateErrors()) Sumw2();
+      fSumw2OnDisk.SetAsDouble(bin, e2);
+   }
+   void AddBinError2(Long64_t bin, Double_t e2) {
+      fSumw2OnDisk.AddAt(bin, e2);
+   }
+   Double_t GetBinError2(Long64_t linidx) const {
+      return GetCalculateErrors() ? fSumw2OnDisk.AtAsDouble(linidx) : GetBinContent(linidx);
+   }
+
+   void Sumw2() {
+      // Enable calculation of errors, initializing them from the bin contents.
+      const Bool_t hadErrors = GetCalculateErrors();
+      if (!hadErrors) fTsumw2 = 0.;
+      if (hadErrors || GetEntries() == 0.) return;
+      const Long64_t nbins = GetNbins();
+      for (Long64_t ibin = 0; ibin < nbins; ++ibin)
+         fSumw2OnDisk.SetAsDouble(ibin, fArray.AtAsDouble(ibin));
+   }
+
+   void Reset(Option_t* option = "") {
+      fArray.Reset(option);
+      fSumw2OnDisk.Reset(option);
+      ResetBase(option);
+   }
+
+   /// Write all modified resident bins to the backing files.
+   void Flush() {
+      fArray.Flush();
+      fSumw2OnDisk.Flush();
+   }
+
+   /// Set the maximal number of chunks of bin contents (and of errors) in memory.
+   void SetMaxResidentChunks(Int_t n) {
+      fArray.SetMaxResidentChunks(n);
+      fSumw2OnDisk.SetMaxResidentChunks(n);
+   }
+
+protected:
+   void InitStorage(Int_t* nbins, Int_t chunkSize) {
+      THn::InitStorage(nbins, chunkSize);
+      fSumw2OnDisk.Init(fNdimensions, nbins, true /*addOverflow*/);
+   }
+
+   TNDArrayOnDiskT<T> fArray; // bin content
+   TNDArrayOnDiskT<Double_t> fSumw2OnDisk; // bin error
+   ClassDef(THnOnDiskT, 1); // multi-dimensional histogram with out-of-core storage
+};
+
+typedef THnOnDiskT<Float_t>  THnOnDiskF;
+typedef THnOnDiskT<Double_t> THnOnDiskD;
+typedef THnOnDiskT<Char_t>   THnOnDiskC;
+typedef THnOnDiskT<Short_t>  THnOnDiskS;
+typedef THnOnDiskT<Int_t>    THnOnDiskI;
+
+#endif // ROOT_THnOnDisk
@@ -97,6 +97,7 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); // By default computed from the data
+   void SetGridApproximation(UInt_t npoints); // Approximate the estimate by interpolating between npoints (0: exact evaluation)
 
    virtual void Draw(const Option_t* option = "");
 
@@ -167,6 +168,7 @@ private:
    UInt_t fNEvents;        // Data's number of events
    Double_t fSumOfCounts; // Data sum of weights
    UInt_t fUseBinsNEvents; // If the algorithm is allowed to use automatic (relaxed) binning this is the minimum number of events to do so
+   UInt_t fNGridPoints;    // Number of points of the grid approximating the estimate in [fXMin, fXMax], 0 for exact evaluation
 
    Double_t fMean;  // Data mean
    Double_t fSigma; // Data std deviation
@@ -182,6 +184,7 @@ private:
    std::vector<Double_t> fKernelSigmas2;
 
    std::vector<Double_t> fBinCount; // Number of events per bin for binned data option
+   std::vector<Double_t> fGridValues; //! Estimate at the grid points for the grid approximation
 
    std::vector<Bool_t> fSettedOptions; // User input options flag
 
@@ -215,12 +218,15 @@ private:
    Double_t ComputeKernelMu() const;
    Double_t ComputeKernelIntegral() const;
    Double_t ComputeMidspread() ;
+   Double_t GetKernelSupport() const;
    void ComputeDataStats() ;
 
    UInt_t Index(Double_t x) const;
 
    void SetBinCentreData(Double_t xmin, Double_t xmax);
    void SetBinCountData();
+   void SetGridValues();
+   Bool_t SetGridValuesFFT();
    void CheckKernelValidity();
    void SetUserCanonicalBandwidth();
    void SetUserKernelSigma2();
@@ -251,7 +257,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 2) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
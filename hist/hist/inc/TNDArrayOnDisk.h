@@ -0,0 +1,141 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TNDArrayOnDisk
+#define ROOT_TNDArrayOnDisk
+
+#include "TNDArray.h"
+#include "TBuffer.h"
+#include "TString.h"
+
+namespace ROOT {
+namespace Internal {
+struct TNDArrayOnDiskStore;
+}
+}
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TNDArrayOnDisk                                                       //
+//                                                                      //
+// N-Dim array class keeping its elements in a backing file.            //
+//                                                                      //
+// The elements are stored uncompressed in the backing file, in the     //
+// same layout as TNDArrayT. The file is split into chunks of           //
+// fChunkSize elements; at most fMaxResidentChunks of them are kept in  //
+// memory, the least recently used one is written back (if modified)    //
+// when another chunk is needed. Chunks that were never written read    //
+// as zero, so the backing file only grows as far as bins get filled.   //
+//                                                                      //
+// If no file name is given, a temporary file is created on first use   //
+// and removed when the array is destroyed. Writing the array stores    //
+// the chunks which are not all zero in its buffer, not the name of the //
+// backing file: an array read back (or cloned) uses its own temporary  //
+// backing file.                                                        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TNDArrayOnDisk: public TNDArray {
+public:
+   enum {
+      kDefaultChunkSize = 1 << 20, // elements per chunk
+      kDefaultMaxResidentChunks = 64
+   };
+
+   TNDArrayOnDisk();
+   TNDArrayOnDisk(Int_t ndim, const Int_t* nbins, bool addOverflow,
+                  Int_t elementSize, Long64_t chunkSize = kDefaultChunkSize,
+                  Int_t maxResidentChunks = kDefaultMaxResidentChunks,
+                  const char* fileName = 0);
+   ~TNDArrayOnDisk();
+
+   void Init(Int_t ndim, const Int_t* nbins, bool addOverflow = false);
+   void Reset(Option_t* option = "");
+
+   void Flush();
+   const char* GetFileName() const { return fFileName; }
+   Long64_t GetChunkSize() const { return fChunkSize; }
+   Int_t GetMaxResidentChunks() const { return fMaxResidentChunks; }
+   void SetMaxResidentChunks(Int_t n);
+
+protected:
+   /// Return a pointer to the element "linidx", loading its chunk if needed.
+   /// The chunk is marked as modified if "write" is set.
+   Char_t* GetElement(ULong64_t linidx, Bool_t write) const {
+      const Long64_t ichunk = linidx / fChunkSize;
+      if (ichunk != fCurrentChunk || (write && !fCurrentDirty))
+         LoadChunk(ichunk, write);
+      return fCurrentData + (linidx - ichunk * fChunkSize) * fElementSize;
+   }
+
+   /// Read or write the "n" elements at "data" with the type of the elements.
+   virtual void StreamElements(TBuffer& b, Char_t* data, Int_t n) = 0;
+
+private:
+   TNDArrayOnDisk(const TNDArrayOnDisk&); // intentionally not implemented
+   TNDArrayOnDisk& operator=(const TNDArrayOnDisk&); // intentionally not implemented
+
+   void LoadChunk(Long64_t ichunk, Bool_t write) const;
+   void OpenStore() const;
+   void CloseStore();
+   Long64_t GetChunkBytes(Long64_t ichunk) const;
+
+   Int_t    fElementSize;        // size of one element in bytes
+   Long64_t fChunkSize;          // number of elements per chunk
+   Int_t    fMaxResidentChunks;  // maximal number of chunks kept in memory
+   mutable TString fFileName;    //! name of the backing file
+   mutable Bool_t fKeepFile;     //! whether to keep the backing file on destruction
+
+   mutable ROOT::Internal::TNDArrayOnDiskStore* fStore; //! backing file and resident chunks
+   mutable Long64_t fCurrentChunk; //! index of the most recently used chunk
+   mutable Char_t*  fCurrentData;  //! elements of fCurrentChunk
+   mutable Bool_t   fCurrentDirty; //! whether fCurrentChunk is marked as modified
+
+   ClassDef(TNDArrayOnDisk, 3); // N-dimensional array in a backing file
+};
+
+template <typename T>
+class TNDArrayOnDiskT: public TNDArrayOnDisk {
+public:
+   TNDArrayOnDiskT() {}
+
+   TNDArrayOnDiskT(Int_t ndim, const Int_t* nbins, bool addOverflow = false,
+                   Long64_t chunkSize = kDefaultChunkSize,
+                   Int_t maxResidentChunks = kDefaultMaxResidentChunks,
+                   const char* fileName = 0):
+   TNDArrayOnDisk(ndim, nbins, addOverflow, sizeof(T), chunkSize,
+                  maxResidentChunks, fileName) {}
+
+   T At(ULong64_t linidx) const {
+      return *(const T*) GetElement(linidx, kFALSE);
+   }
+
+   Double_t AtAsDouble(ULong64_t linidx) const {
+      return *(const T*) GetElement(linidx, kFALSE);
+   }
+   void SetAsDouble(ULong64_t linidx, Double_t value) {
+      *(T*) GetElement(linidx, kTRUE) = (T) value;
+   }
+   void AddAt(ULong64_t linidx, Double_t value) {
+      *(T*) GetElement(linidx, kTRUE) += (T) value;
+   }
+
+protected:
+   void StreamElements(TBuffer& b, Char_t* data, Int_t n) {
+      if (b.IsReading())
+         b.ReadFastArray((T*) data, n);
+      else
+         b.WriteFastArray((T*) data, n);
+   }
+
+   ClassDef(TNDArrayOnDiskT, 2); // N-dimensional array in a backing file
+};
+
+#endif // ROOT_TNDArrayOnDisk
@@ -420,6 +420,50 @@ Int_t TAxis::FindFixBin(Double_t x) const
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers of the n values x[0], x[stride], ..., x[(n-1)*stride]
+/// and store them in bins[0], ..., bins[n-1].
+///
+/// The result is the same as calling FindFixBin(Double_t) for each value, but
+/// the loops do not branch on the value (the bin search in variable size
+/// axes has a fixed number of steps), so that the compiler can vectorize
+/// them. The axis is never extended. Used by the TH1::FillN methods.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   if (!fXbins.fN) {        //*-* fix bins
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i*stride];
+         const Bool_t under = xi < xmin;
+         const Bool_t over = !(xi < xmax);   // note the way to catch NaN
+         const Double_t xc = (under || over) ? xmin : xi;
+         const Int_t bin = 1 + int (nbins*(xc-xmin)/(xmax-xmin) );
+         bins[i] = under ? 0 : (over ? nbins+1 : bin);
+      }
+   } else {                  //*-* variable bin sizes
+      const Double_t *edges = fXbins.fArray;
+      const Int_t nedges = fXbins.fN;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i*stride];
+         const Bool_t under = xi < xmin;
+         const Bool_t over = !(xi < xmax);
+         const Double_t xc = (under || over) ? xmin : xi;
+         // last edge <= xc, as TMath::BinarySearch
+         const Double_t *base = edges;
+         for (Int_t len = nedges; len > 1; ) {
+            const Int_t half = len/2;
+            base = (base[half] <= xc) ? base + half : base;
+            len -= half;
+         }
+         const Int_t bin = 1 + Int_t(base - edges);
+         bins[i] = under ? 0 : (over ? nbins+1 : bin);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
@@ -0,0 +1,113 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TConcurrentEfficiency.h"
+#include "TEfficiency.h"
+#include "TH1.h"
+
+/** \class TConcurrentEfficiency
+    \ingroup Hist
+
+A TEfficiency that can be filled from many threads at the same time.
+
+The total and passed events are counted by two TConcurrentHist with the
+axes of the model efficiency, so that every thread only fills bin contents
+(in its own shard, or with atomic additions) instead of a full copy of the
+TEfficiency and its two histograms, as ROOT::TThreadedObject<TEfficiency>
+would need. Merge() returns a regular TEfficiency with the statistic options
+of the model:
+~~~{.cpp}
+TEfficiency model("eff", "efficiency;x;y;#epsilon", 100, 0., 1., 100, 0., 1.);
+TConcurrentEfficiency ce(model);
+// in each thread
+ce.Fill(passed, x, y);
+// afterwards
+std::unique_ptr<TEfficiency> eff(ce.Merge());
+~~~
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a concurrent efficiency with the axes and the statistic options of model.
+///
+/// \param model efficiency providing the axes and options. Its events are not copied.
+/// \param storage storage of the bin contents, see TConcurrentHist::EStorage
+/// \param nshards number of shards; the default (0) is the number of hardware threads
+
+TConcurrentEfficiency::TConcurrentEfficiency(const TEfficiency &model, TConcurrentHist::EStorage storage,
+                                             UInt_t nshards)
+   : fModel(new TEfficiency(model)), fTotal(*model.GetTotalHistogram(), storage, nshards),
+     fPassed(*model.GetPassedHistogram(), storage, nshards), fWeighted(model.UsesWeights())
+{
+   // the copy constructor marks the name and title as a copy
+   fModel->SetName(model.GetName());
+   fModel->TNamed::SetTitle(model.GetTitle());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TConcurrentEfficiency::~TConcurrentEfficiency()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an event at (x, y, z); the passed histogram is filled only if passed
+/// is true, see TEfficiency::Fill. Can be called concurrently.
+
+void TConcurrentEfficiency::Fill(Bool_t passed, Double_t x, Double_t y, Double_t z)
+{
+   const Double_t v[3] = {x, y, z};
+   fTotal.Fill(v);
+   if (passed)
+      fPassed.Fill(v);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an event at (x, y, z) with a weight, see TEfficiency::FillWeighted.
+/// Can be called concurrently.
+
+void TConcurrentEfficiency::FillWeighted(Bool_t passed, Double_t weight, Double_t x, Double_t y, Double_t z)
+{
+   if (!fWeighted.load(std::memory_order_relaxed))
+      fWeighted = true;
+   const Double_t v[3] = {x, y, z};
+   fTotal.Fill(v, weight);
+   if (passed)
+      fPassed.Fill(v, weight);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new TEfficiency holding all events filled so far, with the statistic
+/// options of the model. It is owned by the caller and not attached to any
+/// directory.
+
+TEfficiency *TConcurrentEfficiency::Merge(const char *name) const
+{
+   std::unique_ptr<TH1> total(fTotal.Merge());
+   std::unique_ptr<TH1> passed(fPassed.Merge());
+   TEfficiency *eff = new TEfficiency(*fModel);
+   eff->SetTotalHistogram(*total, "f");
+   eff->SetPassedHistogram(*passed, "f");
+   if (fWeighted && !eff->UsesWeights())
+      eff->SetUseWeightedEvents();
+   eff->SetName(name ? name : fModel->GetName());
+   eff->TNamed::SetTitle(fModel->GetTitle());
+   return eff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the contents. Must not be called while other threads fill.
+
+void TConcurrentEfficiency::Reset()
+{
+   fTotal.Reset();
+   fPassed.Reset();
+   fWeighted = fModel->UsesWeights();
+}
@@ -0,0 +1,482 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TConcurrentHist.h"
+#include "TH1.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
+#include "TClass.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/** \class TConcurrentHist
+    \ingroup Hist
+
+A histogram that can be filled from many threads at the same time.
+
+It takes the axes of a regular TH1, TH2 or TH3 (the "model") and offers two
+ways of storing the bin contents:
+
+  - kSharded: every thread fills one of several copies ("shards") of the bins,
+    allocated when the shard is first used. Each of the first GetNShards()
+    threads filling this object gets a shard of its own, which it fills
+    without any lock or atomic read-modify-write operation; further threads
+    share one more shard with atomic additions. The shards are only summed by
+    Merge(). This is the fastest mode when every thread fills many entries,
+    at the cost of one copy of the bins per shard.
+  - kAtomic: all threads fill a single copy of the bins with atomic
+    additions. The memory needed does not depend on the number of threads:
+    two arrays of doubles (four for profiles) besides the empty copy of the
+    model, which suits large 2-D or 3-D histograms with sparse updates.
+
+GetMemoryUsage() returns the memory used in both cases.
+Compared to ROOT::TThreadedObject<TH2D>, no histogram object is copied per
+thread and the result is always available through Merge(), which returns
+a regular histogram of the model's class for I/O and drawing:
+~~~{.cpp}
+TH2D model("h", "h", 1000, 0., 1., 1000, 0., 1.);
+TConcurrentHist ch(model, TConcurrentHist::kAtomic);
+// in each thread
+Double_t x[2] = {..., ...};
+ch.Fill(x, w);
+// afterwards
+std::unique_ptr<TH1> h(ch.Merge());
+~~~
+The statistics (sum of weights, moments) are accumulated per shard in both
+modes, exactly as TH1::Fill would do. The axes of the model are never
+extended.
+
+The model can also be a TProfile or a TProfile2D. The profiled value is then
+given after the coordinates, as for TProfile::Fill(const Double_t*): each
+shard only holds the four sums of a profile bin (weighted values, weighted
+squared values, weights and squared weights), so that it is much smaller
+than a copy of the profile per thread. TProfile3D and TH2Poly are not
+supported: the object is then not valid, see IsValid(), and refuses fills.
+*/
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically add w to a.
+
+inline void AtomicAdd(std::atomic<Double_t> &a, Double_t w)
+{
+   Double_t old = a.load(std::memory_order_relaxed);
+   while (!a.compare_exchange_weak(old, old + w, std::memory_order_relaxed))
+      ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add w to a, atomically if other threads may add to it at the same time.
+/// Otherwise the addition is a plain load and store, which only prevents
+/// concurrent readers from seeing a torn value.
+
+inline void Add(std::atomic<Double_t> &a, Double_t w, Bool_t shared)
+{
+   if (shared)
+      AtomicAdd(a, w);
+   else
+      a.store(a.load(std::memory_order_relaxed) + w, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes of the bin contents of a histogram.
+
+ULong64_t GetContentBytes(const TH1 &h)
+{
+   const Int_t n = h.GetNcells();
+   if (dynamic_cast<const TArrayD *>(&h))
+      return n * sizeof(Double_t);
+   if (dynamic_cast<const TArrayF *>(&h))
+      return n * sizeof(Float_t);
+   if (dynamic_cast<const TArrayI *>(&h))
+      return n * sizeof(Int_t);
+   if (dynamic_cast<const TArrayS *>(&h))
+      return n * sizeof(Short_t);
+   if (dynamic_cast<const TArrayC *>(&h))
+      return n * sizeof(Char_t);
+   return 0;
+}
+
+std::atomic<ULong64_t> gNextId(1);
+
+} // namespace
+
+/// Bins and statistics filled by one thread, or by all threads beyond the
+/// number of shards
+struct TConcurrentHist::Shard {
+   std::atomic<std::atomic<Double_t> *> fBins; ///< Sums of the bins, fNsums per bin, null until the first fill (kSharded only)
+   std::atomic<Double_t> fStats[TH1::kNstat];
+   std::atomic<Double_t> fEntries;
+   const Bool_t fShared;           ///< Whether several threads fill this shard
+   char fPadding[64];              ///< Keeps the shards on distinct cache lines
+
+   Shard(Bool_t shared) : fBins(nullptr), fEntries(0), fShared(shared)
+   {
+      for (auto &stat : fStats)
+         stat.store(0, std::memory_order_relaxed);
+   }
+   ~Shard() { delete[] fBins.load(); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a concurrent histogram with the axes of model.
+///
+/// \param model a TH1, TH2, TH3, TProfile or TProfile2D providing the axes. Its contents are not copied.
+/// \param storage storage of the bin contents, see EStorage
+/// \param nshards number of shards; the default (0) is the number of hardware threads
+
+TConcurrentHist::TConcurrentHist(const TH1 &model, EStorage storage, UInt_t nshards)
+   : fStorage(storage), fDimension(model.GetDimension()), fNcells(0), fNsums(2), fValid(kTRUE), fProfile(kFALSE),
+     fVmin(0), fVmax(0), fStatOverflows(kFALSE), fId(gNextId++), fNextShard(0), fWeighted(false)
+{
+   fModel.reset((TH1 *)model.Clone());
+   fModel->SetDirectory(nullptr);
+   fModel->Reset();
+   if (model.InheritsFrom("TProfile3D") || model.InheritsFrom("TH2Poly")) {
+      Error("TConcurrentHist", "%s is not supported as model, the histogram cannot be filled",
+            model.IsA()->GetName());
+      fValid = kFALSE;
+      return;
+   }
+
+   fModel->SetCanExtend(TH1::kNoAxis);
+   fNcells = fModel->GetNcells();
+   fStatOverflows = fModel->GetStatOverflowsBehaviour();
+   if (auto p = dynamic_cast<const TProfile *>(fModel.get())) {
+      fProfile = kTRUE;
+      fVmin = p->GetYmin();
+      fVmax = p->GetYmax();
+   } else if (auto p2 = dynamic_cast<const TProfile2D *>(fModel.get())) {
+      fProfile = kTRUE;
+      fVmin = p2->GetZmin();
+      fVmax = p2->GetZmax();
+   }
+   if (fProfile)
+      fNsums = 4;
+   fWeighted = IsModelWeighted();
+
+   if (!nshards)
+      nshards = std::max(1U, std::thread::hardware_concurrency());
+   for (UInt_t i = 0; i < nshards; ++i)
+      fShards.emplace_back(new Shard(kFALSE));
+   fShards.emplace_back(new Shard(kTRUE));
+
+   if (fStorage == kAtomic) {
+      fBins.reset(new std::atomic<Double_t>[fNsums * fNcells]);
+      for (Int_t i = 0; i < fNsums * fNcells; ++i)
+         fBins[i].store(0., std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+TConcurrentHist::~TConcurrentHist()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the model stores the sum of squares of weights: in fSumw2 for
+/// histograms, in the bin sum of squares of weights for profiles.
+
+Bool_t TConcurrentHist::IsModelWeighted() const
+{
+   if (auto p = dynamic_cast<const TProfile *>(fModel.get()))
+      return p->GetBinSumw2()->fN > 0;
+   if (auto p2 = dynamic_cast<const TProfile2D *>(fModel.get()))
+      return p2->GetBinSumw2()->fN > 0;
+   return fModel->GetSumw2N() > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shard of the calling thread.
+///
+/// Every thread remembers the shards it got from the last TConcurrentHist it
+/// filled. The exclusive shards are handed out in turn and never twice, so a
+/// thread that has forgotten its shard gets another one, or the shared one.
+
+TConcurrentHist::Shard &TConcurrentHist::GetShard()
+{
+   struct TAssignment {
+      ULong64_t fId;    // identifier of the TConcurrentHist
+      UInt_t    fShard; // index of the shard of the thread
+   };
+   static const size_t kMaxAssignments = 64;
+   thread_local TAssignment tLast{0, 0};
+   thread_local std::vector<TAssignment> tAssignments;
+
+   if (tLast.fId != fId) {
+      auto iter = std::find_if(tAssignments.begin(), tAssignments.end(),
+                               [this](const TAssignment &a) { return a.fId == fId; });
+      if (iter == tAssignments.end()) {
+         const UInt_t shared = fShards.size() - 1;
+         UInt_t index = fNextShard.load(std::memory_order_relaxed);
+         while (index < shared && !fNextShard.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+            ;
+         if (tAssignments.size() == kMaxAssignments)
+            tAssignments.erase(tAssignments.begin());
+         tAssignments.push_back({fId, std::min(index, shared)});
+         iter = tAssignments.end() - 1;
+      }
+      tLast = *iter;
+   }
+   return *fShards[tLast.fShard];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the bins of shard if no other thread did it in the meantime, and
+/// return them.
+
+std::atomic<Double_t> *TConcurrentHist::AllocateBins(Shard &shard)
+{
+   std::atomic<Double_t> *bins = new std::atomic<Double_t>[fNsums * fNcells];
+   for (Int_t i = 0; i < fNsums * fNcells; ++i)
+      bins[i].store(0., std::memory_order_relaxed);
+   std::atomic<Double_t> *expected = nullptr;
+   if (!shard.fBins.compare_exchange_strong(expected, bins, std::memory_order_acq_rel)) {
+      delete[] bins;
+      return expected;
+   }
+   return bins;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 1-D histogram with x and weight w. Can be called concurrently.
+/// Return the global bin number, or -1 if the histogram is not 1-D or is a profile.
+
+Int_t TConcurrentHist::Fill(Double_t x, Double_t w)
+{
+   if (fProfile) {
+      Error("Fill", "the histogram is a profile, use Fill(const Double_t*, Double_t)");
+      return -1;
+   }
+   if (fDimension != 1) {
+      Error("Fill", "the histogram has %d dimensions, use Fill(const Double_t*, Double_t)", fDimension);
+      return -1;
+   }
+   return Fill(&x, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with the coordinates x[0..GetDimension()-1] and weight w.
+/// For profiles, x[GetDimension()] is the profiled value.
+/// Can be called concurrently. Return the global bin number, or -1 if the
+/// profiled value is outside the limits of the profile or the histogram is
+/// not valid.
+
+Int_t TConcurrentHist::Fill(const Double_t *x, Double_t w)
+{
+   if (!fValid)
+      return -1;
+   // the value w enters the bin contents, multiplied by the profiled value v
+   Double_t v = 1.;
+   if (fProfile) {
+      v = x[fDimension];
+      if (fVmin != fVmax && (v < fVmin || v > fVmax || std::isnan(v)))
+         return -1;
+   }
+   const TAxis *xaxis = fModel->GetXaxis();
+   const Int_t nx = xaxis->GetNbins();
+   const Int_t binx = xaxis->FindFixBin(x[0]);
+   Bool_t inRange = binx > 0 && binx <= nx;
+   Int_t bin = binx;
+   if (fDimension > 1) {
+      const TAxis *yaxis = fModel->GetYaxis();
+      const Int_t ny = yaxis->GetNbins();
+      const Int_t biny = yaxis->FindFixBin(x[1]);
+      inRange &= biny > 0 && biny <= ny;
+      Int_t binz = 0;
+      if (fDimension > 2) {
+         const TAxis *zaxis = fModel->GetZaxis();
+         binz = zaxis->FindFixBin(x[2]);
+         inRange &= binz > 0 && binz <= zaxis->GetNbins();
+      }
+      bin = binx + (nx + 2) * (biny + (ny + 2) * binz);
+   }
+
+   if (w != 1. && !fWeighted.load(std::memory_order_relaxed))
+      fWeighted = true;
+   Shard &shard = GetShard();
+   const Bool_t shared = shard.fShared;
+   std::atomic<Double_t> *sums;
+   if (fStorage == kAtomic) {
+      sums = fBins.get() + bin * fNsums;
+      AtomicAdd(sums[0], w * v);
+      AtomicAdd(sums[1], fProfile ? w * v * v : w * w);
+      if (fProfile) {
+         AtomicAdd(sums[2], w);
+         AtomicAdd(sums[3], w * w);
+      }
+   } else {
+      sums = shard.fBins.load(std::memory_order_acquire);
+      if (!sums)
+         sums = AllocateBins(shard);
+      sums += bin * fNsums;
+      Add(sums[0], w * v, shared);
+      Add(sums[1], fProfile ? w * v * v : w * w, shared);
+      if (fProfile) {
+         Add(sums[2], w, shared);
+         Add(sums[3], w * w, shared);
+      }
+   }
+   Add(shard.fEntries, 1., shared);
+   if (!inRange && !fStatOverflows)
+      return bin;
+
+   std::atomic<Double_t> *s = shard.fStats;
+   Add(s[0], w, shared);
+   Add(s[1], w * w, shared);
+   Add(s[2], w * x[0], shared);
+   Add(s[3], w * x[0] * x[0], shared);
+   if (fDimension > 1) {
+      Add(s[4], w * x[1], shared);
+      Add(s[5], w * x[1] * x[1], shared);
+      Add(s[6], w * x[0] * x[1], shared);
+   }
+   if (fDimension > 2) {
+      Add(s[7], w * x[2], shared);
+      Add(s[8], w * x[2] * x[2], shared);
+      Add(s[9], w * x[0] * x[2], shared);
+      Add(s[10], w * x[1] * x[2], shared);
+   }
+   if (fProfile) {
+      // sums of the profiled values follow the ones of the coordinates
+      const Int_t iv = (fDimension == 1) ? 4 : 7;
+      Add(s[iv], w * v, shared);
+      Add(s[iv + 1], w * v * v, shared);
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries filled so far.
+
+Double_t TConcurrentHist::GetEntries() const
+{
+   Double_t entries = 0;
+   for (auto &shard : fShards)
+      entries += shard->fEntries.load(std::memory_order_relaxed);
+   return entries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes used by this object: the empty copy of the
+/// model, the shards and, for kAtomic, the bins filled with atomic additions.
+
+ULong64_t TConcurrentHist::GetMemoryUsage() const
+{
+   ULong64_t bytes = sizeof(*this) + fModel->IsA()->Size() + GetContentBytes(*fModel);
+   bytes += fModel->GetSumw2()->GetSize() * sizeof(Double_t);
+   if (auto p = dynamic_cast<const TProfile *>(fModel.get()))
+      bytes += (fNcells + p->GetBinSumw2()->GetSize()) * sizeof(Double_t);
+   else if (auto p2 = dynamic_cast<const TProfile2D *>(fModel.get()))
+      bytes += (fNcells + p2->GetBinSumw2()->GetSize()) * sizeof(Double_t);
+
+   const ULong64_t binBytes = fNsums * fNcells * sizeof(std::atomic<Double_t>);
+   if (fBins)
+      bytes += binBytes;
+   for (auto &shard : fShards) {
+      bytes += sizeof(Shard);
+      if (shard->fBins.load(std::memory_order_acquire))
+         bytes += binBytes;
+   }
+   return bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new histogram of the model's class holding the sum of all fills,
+/// or nullptr if the histogram is not valid.
+/// The histogram is owned by the caller and not attached to any directory.
+/// Can be called while other threads fill; the fills in progress are then only
+/// partly included.
+
+TH1 *TConcurrentHist::Merge(const char *name) const
+{
+   if (!fValid)
+      return nullptr;
+   std::vector<Double_t> sums(fNsums * fNcells);
+   Double_t stats[TH1::kNstat] = {};
+   Double_t entries = 0;
+   auto addBins = [&sums](const std::atomic<Double_t> *bins) {
+      for (size_t i = 0; i < sums.size(); ++i)
+         sums[i] += bins[i].load(std::memory_order_relaxed);
+   };
+   for (auto &shard : fShards) {
+      if (auto bins = shard->fBins.load(std::memory_order_acquire))
+         addBins(bins);
+      for (Int_t i = 0; i < TH1::kNstat; ++i)
+         stats[i] += shard->fStats[i].load(std::memory_order_relaxed);
+      entries += shard->fEntries.load(std::memory_order_relaxed);
+   }
+   if (fStorage == kAtomic)
+      addBins(fBins.get());
+
+   TH1 *h = (TH1 *)fModel->Clone(name ? name : fModel->GetName());
+   h->SetDirectory(nullptr);
+   if (fProfile) {
+      // the bin entries and their squared weights are only reachable through the
+      // concrete profile class
+      TArrayD *hBinSumw2 = nullptr;
+      if (auto p = dynamic_cast<TProfile *>(h)) {
+         if (fWeighted && !p->GetBinSumw2()->fN)
+            p->Sumw2();
+         for (Int_t bin = 0; bin < fNcells; ++bin)
+            p->SetBinEntries(bin, sums[bin * fNsums + 2]);
+         hBinSumw2 = p->GetBinSumw2();
+      } else if (auto p2 = dynamic_cast<TProfile2D *>(h)) {
+         if (fWeighted && !p2->GetBinSumw2()->fN)
+            p2->Sumw2();
+         for (Int_t bin = 0; bin < fNcells; ++bin)
+            p2->SetBinEntries(bin, sums[bin * fNsums + 2]);
+         hBinSumw2 = p2->GetBinSumw2();
+      }
+      if (hBinSumw2 && hBinSumw2->fN) {
+         for (Int_t bin = 0; bin < fNcells; ++bin)
+            hBinSumw2->fArray[bin] = sums[bin * fNsums + 3];
+      }
+   } else if (fWeighted && !h->GetSumw2N()) {
+      h->Sumw2();
+   }
+   for (Int_t bin = 0; bin < fNcells; ++bin)
+      h->SetBinContent(bin, sums[bin * fNsums]);
+   if (h->GetSumw2N()) {
+      Double_t *sumw2 = h->GetSumw2()->GetArray();
+      for (Int_t bin = 0; bin < fNcells; ++bin)
+         sumw2[bin] = sums[bin * fNsums + 1];
+   }
+   h->PutStats(stats);
+   h->SetEntries(entries);
+   return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the contents. Must not be called while other threads fill.
+
+void TConcurrentHist::Reset()
+{
+   for (auto &shard : fShards) {
+      delete[] shard->fBins.exchange(nullptr);
+      for (auto &stat : shard->fStats)
+         stat.store(0., std::memory_order_relaxed);
+      shard->fEntries.store(0., std::memory_order_relaxed);
+   }
+   for (Int_t i = 0; fBins && i < fNsums * fNcells; ++i)
+      fBins[i].store(0., std::memory_order_relaxed);
+   fWeighted = IsModelWeighted();
+}
@@ -2,6 +2,7 @@
 #define ROOT_TEfficiency_cxx
 
 //standard header
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -169,6 +170,11 @@ Begin_Macro(source)
 }
 End_Macro
 
+Events which are available as arrays are filled faster with
+TEfficiency::FillN(Int_t n,const Bool_t* passed,const Double_t* x,const Double_t* y,const Double_t* z,const Double_t* w),
+which finds the bin of each event only once for both histograms.
+To fill an efficiency from several threads, see TConcurrentEfficiency.
+
 You can also set the number of passed or total events for a bin directly by
 using the TEfficiency::SetPassedEvents or TEfficiency::SetTotalEvents method.
 
@@ -2300,6 +2306,124 @@ void TEfficiency::FillWeighted(Bool_t bPassed,Double_t weight,Double_t x,Double_
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// This function is used for filling the two histograms with n events at once.
+///
+/// \param[in] n number of events
+/// \param[in] passed flags whether the events passed the selection
+/// \param[in] x x-values
+/// \param[in] y y-values (can be null for 1-D efficiencies)
+/// \param[in] z z-values (can be null for 2-D or 1-D efficiencies)
+/// \param[in] w weights of the events; if null, the events are not weighted
+///
+/// This gives the same result as calling Fill (or FillWeighted if w is given)
+/// for each event, but the bin of each event is found only once, for both
+/// histograms, and the statistics of the histograms are updated once at the end.
+///
+/// Note: - this function will call SetUseWeightedEvents if weights are given and
+///         it was not called by the user before
+
+void TEfficiency::FillN(Int_t n,const Bool_t* passed,const Double_t* x,const Double_t* y,const Double_t* z,const Double_t* w)
+{
+   const Int_t dim = GetDimension();
+   if ((dim > 1 && !y) || (dim > 2 && !z)) {
+      Error("FillN","missing coordinates for a %d-dimensional efficiency",dim);
+      return;
+   }
+   if (w && !TestBit(kUseWeights))
+      SetUseWeightedEvents();
+
+   TH1* hists[2] = {fTotalHistogram, fPassedHistogram};
+
+   // the bins can only be found once for both histograms if no axis can change
+   // while filling; the statistics must not depend on an axis range
+   Bool_t direct = kTRUE;
+   for (TH1* h : hists) {
+      const TAxis* axes[3] = {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()};
+      direct &= !h->GetBuffer();
+      for (Int_t i = 0; i < dim; ++i)
+         direct &= !axes[i]->CanExtend() && !axes[i]->TestBit(TAxis::kAxisRange);
+   }
+   if (!direct) {
+      for (Int_t i = 0; i < n; ++i) {
+         Double_t yi = y ? y[i] : 0;
+         Double_t zi = z ? z[i] : 0;
+         if (w)
+            FillWeighted(passed[i],w[i],x[i],yi,zi);
+         else
+            Fill(passed[i],x[i],yi,zi);
+      }
+      return;
+   }
+
+   const TAxis* xaxis = fTotalHistogram->GetXaxis();
+   const TAxis* yaxis = fTotalHistogram->GetYaxis();
+   const TAxis* zaxis = fTotalHistogram->GetZaxis();
+   const Int_t nbinsx = xaxis->GetNbins();
+   const Int_t nbinsy = yaxis->GetNbins();
+   const Int_t nbinsz = zaxis->GetNbins();
+   const Bool_t statOverflows[2] = {fTotalHistogram->GetStatOverflowsBehaviour(),
+                                    fPassedHistogram->GetStatOverflowsBehaviour()};
+   // the statistics must be taken before the bins change: GetStats computes them
+   // from the bin contents if they are not available (e.g. after SetTotalEvents)
+   Double_t stats[2][TH1::kNstat] = {};
+   for (Int_t k = 0; k < 2; ++k)
+      hists[k]->GetStats(stats[k]);
+   Double_t entries[2] = {0, 0};
+   TArrayD* sumw2[2] = {fTotalHistogram->GetSumw2(), fPassedHistogram->GetSumw2()};
+
+   Int_t binsx[TH1::kNFillNChunk], binsy[TH1::kNFillNChunk], binsz[TH1::kNFillNChunk];
+   std::fill(binsy, binsy + TH1::kNFillNChunk, 0);
+   std::fill(binsz, binsz + TH1::kNFillNChunk, 0);
+   Double_t ww = 1;
+   for (Int_t first = 0; first < n; first += TH1::kNFillNChunk) {
+      const Int_t nchunk = TMath::Min(Int_t(TH1::kNFillNChunk), n - first);
+      xaxis->FindFixBins(nchunk, x + first, binsx);
+      if (dim > 1) yaxis->FindFixBins(nchunk, y + first, binsy);
+      if (dim > 2) zaxis->FindFixBins(nchunk, z + first, binsz);
+      for (Int_t i = 0; i < nchunk; ++i) {
+         const Int_t binx = binsx[i];
+         const Int_t biny = binsy[i];
+         const Int_t binz = binsz[i];
+         const Int_t bin = binx + (nbinsx + 2) * (biny + (nbinsy + 2) * binz);
+         const Bool_t inRange = binx > 0 && binx <= nbinsx && (dim < 2 || (biny > 0 && biny <= nbinsy)) &&
+                                (dim < 3 || (binz > 0 && binz <= nbinsz));
+         if (w) ww = w[first + i];
+         const Int_t nhists = passed[first + i] ? 2 : 1;
+         for (Int_t k = 0; k < nhists; ++k) {
+            hists[k]->AddBinContent(bin, ww);
+            if (sumw2[k]->fN) sumw2[k]->fArray[bin] += ww * ww;
+            entries[k]++;
+            if (!inRange && !statOverflows[k]) continue;
+            Double_t* s = stats[k];
+            const Double_t xi = x[first + i];
+            s[0] += ww;
+            s[1] += ww * ww;
+            s[2] += ww * xi;
+            s[3] += ww * xi * xi;
+            if (dim > 1) {
+               const Double_t yi = y[first + i];
+               s[4] += ww * yi;
+               s[5] += ww * yi * yi;
+               s[6] += ww * xi * yi;
+               if (dim > 2) {
+                  const Double_t zi = z[first + i];
+                  s[7] += ww * zi;
+                  s[8] += ww * zi * zi;
+                  s[9] += ww * xi * zi;
+                  s[10] += ww * yi * zi;
+               }
+            }
+         }
+      }
+   }
+
+   for (Int_t k = 0; k < 2; ++k) {
+      hists[k]->PutStats(stats[k]);
+      hists[k]->fEntries += entries[k];
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the global bin number containing the given values
 ///
@@ -2696,17 +2820,37 @@ TList* TEfficiency::GetListOfFunctions()
 Long64_t TEfficiency::Merge(TCollection* pList)
 {
    if(!pList->IsEmpty()) {
+      // the histograms of all objects are merged at once, and the new weight
+      // is computed once
+      TList totals;
+      TList passed;
+      Double_t invWeight = 0;
       TIter next(pList);
       TObject* obj = 0;
       TEfficiency* pEff = 0;
       while((obj = next())) {
          pEff = dynamic_cast<TEfficiency*>(obj);
-         if(pEff) {
+         if(!pEff)
+            continue;
+         if(fTotalHistogram && fPassedHistogram && pEff->fTotalHistogram && pEff->fPassedHistogram) {
+            totals.Add(pEff->fTotalHistogram);
+            passed.Add(pEff->fPassedHistogram);
+            invWeight += 1. / pEff->GetWeight();
+         }
+         else {
+            // empty or inconsistent objects are handled (or reported) by operator+=
             *this += *pEff;
          }
       }
+      if(!totals.IsEmpty()) {
+         fTotalHistogram->ResetBit(TH1::kIsAverage);
+         fPassedHistogram->ResetBit(TH1::kIsAverage);
+         fTotalHistogram->Merge(&totals);
+         fPassedHistogram->Merge(&passed);
+         SetWeight(1. / (1. / fWeight + invWeight));
+      }
    }
-   return (Long64_t)fTotalHistogram->GetEntries();
+   return (fTotalHistogram) ? (Long64_t)fTotalHistogram->GetEntries() : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +51,8 @@
 
 #include "AnalyticalIntegrals.h"
 
+#include <algorithm>
+
 std::atomic<Bool_t> TF1::fgAbsValue(kFALSE);
 Bool_t TF1::fgRejectPoint = kFALSE;
 std::atomic<Bool_t> TF1::fgAddToGlobList(kTRUE);
@@ -1425,6 +1427,29 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function at the n points x with parameters params (or the
+/// current parameters if params is null), storing the values in result.
+/// The coordinates of the points are stored one after the other, GetNdim()
+/// values each.
+/// Functions defined by a formula are evaluated in a single loop compiled
+/// together with the formula expression, see TFormula::EvalParBatch; all
+/// other functions are evaluated one point at a time with EvalPar().
+
+void TF1::EvalParBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *result)
+{
+   if (fType == EFType::kFormula && !fFormula->IsVectorized() && fFormula->GetNdim() == fNdim) {
+      fFormula->EvalParBatch(n, x, params, result);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            result[i] /= fNormIntegral;
+      }
+      return;
+   }
+   for (Int_t i = 0; i < n; ++i)
+      result[i] = EvalPar(x + i * fNdim, params);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2356,6 +2381,34 @@ void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
    GradientParTempl<Double_t>(x, grad, eps);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient wrt parameters by automatic differentiation of the
+/// formula, see TFormula::GradientPar.
+///
+/// \param x  point, were the gradient is computed
+/// \param grad  used to return the computed gradient, assumed to be of at least fNpar size
+///
+/// The derivatives are exact and cost about as much as one evaluation of the
+/// function, instead of two evaluations per parameter for GradientPar(). Contrary
+/// to GradientPar(), the derivative wrt a fixed parameter is not set to 0.
+///
+/// Returns kFALSE, leaving grad untouched, if the function is not defined by
+/// a formula, is normalized, or if the formula could not be differentiated
+/// (e.g. ROOT was built without clad); GradientPar() must then be used.
+
+Bool_t TF1::GradientParAD(const Double_t *x, Double_t *grad)
+{
+   if (fType != EFType::kFormula || fNormalized || fNpar == 0 || fFormula->IsVectorized() ||
+       fFormula->GetNdim() != fNdim)
+      return kFALSE;
+   if (!fFormula->GenerateGradientPar())
+      return kFALSE;
+   // The generated gradient accumulates into its result.
+   std::fill(grad, grad + fNpar, 0.);
+   fFormula->GradientPar(x, grad);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize parameters addresses.
 
@@ -167,6 +167,16 @@ Double_t TF12::EvalPar(const Double_t *x, const Double_t *params)
    return fF2->EvalPar(xx,params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this function at the n points x; see TF1::EvalParBatch.
+/// The points are evaluated one by one through the TF2.
+
+void TF12::EvalParBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *result)
+{
+   for (Int_t i = 0; i < n; ++i)
+      result[i] = EvalPar(x + i, params);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
@@ -665,6 +665,7 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fClingInput = fClingInput;
+   fnew.fClingBody = fClingBody;
    fnew.fReadyToExecute = fReadyToExecute;
    fnew.fClingInitialized = fClingInitialized;
    fnew.fAllParametersSetted = fAllParametersSetted;
@@ -700,7 +701,10 @@ void TFormula::Copy(TObject &obj) const
 
    fnew.fFuncPtr = fFuncPtr;
    fnew.fGradGenerationInput = fGradGenerationInput;
-   fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fGradFuncPtr = fGradFuncPtr.load();
+   fnew.fGradGenerationFailed = fGradGenerationFailed.load();
+   fnew.fBatchFuncPtr = fBatchFuncPtr.load();
+   fnew.fBatchFuncFor = fBatchFuncFor.load();
 
 }
 
@@ -2294,8 +2298,9 @@ void TFormula::ProcessFormula(TString &formula)
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu", gNamePrefix.Data(), hasher(inputFormulaVecFlag));
 
+         fClingBody = inputFormula.c_str();
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
-                                       argumentsPrototype.Data(), inputFormula.c_str());
+                                       argumentsPrototype.Data(), fClingBody.Data());
 
 
          // std::cout << "Input Formula " << inputFormula << " \t vec formula  :  " << inputFormulaVecFlag << std::endl;
@@ -3070,6 +3075,7 @@ void TFormula::SetVectorized(Bool_t vectorized)
       fReadyToExecute = false;
       fClingName = "";
       fClingInput = fFormula;
+      fClingBody = "";
 
       if (fMethod)
          fMethod->Delete();
@@ -3136,46 +3142,58 @@ static bool functionExists(const string &Name) {
 }
 
 /// returns true on success.
+/// Can be called concurrently: the gradient is generated by the first caller,
+/// the other callers only take a lock while it is being generated.
 bool TFormula::GenerateGradientPar()
 {
-   // We already have generated the gradient.
-   if (fGradMethod)
+   // We already have generated the gradient, or failed to.
+   if (fGradFuncPtr.load(std::memory_order_acquire))
       return true;
+   if (HasGradientGenerationFailed())
+      return false;
 
-   if (!HasGradientGenerationFailed()) {
-      // FIXME: Move this elsewhere
-      if (!TFormula::fIsCladRuntimeIncluded) {
-         TFormula::fIsCladRuntimeIncluded = true;
-         gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
-      }
+   R__LOCKGUARD(gROOTMutex);
+   if (fGradMethod || HasGradientGenerationFailed())
+      return fGradFuncPtr.load(std::memory_order_relaxed) != nullptr;
+
+   // FIXME: Move this elsewhere
+   if (!TFormula::fIsCladRuntimeIncluded) {
+      TFormula::fIsCladRuntimeIncluded = true;
+      gInterpreter->Declare("#include <Math/CladDerivator.h>\n#pragma clad OFF");
+   }
 
-      // Check if the gradient request was made as part of another TFormula.
-      // This can happen when we create multiple TFormula objects with the same
-      // formula. In that case, the hasher will give identical id and we can
-      // reuse the already generated gradient function.
-      if (!functionExists(GetGradientFuncName())) {
-         std::string GradReqFuncName = GetGradientFuncName() + "_req";
-         // We want to call clad::differentiate(TFormula_id);
-         fGradGenerationInput = std::string("#pragma cling optimize(2)\n") +
-            "#pragma clad ON\n" +
-            "void " + GradReqFuncName + "() {\n" +
-            "clad::gradient(" + std::string(fClingName.Data()) + ");\n }\n" +
-            "#pragma clad OFF";
+   // Check if the gradient request was made as part of another TFormula.
+   // This can happen when we create multiple TFormula objects with the same
+   // formula. In that case, the hasher will give identical id and we can
+   // reuse the already generated gradient function.
+   if (!functionExists(GetGradientFuncName())) {
+      std::string GradReqFuncName = GetGradientFuncName() + "_req";
+      // We want to call clad::differentiate(TFormula_id);
+      fGradGenerationInput = std::string("#pragma cling optimize(2)\n") +
+         "#pragma clad ON\n" +
+         "void " + GradReqFuncName + "() {\n" +
+         "clad::gradient(" + std::string(fClingName.Data()) + ");\n }\n" +
+         "#pragma clad OFF";
 
-         if (!gInterpreter->Declare(fGradGenerationInput.c_str()))
-            return false;
+      if (!gInterpreter->Declare(fGradGenerationInput.c_str())) {
+         fGradGenerationFailed.store(true, std::memory_order_release);
+         return false;
       }
+   }
 
-      Bool_t hasParameters = (fNpar > 0);
-      Bool_t hasVariables = (fNdim > 0);
-      std::string GradFuncName = GetGradientFuncName();
-      fGradMethod = prepareMethod(hasParameters, hasVariables,
-                                  GradFuncName.c_str(),
-                                  fVectorized, /*IsGradient*/ true);
-      fGradFuncPtr = prepareFuncPtr(fGradMethod.get());
-      return true;
+   Bool_t hasParameters = (fNpar > 0);
+   Bool_t hasVariables = (fNdim > 0);
+   std::string GradFuncName = GetGradientFuncName();
+   fGradMethod = prepareMethod(hasParameters, hasVariables, GradFuncName.c_str(),
+                               fVectorized, /*IsGradient*/ true);
+   // Publish the pointer or the failure last, they are checked without lock above.
+   CallFuncSignature gradFuncPtr = prepareFuncPtr(fGradMethod.get());
+   if (!gradFuncPtr) {
+      fGradGenerationFailed.store(true, std::memory_order_release);
+      return false;
    }
-   return false;
+   fGradFuncPtr.store(gradFuncPtr, std::memory_order_release);
+   return true;
 }
 
 void TFormula::GradientPar(const Double_t *x, TFormula::GradientStorage& result)
@@ -3205,6 +3223,7 @@ void TFormula::GradientPar(const Double_t *x, TFormula::GradientStorage& result)
 
 void TFormula::GradientPar(const Double_t *x, Double_t *result)
 {
+   CallFuncSignature gradFuncPtr = fGradFuncPtr.load(std::memory_order_acquire);
    void* args[3];
    const double * vars = (x) ? x : fClingVariables.data();
    args[0] = &vars;
@@ -3220,7 +3239,7 @@ void TFormula::GradientPar(const Double_t *x, Double_t *result)
       //    }
       // }
       args[1] = &result;
-      (*fGradFuncPtr)(0, 2, args, /*ret*/nullptr); // We do not use ret in a return-void func.
+      (*gradFuncPtr)(0, 2, args, /*ret*/nullptr); // We do not use ret in a return-void func.
    } else {
       // __attribute__((used)) extern "C" void __cf_0(void* obj, int nargs, void** args, void* ret)
       // {
@@ -3232,8 +3251,75 @@ void TFormula::GradientPar(const Double_t *x, Double_t *result)
       const double *pars = fClingParameters.data();
       args[1] = &pars;
       args[2] = &result;
-      (*fGradFuncPtr)(0, 3, args, /*ret*/nullptr); // We do not use ret in a return-void func.
+      (*gradFuncPtr)(0, 3, args, /*ret*/nullptr); // We do not use ret in a return-void func.
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare to Cling a function evaluating the formula expression in a loop over
+/// many points, compiled with optimization so that the compiler can inline and
+/// vectorize the expression. Returns the address of the function, or null if
+/// the formula cannot be evaluated in such a loop; in that case EvalParBatch()
+/// evaluates the points one by one.
+
+TFormula::BatchFuncSignature TFormula::GenerateBatchEval() const
+{
+   if (!fClingInitialized || fVectorized || TestBit(TFormula::kLambda) || fNdim <= 0 || fClingBody.IsNull())
+      return nullptr;
+
+   // the same processed expression as returned by the function declared from fClingInput
+   const std::string expression = fClingBody.Data();
+
+   // identical formulas share the same Cling name and thus the batch function
+   std::string batchName = std::string(fClingName.Data()) + "_batch";
+   if (!functionExists(batchName)) {
+      std::string batchInput = "#pragma cling optimize(2)\n"
+                               "void " + batchName + "(Int_t n, Double_t *x, Double_t *p, Double_t *result) {\n"
+                               "   for (Int_t i = 0; i < n; ++i, x += " + std::to_string(fNdim) + ")\n"
+                               "      result[i] = " + expression + ";\n"
+                               "}";
+      if (!gInterpreter->Declare(batchInput.c_str()))
+         return nullptr;
    }
+
+   TInterpreter::EErrorCode error = TInterpreter::kNoError;
+   Long_t address = gInterpreter->Calc(("(Long_t)&" + batchName).c_str(), &error);
+   return error == TInterpreter::kNoError ? (BatchFuncSignature) address : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at the n points x with parameters params (or the
+/// current parameters if params is null), storing the values in result.
+/// The coordinates of the points are stored one after the other, GetNdim()
+/// values each.
+/// The points are evaluated in a single loop that is compiled together with
+/// the formula expression, avoiding the per-point call overhead of EvalPar().
+/// Can be called concurrently: the loop is compiled by the first caller.
+
+void TFormula::EvalParBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *result) const
+{
+   const CallFuncSignature funcPtr = fFuncPtr;
+   if (fBatchFuncFor.load(std::memory_order_acquire) != funcPtr && fClingInitialized) {
+      R__LOCKGUARD(gROOTMutex);
+      if (fBatchFuncFor.load(std::memory_order_relaxed) != funcPtr) {
+         // Publish fBatchFuncFor last, it is checked without lock.
+         TFormula *self = const_cast<TFormula *>(this);
+         self->fBatchFuncPtr.store(GenerateBatchEval(), std::memory_order_relaxed);
+         self->fBatchFuncFor.store(funcPtr, std::memory_order_release);
+      }
+   }
+
+   BatchFuncSignature batchFuncPtr = nullptr;
+   if (fBatchFuncFor.load(std::memory_order_acquire) == funcPtr)
+      batchFuncPtr = fBatchFuncPtr.load(std::memory_order_relaxed);
+   if (!batchFuncPtr) {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] = EvalPar(x + i * fNdim, params);
+      return;
+   }
+
+   double *pars = (params) ? const_cast<double *>(params) : const_cast<double *>(fClingParameters.data());
+   batchFuncPtr(n, const_cast<Double_t *>(x), pars, result);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3579,7 +3665,7 @@ void TFormula::Print(Option_t *option) const
       }
       printf("Expression passed to Cling:\n");
       printf("\t%s\n",fClingInput.Data() );
-      if (fGradFuncPtr) {
+      if (HasGeneratedGradient()) {
          printf("Generated Gradient:\n");
          printf("%s\n", fGradGenerationInput.c_str());
          printf("%s\n", GetGradientFormula().Data());
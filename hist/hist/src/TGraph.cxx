@@ -35,6 +35,8 @@
 #include <stdlib.h>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -847,6 +849,43 @@ void TGraph::DrawPanel()
    if (painter) painter->DrawPanelHelper(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// What Eval found about the points of the graph. It is immutable once
+/// published: a new one replaces it when the points change or when the spline
+/// is needed, and the previous one is freed when no Eval uses it anymore.
+
+struct TGraph::TEvalCache {
+   enum EState {
+      kUnsorted    = 0, ///< X points are not sorted
+      kSorted      = 1, ///< X points are sorted
+      kEquidistant = 2  ///< X points are sorted and equidistant
+   };
+
+   const Double_t *fX = nullptr;       ///< Array of X points the cache was computed for
+   const Double_t *fY = nullptr;       ///< Array of Y points the cache was computed for
+   Int_t fNpoints = 0;                 ///< Number of points the cache was computed for
+   ULong64_t fChecksum = 0;            ///< Checksum of the values of the points
+   Int_t fState = kUnsorted;           ///< Order of the X points
+   Double_t fDelta = 0;                ///< Distance between equidistant X points
+   std::shared_ptr<TSpline3> fSpline;  ///< Spline for option "S", if it was requested
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Checksum of the n points (x, y), sensitive to their values and order.
+
+static ULong64_t EvalChecksum(Int_t n, const Double_t *x, const Double_t *y)
+{
+   ULong64_t sum1 = 0, sum2 = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      ULong64_t bx, by;
+      memcpy(&bx, x + i, sizeof(bx));
+      memcpy(&by, y + i, sizeof(by));
+      sum1 += bx ^ (by * 0x9E3779B97F4A7C15ULL);
+      sum2 += sum1;
+   }
+   return sum1 ^ (sum2 * 0xC2B2AE3D27D4EB4FULL);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interpolate points in this graph at x using a TSpline.
 ///
@@ -855,12 +894,18 @@ void TGraph::DrawPanel()
 ///    extrapolation is computed.
 ///  - if spline==0 and option="S" a TSpline3 object is created using this graph
 ///    and the interpolated value from the spline is returned.
-///    the internally created spline is deleted on return.
+///    The spline is kept and reused by the following calls as long as the
+///    points do not change.
 ///  - if spline is specified, it is used to return the interpolated value.
 ///
-///   If the points are sorted in X a binary search is used (significantly faster)
-///   One needs to set the bit  TGraph::SetBit(TGraph::kIsSortedX) before calling
-///   TGraph::Eval to indicate that the graph is sorted in X.
+///   The first call checks whether the points are sorted in X; in that case a
+///   binary search is used (significantly faster), and if the points are also
+///   equidistant the interval containing x is computed directly.
+///   One can also set the bit TGraph::SetBit(TGraph::kIsSortedX) to indicate
+///   that the graph is sorted in X.
+///   What is kept between calls is checked against the arrays, the number of
+///   points and a checksum of their values: it is recomputed whenever the points
+///   change, including through the arrays returned by GetX() and GetY().
 
 Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
 {
@@ -876,33 +921,57 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    if (option && *option) {
       TString opt = option;
       opt.ToLower();
-      // create a TSpline every time when using option "s" and no spline pointer is given
+      // use the spline created at the first call with option "s"
       if (opt.Contains("s")) {
+         return GetEvalCache(kTRUE)->fSpline->Eval(x);
+      }
+   }
+   return EvalLinear(x, *GetEvalCache(kFALSE));
+}
 
-         // points must be sorted before using a TSpline
-         std::vector<Double_t> xsort(fNpoints);
-         std::vector<Double_t> ysort(fNpoints);
-         std::vector<Int_t> indxsort(fNpoints);
-         TMath::Sort(fNpoints, fX, &indxsort[0], false);
-         for (Int_t i = 0; i < fNpoints; ++i) {
-            xsort[i] = fX[ indxsort[i] ];
-            ysort[i] = fY[ indxsort[i] ];
-         }
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate points in this graph at the n points x, storing the results in y.
+/// See Eval(Double_t, TSpline*, Option_t*) for the options; this is faster than
+/// calling Eval for each point since the option is interpreted only once.
 
-         // spline interpolation creating a new spline
-         TSpline3 s("", &xsort[0], &ysort[0], fNpoints);
-         Double_t result = s.Eval(x);
-         return result;
-      }
+void TGraph::EvalN(Int_t n, const Double_t *x, Double_t *y, Option_t *option) const
+{
+   if (fNpoints <= 1) {
+      std::fill(y, y + n, fNpoints ? fY[0] : 0.);
+      return;
    }
-   //linear interpolation
+   TString opt = option;
+   opt.ToLower();
+   std::shared_ptr<const TEvalCache> cache = GetEvalCache(opt.Contains("s"));
+   if (cache->fSpline) {
+      for (Int_t i = 0; i < n; ++i) y[i] = cache->fSpline->Eval(x[i]);
+   } else {
+      for (Int_t i = 0; i < n; ++i) y[i] = EvalLinear(x[i], *cache);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Linear interpolation (or extrapolation) between the two points close to x.
+
+Double_t TGraph::EvalLinear(Double_t x, const TEvalCache &cache) const
+{
    //In case x is < fX[0] or > fX[fNpoints-1] return the extrapolated point
 
    //find points in graph around x assuming points are not sorted
    // (if point are sorted use a binary search)
    Int_t low  = -1;
    Int_t up  = -1;
-   if (TestBit(TGraph::kIsSortedX) ) {
+   if (cache.fState == TEvalCache::kEquidistant) {
+      // direct lookup, corrected for rounding errors
+      Double_t u = (x - fX[0]) / cache.fDelta;
+      low = (u >= fNpoints - 1) ? fNpoints - 1 : (u > 0) ? Int_t(u) : 0;
+      if (low < fNpoints - 1 && fX[low + 1] <= x) low++;
+      else if (low > 0 && fX[low] > x) low--;
+      if (fX[low] == x) return fY[low];
+      if (low == fNpoints-1) low--; // for extrapolating
+      up = low+1;
+   }
+   else if (cache.fState == TEvalCache::kSorted || TestBit(TGraph::kIsSortedX) ) {
       low = TMath::BinarySearch(fNpoints, fX, x);
       if (low == -1)  {
          // use first two points for doing an extrapolation
@@ -954,6 +1023,73 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    return yn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return what Eval knows about the current points: whether they are sorted
+/// and equidistant in X, and with withSpline the TSpline3 through them.
+///
+/// The cache is reused only if the arrays, the number of points and the
+/// checksum of their values are the ones it was computed for, so that it never
+/// describes modified points. The returned pointer keeps the cache (and its
+/// spline) alive while it is used, even if a concurrent Eval replaces it.
+
+std::shared_ptr<const TGraph::TEvalCache> TGraph::GetEvalCache(Bool_t withSpline) const
+{
+   const ULong64_t checksum = EvalChecksum(fNpoints, fX, fY);
+   std::shared_ptr<const TEvalCache> cache = std::atomic_load(&fEvalCache);
+   const Bool_t valid = cache && cache->fX == fX && cache->fY == fY && cache->fNpoints == fNpoints &&
+                        cache->fChecksum == checksum;
+   if (valid && (!withSpline || cache->fSpline))
+      return cache;
+
+   std::shared_ptr<TEvalCache> update;
+   if (valid) {
+      update = std::make_shared<TEvalCache>(*cache);
+   } else {
+      update = std::make_shared<TEvalCache>();
+      update->fX = fX;
+      update->fY = fY;
+      update->fNpoints = fNpoints;
+      update->fChecksum = checksum;
+      update->fState = TEvalCache::kSorted;
+      for (Int_t i = 1; i < fNpoints; ++i) {
+         if (fX[i] < fX[i-1]) {
+            update->fState = TEvalCache::kUnsorted;
+            break;
+         }
+      }
+      if (update->fState == TEvalCache::kSorted && fNpoints > 2) {
+         Double_t range = fX[fNpoints-1] - fX[0];
+         Double_t delta = range / (fNpoints - 1);
+         Bool_t equidistant = (delta > 0);
+         for (Int_t i = 1; equidistant && i < fNpoints - 1; ++i) {
+            equidistant = std::abs(fX[i] - (fX[0] + i * delta)) <= 1.E-10 * range;
+         }
+         if (equidistant) {
+            update->fDelta = delta;
+            update->fState = TEvalCache::kEquidistant;
+         }
+      }
+   }
+
+   if (withSpline) {
+      // points must be sorted before using a TSpline
+      std::vector<Double_t> xsort(fNpoints);
+      std::vector<Double_t> ysort(fNpoints);
+      std::vector<Int_t> indxsort(fNpoints);
+      TMath::Sort(fNpoints, fX, &indxsort[0], false);
+      for (Int_t i = 0; i < fNpoints; ++i) {
+         xsort[i] = fX[ indxsort[i] ];
+         ysort[i] = fY[ indxsort[i] ];
+      }
+      update->fSpline = std::make_shared<TSpline3>("", &xsort[0], &ysort[0], fNpoints);
+   }
+
+   // a concurrent Eval may store its own, equivalent, cache: the last one wins
+   cache = update;
+   std::atomic_store(&fEvalCache, cache);
+   return cache;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
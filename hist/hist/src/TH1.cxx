@@ -3393,6 +3393,40 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   // The bins of an axis which cannot be extended do not change while filling:
+   // find them by chunks and keep the statistics in local variables.
+   if (!fXaxis.CanExtend()) {
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<ntimes;++i) {
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Int_t bins[kNFillNChunk];
+      for (Int_t first=0;first<ntimes;first+=kNFillNChunk) {
+         const Int_t n = TMath::Min(Int_t(kNFillNChunk), ntimes-first);
+         const Double_t *xx = x + first*stride;
+         const Double_t *ws = w ? w + first*stride : nullptr;
+         fXaxis.FindFixBins(n, xx, bins, stride);
+         for (i=0;i<n;++i) {
+            bin = bins[i];
+            if (ws) ww = ws[i*stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            const Double_t xi = xx[i*stride];
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*xi;
+            tsumwx2 += ww*xi*xi;
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -3852,6 +3886,10 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///        - "C"  In case of linear fitting, don't calculate the chisquare
 ///          (saves time)
 ///        - "F"  If fitting a polN, switch to minuit fitter
+///        - "G"  Use the gradient of the fit function with respect to the parameters
+///          in the minimization. For functions defined by a formula the gradient is
+///          computed by automatic differentiation (see TF1::GradientParAD), otherwise
+///          numerically.
 ///        - "S"  The result of the fit is returned in the TFitResultPtr
 ///          (see below Access to the Fit Result)
 /// \param[in] goption specify a list of graphics options. See TH1::Draw for a complete list of these options.
@@ -8,9 +8,15 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -750,7 +756,9 @@ Bool_t TH1Merger::SameAxesMerge() {
    }
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
-   
+
+   std::vector<TH1 *> inputs;
+   inputs.reserve(fInputList.GetSize());
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -767,18 +775,22 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      inputs.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
+   if (!AddBinArrays(inputs)) {
+      for (TH1 *hist : inputs) {
          // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
+         for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
 
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            fH0->AddBinContent(ibin,cu);
+            if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
 
+         }
       }
    }
    //copy merged stats
@@ -788,6 +800,102 @@ Bool_t TH1Merger::SameAxesMerge() {
    return kTRUE;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bins [first, last) of the arrays src[i] (and of their sum of weights
+/// squared src2[i], or of the contents if null) to dst (and dst2 if not null).
+/// The inputs are added in order, so the result does not depend on how the bins
+/// are split between calls.
+
+template <typename T>
+void AddBinRange(T *dst, Double_t *dst2, const std::vector<const T *> &src, const std::vector<const Double_t *> &src2,
+                 Int_t first, Int_t last)
+{
+   for (size_t i = 0; i < src.size(); ++i) {
+      const T *s = src[i];
+      for (Int_t bin = first; bin < last; ++bin)
+         dst[bin] += s[bin];
+      if (!dst2)
+         continue;
+      if (src2[i]) {
+         const Double_t *s2 = src2[i];
+         for (Int_t bin = first; bin < last; ++bin)
+            dst2[bin] += s2[bin];
+      } else {
+         for (Int_t bin = first; bin < last; ++bin)
+            dst2[bin] += s[bin];
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin arrays of inputs to h0. All histograms are known to be of class
+/// HIST (whose contents are the array of type T it inherits from) and have the
+/// same axes. Big arrays are split in ranges of bins added by IMT tasks.
+
+template <class HIST, typename T>
+void AddArrays(HIST *h0, const std::vector<TH1 *> &inputs)
+{
+   const Int_t ncells = h0->GetNcells();
+   T *dst = h0->GetArray();
+   Double_t *dst2 = h0->GetSumw2N() ? h0->GetSumw2()->GetArray() : nullptr;
+   std::vector<const T *> src;
+   std::vector<const Double_t *> src2;
+   for (TH1 *h : inputs) {
+      src.push_back(static_cast<HIST *>(h)->GetArray());
+      src2.push_back(h->GetSumw2N() ? h->GetSumw2()->GetArray() : nullptr);
+   }
+
+#ifdef R__USE_IMT
+   // Below this number of additions the tasks cost more than they save
+   const Long64_t kMinParallelWork = 1 << 20;
+   if (ROOT::IsImplicitMTEnabled() && Long64_t(ncells) * src.size() >= kMinParallelWork) {
+      const Int_t chunk = std::max(Int_t(kMinParallelWork / src.size()), 4096);
+      const UInt_t nchunks = (ncells + chunk - 1) / chunk;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t ichunk) {
+         const Int_t first = ichunk * chunk;
+         AddBinRange(dst, dst2, src, src2, first, std::min(first + chunk, ncells));
+      }, ROOT::TSeq<UInt_t>(0, nchunks));
+      return;
+   }
+#endif
+   AddBinRange(dst, dst2, src, src2, 0, ncells);
+}
+
+} // namespace
+
+/**
+   Add the bin contents of inputs to fH0 working directly on the bin arrays,
+   when fH0 and all inputs are TH1D, TH2D, TH3D, TH1F, TH2F or TH3F of the same class.
+   The result is the same as adding the bins one by one with AddBinContent.
+   Return kFALSE if the histograms are not of such a class.
+ */
+Bool_t TH1Merger::AddBinArrays(const std::vector<TH1 *> &inputs) {
+   TClass *cl = fH0->IsA();
+   for (TH1 *hist : inputs) {
+      if (hist->IsA() != cl || hist->fNcells != fH0->fNcells)
+         return kFALSE;
+   }
+
+   if (cl == TH1D::Class())
+      AddArrays<TH1D, Double_t>(static_cast<TH1D *>(fH0), inputs);
+   else if (cl == TH2D::Class())
+      AddArrays<TH2D, Double_t>(static_cast<TH2D *>(fH0), inputs);
+   else if (cl == TH3D::Class())
+      AddArrays<TH3D, Double_t>(static_cast<TH3D *>(fH0), inputs);
+   else if (cl == TH1F::Class())
+      AddArrays<TH1F, Float_t>(static_cast<TH1F *>(fH0), inputs);
+   else if (cl == TH2F::Class())
+      AddArrays<TH2F, Float_t>(static_cast<TH2F *>(fH0), inputs);
+   else if (cl == TH3F::Class())
+      AddArrays<TH3F, Float_t>(static_cast<TH3F *>(fH0), inputs);
+   else
+      return kFALSE;
+   return kTRUE;
+}
+
 
 /**
    Merged histogram when axis can be different. 
@@ -14,6 +14,8 @@
 #include "TH1.h"
 #include "TList.h"
 
+#include <vector>
+
 class TH1Merger {
 
 public:
@@ -97,6 +99,8 @@ private:
 
    Bool_t SameAxesMerge();
 
+   Bool_t AddBinArrays(const std::vector<TH1 *> &inputs);
+
    Bool_t DifferentAxesMerge();
 
    Bool_t LabelMerge();
@@ -552,6 +552,57 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // The bins of axes which cannot be extended do not change while filling:
+   // find them by chunks and keep the statistics in local variables.
+   if (!fXaxis.CanExtend() && !fYaxis.CanExtend()) {
+      const Int_t nentries = (ntimes-ifirst+stride-1)/stride;
+      x += ifirst;
+      y += ifirst;
+      if (w) w += ifirst;
+      fEntries += nentries;
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<nentries;++i) {
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+      Int_t binsx[kNFillNChunk], binsy[kNFillNChunk];
+      for (Int_t first=0;first<nentries;first+=kNFillNChunk) {
+         const Int_t n = TMath::Min(Int_t(kNFillNChunk), nentries-first);
+         const Double_t *xx = x + first*stride;
+         const Double_t *yy = y + first*stride;
+         const Double_t *ws = w ? w + first*stride : nullptr;
+         fXaxis.FindFixBins(n, xx, binsx, stride);
+         fYaxis.FindFixBins(n, yy, binsy, stride);
+         for (i=0;i<n;++i) {
+            binx = binsx[i];
+            biny = binsy[i];
+            bin  = biny*(nbinsx+2) + binx;
+            if (ws) ww = ws[i*stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy)) continue;
+            const Double_t xi = xx[i*stride];
+            const Double_t yi = yy[i*stride];
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*xi;
+            tsumwx2 += ww*xi*xi;
+            tsumwy  += ww*yi;
+            tsumwy2 += ww*yi*yi;
+            tsumwxy += ww*xi*yi;
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -382,6 +382,87 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+/// The result is the same as calling Fill(x[i],y[i],z[i],w[i]) for each entry.
+/// If no axis can be extended and the histogram has no buffer, the bins are
+/// found by chunks of entries (see TAxis::FindFixBins).
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t i;
+   if (fBuffer || fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend()) {
+      for (i=0;i<ntimes;++i)
+         Fill(x[i*stride], y[i*stride], z[i*stride], w ? w[i*stride] : 1.);
+      return;
+   }
+
+   fEntries += ntimes;
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i=0;i<ntimes;++i) {
+         if (w[i*stride] != 1.0) { Sumw2(); break; }
+      }
+   }
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+   Double_t tsumwz = fTsumwz, tsumwz2 = fTsumwz2, tsumwxz = fTsumwxz, tsumwyz = fTsumwyz;
+   Double_t ww = 1;
+   Int_t binsx[kNFillNChunk], binsy[kNFillNChunk], binsz[kNFillNChunk];
+   for (Int_t first=0;first<ntimes;first+=kNFillNChunk) {
+      const Int_t n = TMath::Min(Int_t(kNFillNChunk), ntimes-first);
+      const Double_t *xx = x + first*stride;
+      const Double_t *yy = y + first*stride;
+      const Double_t *zz = z + first*stride;
+      const Double_t *ws = w ? w + first*stride : nullptr;
+      fXaxis.FindFixBins(n, xx, binsx, stride);
+      fYaxis.FindFixBins(n, yy, binsy, stride);
+      fZaxis.FindFixBins(n, zz, binsz, stride);
+      for (i=0;i<n;++i) {
+         const Int_t binx = binsx[i], biny = binsy[i], binz = binsz[i];
+         const Int_t bin = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (ws) ww = ws[i*stride];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy ||
+                                binz == 0 || binz > nbinsz)) continue;
+         const Double_t xi = xx[i*stride];
+         const Double_t yi = yy[i*stride];
+         const Double_t zi = zz[i*stride];
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*xi;
+         tsumwx2 += ww*xi*xi;
+         tsumwy  += ww*yi;
+         tsumwy2 += ww*yi*yi;
+         tsumwxy += ww*xi*yi;
+         tsumwz  += ww*zi;
+         tsumwz2 += ww*zi*zi;
+         tsumwxz += ww*xi*zi;
+         tsumwyz += ww*yi*zi;
+      }
+   }
+   fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+   fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+   fTsumwz = tsumwz; fTsumwz2 = tsumwz2; fTsumwxz = tsumwxz; fTsumwyz = tsumwyz;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -603,6 +603,30 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries at once. "x" holds the coordinates of the entries one after
+/// the other, i.e. n * GetNdimensions() values; "w" holds the n weights, or is
+/// NULL for unit weights.
+/// The entries are processed in chunks: the bin lookups of a chunk are done
+/// before any of its bins is filled, which keeps the bin index of a THnSparse
+/// hot in the cache instead of alternating with writes to the bin contents.
+
+void THnBase::FillN(Long64_t n, const Double_t *x, const Double_t *w /*= nullptr*/)
+{
+   const Long64_t kChunk = 256;
+   Long64_t bins[kChunk];
+   for (Long64_t first = 0; first < n; first += kChunk) {
+      const Long64_t last = TMath::Min(n, first + kChunk);
+      for (Long64_t i = first; i < last; ++i) {
+         const Double_t *xi = x + i * fNdimensions;
+         UpdateXStat(xi, w ? w[i] : 1.);
+         bins[i - first] = GetBin(xi, kTRUE /*alloc*/);
+      }
+      for (Long64_t i = first; i < last; ++i)
+         FillBin(bins[i - first], w ? w[i] : 1.);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Scale contents and errors of this histogram by c:
 /// this = this * c
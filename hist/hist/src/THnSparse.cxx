@@ -271,9 +271,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromCoords(const Int_t* coord) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin index.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin index's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -319,9 +319,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin index.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin index's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -571,14 +571,19 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
+This hash is used to lookup the linear index in the transient member
+fBinIndex, an open-addressing hash table with linear probing that stores
+pairs of (hash, linear index + 1) next to each other, so that a lookup
+usually touches a single cache line. Its number of slots is a power of two,
+kept at least twice the number of filled bins; the slot of a hash is
+obtained by Fibonacci hashing. For each occupied slot with the same hash,
+the coordinates of the entry it points to are compared to the coordinates
 passed to GetBin(). If they do not match, these two coordinates have the same
 hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+coordinates are larger than 8 bytes) possible; probing then simply continues
+to the next slot until the matching bin or an empty slot is found.
+The table is not streamed: it is rebuilt from the bin coordinates the first
+time a bin is looked up after reading a THnSparse from a file.
 */
 
 
@@ -588,7 +593,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinIndexBits(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +610,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinIndexBits(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -651,49 +656,69 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinIndex
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinIndex()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   GrowBinIndex(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         InsertIntoBinIndex(compactCoord.GetHashFromBuffer(buf), idx);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure fBinIndex has at least twice as many slots as "nbins", keeping
+/// the probe sequences short. Existing entries are re-inserted using their
+/// stored hash; the bin coordinates are not accessed.
+
+void THnSparse::GrowBinIndex(Long64_t nbins)
+{
+   UInt_t bits = 4;
+   while (bits < 63 && (1ULL << bits) < 2ULL * nbins)
+      ++bits;
+   if (bits <= fBinIndexBits)
+      return;
+
+   std::vector<ULong64_t> oldIndex(2ULL << bits, 0);
+   oldIndex.swap(fBinIndex);
+   fBinIndexBits = bits;
+   for (size_t slot = 0; slot < oldIndex.size(); slot += 2) {
+      if (oldIndex[slot + 1])
+         InsertIntoBinIndex(oldIndex[slot], oldIndex[slot + 1] - 1);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Store the linear index "linidx" of a bin with the given "hash" in the first
+/// free slot of its probe sequence. fBinIndex must have a free slot.
+
+void THnSparse::InsertIntoBinIndex(ULong64_t hash, Long64_t linidx)
+{
+   const ULong64_t mask = (1ULL << fBinIndexBits) - 1;
+   ULong64_t slot = (hash * 0x9E3779B97F4A7C15ULL) >> (64 - fBinIndexBits);
+   while (fBinIndex[2 * slot + 1])
+      slot = (slot + 1) & mask;
+   fBinIndex[2 * slot] = hash;
+   fBinIndex[2 * slot + 1] = linidx + 1; // 0 means "empty slot"
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   if (fBinIndex.empty() && fBinContent.GetSize()) {
+      FillBinIndex();
    }
+   GrowBinIndex(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -791,19 +816,19 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
+   if (fBinContent.GetSize() && fBinIndex.empty())
+      FillBinIndex();
+   if (!fBinIndex.empty()) {
+      const ULong64_t mask = (1ULL << fBinIndexBits) - 1;
+      ULong64_t slot = (hash * 0x9E3779B97F4A7C15ULL) >> (64 - fBinIndexBits);
+      // fBinIndex stores index + 1, 0 is an empty slot that ends the probing
+      for (Long64_t linidx; (linidx = fBinIndex[2 * slot + 1]); slot = (slot + 1) & mask) {
+         if (fBinIndex[2 * slot] != hash)
+            continue;
+         THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
+         if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
+            return linidx - 1;
+      }
    }
    if (!allocate) return -1;
 
@@ -818,18 +843,11 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    }
    chunk->AddBin(newidx, cc->GetBuffer());
 
-   // store translation between hash and bin
+   // store translation between hash and bin; grow geometrically
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   if (2 * GetNbins() > (1LL << fBinIndexBits))
+      GrowBinIndex(2 * GetNbins());
+   InsertIntoBinIndex(hash, newidx);
    return newidx;
 }
 
@@ -881,7 +899,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += sizeof(ULong64_t) * fBinIndex.size() /* fBinIndex */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +981,8 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   std::vector<ULong64_t>().swap(fBinIndex);
+   fBinIndexBits = 0;
    fBinContent.Delete();
    ResetBase(option);
 }
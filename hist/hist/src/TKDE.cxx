@@ -41,6 +41,7 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TCanvas.h"
+#include "TVirtualFFT.h"
 #include "TKDE.h"
 
 
@@ -50,6 +51,8 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   std::vector<UInt_t> fIndex; // Data indices sorted by data value
+   Double_t fMaxWeight; // Largest kernel weight
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
@@ -79,7 +82,7 @@ TKDE::TKDE() :
    fGraph(nullptr),
    fUseMirroring(false), fMirrorLeft(false), fMirrorRight(false), fAsymLeft(false), fAsymRight(false),
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
-   fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
+   fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0), fNGridPoints(0),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
    fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
 {
@@ -114,6 +117,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fNGridPoints = 0;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -396,6 +400,21 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetGridApproximation(UInt_t npoints) {
+   // Sets the number of points of a grid in [xMin, xMax] on which the estimate is computed once;
+   // the estimate is then linearly interpolated between the grid points, which makes each
+   // evaluation independent of the data size. The grid spacing should be small compared to the
+   // bandwidth. With a fixed bandwidth and a built-in kernel, the grid values are obtained by
+   // convolving the data binned on the grid with the kernel via FFT (if FFTW is available).
+   // Outside [xMin, xMax] and for npoints = 0 (the default) the estimate is evaluated exactly.
+   if (npoints == 1) {
+      Error("SetGridApproximation", "At least two grid points are needed. Present value remains the same.");
+      return;
+   }
+   fNGridPoints = npoints;
+   fGridValues.clear();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -514,6 +533,7 @@ void TKDE::InitFromNewData() {
    if (fUseMirroring) {
       SetMirroredEvents();
    }
+   fGridValues.clear();
    // in case of I/O reset the kernel
 }
 
@@ -570,6 +590,7 @@ void TKDE::SetKernel() {
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
+   fGridValues.clear();
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
@@ -696,6 +717,13 @@ Double_t TKDE::operator()(Double_t x) const {
       // in case of failed re-initialization
       if (!fKernel) return TMath::QuietNaN();
    }
+   if (fNGridPoints > 0 && x >= fXMin && x <= fXMax) {
+      if (fGridValues.empty()) (const_cast<TKDE*>(this))->SetGridValues();
+      Double_t u = (x - fXMin) / (fXMax - fXMin) * (fNGridPoints - 1);
+      UInt_t j = std::min(UInt_t(u), fNGridPoints - 2);
+      Double_t f = u - j;
+      return (1. - f) * fGridValues[j] + f * fGridValues[j + 1];
+   }
    return (*fKernel)(x);
 }
 
@@ -721,8 +749,14 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
-{}
+fWeights(fNWeights, weight),
+fIndex(fNWeights),
+fMaxWeight(weight)
+{
+   const std::vector<Double_t> &data = kde->fData;
+   std::iota(fIndex.begin(), fIndex.end(), 0);
+   std::sort(fIndex.begin(), fIndex.end(), [&data](UInt_t i, UInt_t j) { return data[i] < data[j]; });
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -747,6 +781,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
    transform(weights.begin(), weights.end(), fWeights.begin(),
              std::bind(std::multiplies<Double_t>(), std::placeholders::_1, fKDE->fAdaptiveBandwidthFactor));
+   fMaxWeight = *std::max_element(fWeights.begin(), fWeights.end());
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
@@ -764,6 +799,87 @@ void TKDE::SetBinCentreData(Double_t xmin, Double_t xmax) {
    }
 }
 
+void TKDE::SetGridValues() {
+   // Computes the estimate at the points of the approximation grid
+   fGridValues.assign(fNGridPoints, 0.0);
+   if (SetGridValuesFFT()) return;
+   Double_t dx = (fXMax - fXMin) / (fNGridPoints - 1);
+   for (UInt_t j = 0; j < fNGridPoints; ++j) {
+      fGridValues[j] = (*fKernel)(fXMin + j * dx);
+   }
+}
+
+Bool_t TKDE::SetGridValuesFFT() {
+   // Computes the estimate at the grid points as the convolution of the data, linearly binned on
+   // the grid, with the kernel sampled at the grid spacing. This requires a fixed bandwidth and a
+   // kernel of known support, and is not done with asymmetric mirroring: returns false in these
+   // cases or if no FFT implementation is available.
+   Double_t support = GetKernelSupport();
+   if (fIteration != kFixed || support <= 0 || fAsymLeft || fAsymRight) return kFALSE;
+
+   Double_t dx = (fXMax - fXMin) / (fNGridPoints - 1);
+   Double_t h = fKernel->GetFixedWeight();
+   if (support * h > 10. * (fXMax - fXMin)) return kFALSE; // grid much narrower than the kernel
+   Int_t nk = Int_t(std::ceil(support * h / dx)); // kernel half-width in grid cells
+   Int_t m = fNGridPoints + 2 * nk;                 // grid extended by the kernel support
+   Int_t n = m + nk; // the circular convolution does not wrap around onto the grid
+
+   TVirtualFFT *fftData = TVirtualFFT::FFT(1, &n, "R2C K");
+   TVirtualFFT *fftKernel = TVirtualFFT::FFT(1, &n, "R2C K");
+   TVirtualFFT *fftInverse = TVirtualFFT::FFT(1, &n, "C2R K");
+   if (!fftData || !fftKernel || !fftInverse) {
+      delete fftData;
+      delete fftKernel;
+      delete fftInverse;
+      return kFALSE;
+   }
+
+   // linear binning of the (possibly mirrored) data on the extended grid
+   std::vector<Double_t> counts(n, 0.0);
+   UInt_t nData = fData.size();
+   Bool_t useBins = (fBinCount.size() == nData);
+   Double_t x0 = fXMin - nk * dx;
+   for (UInt_t i = 0; i < nData; ++i) {
+      Double_t u = (fData[i] - x0) / dx;
+      if (u < 0 || u > m - 1) continue;
+      Int_t a = std::min(Int_t(u), m - 2);
+      Double_t f = u - a;
+      Double_t w = (useBins) ? fBinCount[i] : 1.0;
+      counts[a] += w * (1. - f);
+      counts[a + 1] += w * f;
+   }
+   // kernel sampled at the grid spacing, negative offsets wrapped around
+   std::vector<Double_t> kernel(n, 0.0);
+   for (Int_t k = 0; k <= nk; ++k) {
+      Double_t kv = (*fKernelFunction)(k * dx / h) / h;
+      kernel[k] = kv;
+      if (k > 0) kernel[n - k] = kv;
+   }
+
+   fftData->SetPoints(counts.data());
+   fftKernel->SetPoints(kernel.data());
+   fftData->Transform();
+   fftKernel->Transform();
+   Double_t re1, im1, re2, im2;
+   for (Int_t i = 0; i <= n / 2; ++i) {
+      fftData->GetPointComplex(i, re1, im1);
+      fftKernel->GetPointComplex(i, re2, im2);
+      fftInverse->SetPoint(i, re1 * re2 - im1 * im2, re1 * im2 + re2 * im1);
+   }
+   fftInverse->Transform();
+
+   // FFTW transforms are not normalized
+   Double_t nSum = (useBins) ? fSumOfCounts : fNEvents;
+   for (UInt_t j = 0; j < fNGridPoints; ++j) {
+      fGridValues[j] = std::max(fftInverse->GetPointReal(j + nk), 0.0) / (n * nSum);
+   }
+
+   delete fftData;
+   delete fftKernel;
+   delete fftInverse;
+   return kTRUE;
+}
+
 void TKDE::SetBinCountData() {
    // Returns the bins' count from the data for using with the binned option
    // or set the bin count to the weights in case of weighted data
@@ -937,9 +1053,23 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   // Only the data within the kernel support around x contribute: without the reflected terms
+   // of the asymmetric mirroring, they are found by binary search in the sorted data.
+   UInt_t first = 0;
+   UInt_t last = fIndex.size();
+   Double_t support = fKDE->GetKernelSupport();
+   if (support > 0 && !fKDE->fAsymLeft && !fKDE->fAsymRight) {
+      const std::vector<Double_t> &data = fKDE->fData;
+      Double_t window = support * fMaxWeight;
+      first = std::partition_point(fIndex.begin(), fIndex.end(),
+                                   [&](UInt_t i) { return data[i] < x - window; }) - fIndex.begin();
+      last = std::partition_point(fIndex.begin() + first, fIndex.end(),
+                                  [&](UInt_t i) { return data[i] <= x + window; }) - fIndex.begin();
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
-   for (UInt_t i = 0; i < n; ++i) {
+   for (UInt_t k = first; k < last; ++k) {
+      UInt_t i = fIndex[k];
       Double_t binCount = (useBins) ? fKDE->fBinCount[i] : 1.0;
       result += binCount / fWeights[i] * (*fKDE->fKernelFunction)((x - fKDE->fData[i]) / fWeights[i]);
       if (fKDE->fAsymLeft) {
@@ -1111,6 +1241,20 @@ void TKDE::ComputeDataStats() {
    }
 }
 
+Double_t TKDE::GetKernelSupport() const {
+   // Returns the half-width of the kernel support in units of the bandwidth, 0 if unknown
+   switch (fKernelType) {
+      case kGaussian:
+         return 9.; // the Gaussian kernel is truncated at 9 sigma
+      case kEpanechnikov:
+      case kBiweight:
+      case kCosineArch:
+         return 1.;
+      default:
+         return 0.;
+   }
+}
+
 Double_t TKDE::ComputeMidspread () {
    // Computes the inter-quartile range from the data
    std::sort(fEvents.begin(), fEvents.end());
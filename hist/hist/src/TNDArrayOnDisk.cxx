@@ -0,0 +1,387 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TNDArrayOnDisk.h"
+#include "TBuffer.h"
+#include "TError.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Backing file and resident chunks of a TNDArrayOnDisk.
+
+struct TNDArrayOnDiskStore {
+   struct Chunk_t {
+      Long64_t fIndex = -1;       // index of the chunk
+      std::vector<Char_t> fData;  // elements of the chunk
+      Bool_t fDirty = kFALSE;     // whether fData differs from the file
+   };
+   typedef std::list<Chunk_t> ChunkList_t;
+
+   std::fstream fFile;           // the backing file
+   Long64_t fFileSize = 0;       // number of bytes in the backing file
+   ChunkList_t fResident;        // resident chunks, most recently used first
+   std::unordered_map<Long64_t, ChunkList_t::iterator> fLookup; // chunk index to resident chunk
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+using ROOT::Internal::TNDArrayOnDiskStore;
+
+namespace {
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Write a modified chunk back to the backing file.
+
+   void WriteChunk(TNDArrayOnDiskStore& store, TNDArrayOnDiskStore::Chunk_t& chunk,
+                   Long64_t offset, const char* fileName)
+   {
+      store.fFile.clear();
+      store.fFile.seekp(offset);
+      store.fFile.write(chunk.fData.data(), chunk.fData.size());
+      if (!store.fFile) {
+         ::Error("TNDArrayOnDisk::WriteChunk", "Cannot write to backing file %s", fileName);
+         return;
+      }
+      store.fFileSize = std::max(store.fFileSize, offset + (Long64_t) chunk.fData.size());
+      chunk.fDirty = kFALSE;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Create an empty temporary file and set "name" to its name.
+
+   Bool_t CreateTempFile(TString& name)
+   {
+      TString base("TNDArrayOnDisk");
+      FILE* tmp = gSystem->TempFileName(base);
+      if (!tmp) {
+         ::Error("TNDArrayOnDisk::CreateTempFile", "Cannot create temporary backing file");
+         return kFALSE;
+      }
+      fclose(tmp);
+      name = base;
+      return kTRUE;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the size of the file "name", or -1 if it does not exist.
+
+   Long64_t GetFileSize(const char* name)
+   {
+      FileStat_t stat;
+      if (gSystem->GetPathInfo(name, stat))
+         return -1;
+      return stat.fSize;
+   }
+}
+
+ClassImp(TNDArrayOnDisk);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct an empty TNDArrayOnDisk, used for I/O.
+
+TNDArrayOnDisk::TNDArrayOnDisk():
+   fElementSize(), fChunkSize(kDefaultChunkSize),
+   fMaxResidentChunks(kDefaultMaxResidentChunks), fKeepFile(kFALSE),
+   fStore(), fCurrentChunk(-1), fCurrentData(), fCurrentDirty(kFALSE)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a TNDArrayOnDisk with "ndim" dimensions of "nbins" bins each
+/// (plus under- and overflow if "addOverflow") and elements of "elementSize"
+/// bytes. At most "maxResidentChunks" chunks of "chunkSize" elements are kept
+/// in memory.
+/// If "fileName" is given, that file is used as backing file and it is kept
+/// when the array is destroyed; it is created if it does not exist, otherwise
+/// its content is used as initial content of the array. If no "fileName" is
+/// given, a temporary file is used.
+
+TNDArrayOnDisk::TNDArrayOnDisk(Int_t ndim, const Int_t* nbins, bool addOverflow,
+                               Int_t elementSize, Long64_t chunkSize /*= kDefaultChunkSize*/,
+                               Int_t maxResidentChunks /*= kDefaultMaxResidentChunks*/,
+                               const char* fileName /*= 0*/):
+   TNDArray(ndim, nbins, addOverflow),
+   fElementSize(elementSize), fChunkSize(chunkSize > 0 ? chunkSize : (Long64_t) kDefaultChunkSize),
+   fMaxResidentChunks(std::max(maxResidentChunks, 1)), fFileName(fileName),
+   fKeepFile(fileName && fileName[0]),
+   fStore(), fCurrentChunk(-1), fCurrentData(), fCurrentDirty(kFALSE)
+{
+   if (fKeepFile) {
+      std::ofstream create(fFileName.Data(), std::ios::binary | std::ios::app);
+      if (!create)
+         Error("TNDArrayOnDisk", "Cannot create backing file %s", fFileName.Data());
+      else if (GetFileSize(fFileName) > GetNbins() * fElementSize)
+         Error("TNDArrayOnDisk", "Backing file %s is larger than the array, its content will be wrong",
+               fFileName.Data());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destruct a TNDArrayOnDisk; the backing file is removed unless it was
+/// given explicitly.
+
+TNDArrayOnDisk::~TNDArrayOnDisk()
+{
+   CloseStore();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the dimensions of the array and clear its content.
+
+void TNDArrayOnDisk::Init(Int_t ndim, const Int_t* nbins, bool addOverflow /*= false*/)
+{
+   TNDArray::Init(ndim, nbins, addOverflow);
+   Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the content: drop the resident chunks and truncate the backing file.
+
+void TNDArrayOnDisk::Reset(Option_t* /*option = ""*/)
+{
+   if (!fStore) {
+      if (fFileName.Length())
+         std::ofstream(fFileName.Data(), std::ios::binary | std::ios::trunc);
+      return;
+   }
+   fStore->fResident.clear();
+   fStore->fLookup.clear();
+   fCurrentChunk = -1;
+   fCurrentData = 0;
+   fCurrentDirty = kFALSE;
+
+   fStore->fFile.close();
+   std::ofstream(fFileName.Data(), std::ios::binary | std::ios::trunc);
+   fStore->fFile.open(fFileName.Data(), std::ios::binary | std::ios::in | std::ios::out);
+   fStore->fFileSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write all modified resident chunks to the backing file.
+
+void TNDArrayOnDisk::Flush()
+{
+   if (!fStore)
+      return;
+   for (auto& chunk: fStore->fResident) {
+      if (chunk.fDirty)
+         WriteChunk(*fStore, chunk, chunk.fIndex * fChunkSize * fElementSize, fFileName);
+   }
+   fStore->fFile.flush();
+   // The current chunk must be marked as modified again by the next write.
+   fCurrentDirty = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximal number of chunks kept in memory.
+
+void TNDArrayOnDisk::SetMaxResidentChunks(Int_t n)
+{
+   fMaxResidentChunks = std::max(n, 1);
+   if (!fStore)
+      return;
+   while ((Int_t) fStore->fResident.size() > fMaxResidentChunks) {
+      auto& chunk = fStore->fResident.back();
+      if (chunk.fDirty)
+         WriteChunk(*fStore, chunk, chunk.fIndex * fChunkSize * fElementSize, fFileName);
+      if (chunk.fIndex == fCurrentChunk)
+         fCurrentChunk = -1;
+      fStore->fLookup.erase(chunk.fIndex);
+      fStore->fResident.pop_back();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes of chunk "ichunk"; only the last chunk can be
+/// shorter than fChunkSize elements.
+
+Long64_t TNDArrayOnDisk::GetChunkBytes(Long64_t ichunk) const
+{
+   return std::min(fChunkSize, GetNbins() - ichunk * fChunkSize) * fElementSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make chunk "ichunk" resident and the current chunk, evicting the least
+/// recently used chunk if fMaxResidentChunks are already in memory.
+
+void TNDArrayOnDisk::LoadChunk(Long64_t ichunk, Bool_t write) const
+{
+   if (!fStore)
+      OpenStore();
+   TNDArrayOnDiskStore& store = *fStore;
+   TNDArrayOnDiskStore::ChunkList_t& resident = store.fResident;
+
+   TNDArrayOnDiskStore::ChunkList_t::iterator chunk;
+   auto iLookup = store.fLookup.find(ichunk);
+   if (iLookup != store.fLookup.end()) {
+      chunk = iLookup->second;
+      resident.splice(resident.begin(), resident, chunk);
+   } else {
+      if ((Int_t) resident.size() >= fMaxResidentChunks) {
+         // Recycle the least recently used chunk.
+         chunk = std::prev(resident.end());
+         if (chunk->fDirty)
+            WriteChunk(store, *chunk, chunk->fIndex * fChunkSize * fElementSize, fFileName);
+         store.fLookup.erase(chunk->fIndex);
+         resident.splice(resident.begin(), resident, chunk);
+      } else {
+         resident.emplace_front();
+         chunk = resident.begin();
+      }
+
+      // Read what the file has of this chunk; the rest was never written.
+      const Long64_t offset = ichunk * fChunkSize * fElementSize;
+      const Long64_t nbytes = GetChunkBytes(ichunk);
+      chunk->fIndex = ichunk;
+      chunk->fDirty = kFALSE;
+      chunk->fData.assign(nbytes, 0);
+      if (offset < store.fFileSize) {
+         store.fFile.clear();
+         store.fFile.seekg(offset);
+         store.fFile.read(chunk->fData.data(), std::min(nbytes, store.fFileSize - offset));
+         if (!store.fFile)
+            Error("LoadChunk", "Cannot read from backing file %s", fFileName.Data());
+      }
+      store.fLookup[ichunk] = chunk;
+   }
+   if (write)
+      chunk->fDirty = kTRUE;
+   fCurrentChunk = ichunk;
+   fCurrentData = chunk->fData.data();
+   fCurrentDirty = chunk->fDirty;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the backing file, creating a temporary one if no file name is set.
+
+void TNDArrayOnDisk::OpenStore() const
+{
+   fStore = new TNDArrayOnDiskStore();
+   if (!fFileName.Length()) {
+      fKeepFile = kFALSE;
+      if (!CreateTempFile(fFileName))
+         return;
+   }
+   fStore->fFile.open(fFileName.Data(), std::ios::binary | std::ios::in | std::ios::out);
+   if (!fStore->fFile) {
+      Error("OpenStore", "Cannot open backing file %s", fFileName.Data());
+      return;
+   }
+   fStore->fFile.seekg(0, std::ios::end);
+   fStore->fFileSize = fStore->fFile.tellg();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write back modified chunks if the backing file is kept, release the
+/// resident chunks and remove the backing file if it is not kept.
+
+void TNDArrayOnDisk::CloseStore()
+{
+   if (!fStore)
+      return;
+   if (fKeepFile)
+      Flush();
+   fStore->fFile.close();
+   if (!fKeepFile)
+      gSystem->Unlink(fFileName);
+   delete fStore;
+   fStore = 0;
+   fCurrentChunk = -1;
+   fCurrentData = 0;
+   fCurrentDirty = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream an object of class TNDArrayOnDisk.
+/// The elements are stored in the buffer, after the data members: the number
+/// of chunks written, then the index and the elements of each chunk. Chunks
+/// whose elements are all zero are skipped, so only the filled part of a large
+/// array takes space. The backing file is not referenced: an array read back
+/// uses a new temporary backing file, removed when it is destroyed.
+/// The elements written must fit into a single key, i.e. less than 1GB;
+/// otherwise an error is printed and no element is written.
+
+void TNDArrayOnDisk::Streamer(TBuffer &R__b)
+{
+   if (R__b.IsReading()) {
+      CloseStore();
+      fFileName = "";
+      fKeepFile = kFALSE;
+      R__b.ReadClassBuffer(TNDArrayOnDisk::Class(), this);
+      Long64_t nchunks = 0;
+      R__b >> nchunks;
+      for (Long64_t i = 0; i < nchunks; ++i) {
+         Long64_t ichunk = -1;
+         R__b >> ichunk;
+         if (ichunk < 0 || ichunk * fChunkSize >= GetNbins()) {
+            Error("Streamer", "Invalid chunk index %lld", ichunk);
+            MakeZombie();
+            return;
+         }
+         StreamElements(R__b, GetElement(ichunk * fChunkSize, kTRUE), (Int_t) (GetChunkBytes(ichunk) / fElementSize));
+      }
+   } else {
+      R__b.WriteClassBuffer(TNDArrayOnDisk::Class(), this);
+      const Int_t countPos = R__b.Length();
+      Long64_t nchunks = 0;
+      R__b << nchunks;
+      if (!fStore && !fFileName.Length())
+         return; // never filled
+
+      // The chunks with content are those in the backing file and the resident ones.
+      if (!fStore)
+         OpenStore();
+      const Long64_t chunkBytes = fChunkSize * fElementSize;
+      std::vector<Long64_t> chunks;
+      for (Long64_t ichunk = 0; ichunk * chunkBytes < fStore->fFileSize; ++ichunk)
+         chunks.push_back(ichunk);
+      for (auto& chunk: fStore->fResident)
+         chunks.push_back(chunk.fIndex);
+      std::sort(chunks.begin(), chunks.end());
+      chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+
+      const Long64_t maxBytes = 1000000000;
+      for (Long64_t ichunk: chunks) {
+         if (ichunk * fChunkSize >= GetNbins())
+            break;
+         Char_t* data = GetElement(ichunk * fChunkSize, kFALSE);
+         const Long64_t nbytes = GetChunkBytes(ichunk);
+         if (std::all_of(data, data + nbytes, [](Char_t c) { return c == 0; }))
+            continue;
+         if (R__b.Length() - countPos + nbytes > maxBytes) {
+            Error("Streamer", "The content of the array exceeds %lld bytes and cannot be written into one key,"
+                  " its elements are not written", maxBytes);
+            R__b.SetBufferOffset(countPos);
+            nchunks = 0;
+            break;
+         }
+         R__b << ichunk;
+         StreamElements(R__b, data, (Int_t) (nbytes / fElementSize));
+         ++nchunks;
+      }
+      const Int_t endPos = R__b.Length();
+      R__b.SetBufferOffset(countPos);
+      R__b << nchunks;
+      if (nchunks)
+         R__b.SetBufferOffset(endPos);
+   }
+}
@@ -770,6 +770,60 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   // The bins of an axis which cannot be extended do not change while filling:
+   // find them by chunks and keep the statistics in local variables.
+   if (!fXaxis.CanExtend()) {
+      const Int_t nentries = (ntimes-ifirst+stride-1)/stride;
+      x += ifirst;
+      y += ifirst;
+      if (w) w += ifirst;
+      const Bool_t checkRange = (fYmin != fYmax);
+      if (w && !fBinSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<nentries;++i) {
+            const Double_t yi = y[i*stride];
+            if (checkRange && (yi < fYmin || yi > fYmax || TMath::IsNaN(yi))) continue;
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nbins = fXaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t entries = fEntries;
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2;
+      Double_t u = 1;
+      Int_t bins[kNFillNChunk];
+      for (Int_t first=0;first<nentries;first+=kNFillNChunk) {
+         const Int_t n = TMath::Min(Int_t(kNFillNChunk), nentries-first);
+         const Double_t *xx = x + first*stride;
+         const Double_t *yy = y + first*stride;
+         const Double_t *ws = w ? w + first*stride : nullptr;
+         fXaxis.FindFixBins(n, xx, bins, stride);
+         for (i=0;i<n;++i) {
+            const Double_t yi = yy[i*stride];
+            if (checkRange && (yi < fYmin || yi > fYmax || TMath::IsNaN(yi))) continue;
+            if (ws) u = ws[i*stride];
+            bin = bins[i];
+            entries++;
+            AddBinContent(bin, u*yi);
+            fSumw2.fArray[bin] += u*yi*yi;
+            if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+            fBinEntries.fArray[bin] += u;
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            const Double_t xi = xx[i*stride];
+            tsumw   += u;
+            tsumw2  += u*u;
+            tsumwx  += u*xi;
+            tsumwx2 += u*xi*xi;
+            tsumwy  += u*yi;
+            tsumwy2 += u*yi*yi;
+         }
+      }
+      fEntries = entries;
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
@@ -771,6 +771,101 @@ Int_t TProfile2D::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a Profile2D histogram with the ntimes points (x,y,z) and weights w
+/// (all weights are 1 if w is null).
+/// The arrays are read with a step of stride values.
+
+void TProfile2D::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t bin,binx,biny,i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+   //If a buffer is activated, fill buffer
+   // (note that this function must not be called from TProfile2D::BufferEmpty)
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i],y[i],z[i],w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   // The bins of axes which cannot be extended do not change while filling:
+   // find them by chunks and keep the statistics in local variables.
+   if (!fXaxis.CanExtend() && !fYaxis.CanExtend()) {
+      const Int_t nentries = (ntimes-ifirst+stride-1)/stride;
+      x += ifirst;
+      y += ifirst;
+      z += ifirst;
+      if (w) w += ifirst;
+      const Bool_t checkRange = (fZmin != fZmax);
+      if (w && !fBinSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<nentries;++i) {
+            const Double_t zi = z[i*stride];
+            if (checkRange && (zi < fZmin || zi > fZmax || TMath::IsNaN(zi))) continue;
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t entries = fEntries;
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+      Double_t tsumwz = fTsumwz, tsumwz2 = fTsumwz2;
+      Double_t u = 1;
+      Int_t binsx[kNFillNChunk], binsy[kNFillNChunk];
+      for (Int_t first=0;first<nentries;first+=kNFillNChunk) {
+         const Int_t n = TMath::Min(Int_t(kNFillNChunk), nentries-first);
+         const Double_t *xx = x + first*stride;
+         const Double_t *yy = y + first*stride;
+         const Double_t *zz = z + first*stride;
+         const Double_t *ws = w ? w + first*stride : nullptr;
+         fXaxis.FindFixBins(n, xx, binsx, stride);
+         fYaxis.FindFixBins(n, yy, binsy, stride);
+         for (i=0;i<n;++i) {
+            const Double_t zi = zz[i*stride];
+            if (checkRange && (zi < fZmin || zi > fZmax || TMath::IsNaN(zi))) continue;
+            if (ws) u = ws[i*stride];
+            binx = binsx[i];
+            biny = binsy[i];
+            bin  = biny*(nbinsx+2) + binx;
+            entries++;
+            AddBinContent(bin, u*zi);
+            fSumw2.fArray[bin] += u*zi*zi;
+            if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+            fBinEntries.fArray[bin] += u;
+            if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy)) continue;
+            const Double_t xi = xx[i*stride];
+            const Double_t yi = yy[i*stride];
+            tsumw   += u;
+            tsumw2  += u*u;
+            tsumwx  += u*xi;
+            tsumwx2 += u*xi*xi;
+            tsumwy  += u*yi;
+            tsumwy2 += u*yi*yi;
+            tsumwxy += u*xi*yi;
+            tsumwz  += u*zi;
+            tsumwz2 += u*zi*zi;
+         }
+      }
+      fEntries = entries;
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+      fTsumwz = tsumwz; fTsumwz2 = tsumwz2;
+      return;
+   }
+
+   for (i=ifirst;i<ntimes;i+=stride) {
+      Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return bin content of a Profile2D histogram.
 
@@ -372,6 +372,20 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         if (allSameLimits) {
+            // same bins: add the arrays in separate loops, which can be vectorized
+            const Int_t n = h->fN;
+            const Double_t *hw = h->GetW(), *hw2 = h->GetW2(), *hb = h->GetB();
+            const Double_t *hb2 = h->GetB2() ? h->GetB2() : hb;
+            for (Int_t bin = 0; bin < n; ++bin) p->fArray[bin] += hw[bin];
+            for (Int_t bin = 0; bin < n; ++bin) p->fSumw2.fArray[bin] += hw2[bin];
+            for (Int_t bin = 0; bin < n; ++bin) p->fBinEntries.fArray[bin] += hb[bin];
+            if (p->fBinSumw2.fN) {
+               for (Int_t bin = 0; bin < n; ++bin) p->fBinSumw2.fArray[bin] += hb2[bin];
+            }
+            continue;
+         }
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
@@ -1045,6 +1045,18 @@ void TSpline3::BuildCoeff()
 {
    Int_t i, j, l, m;
    Double_t   divdf1,divdf3,dtau,g=0;
+   // equidistant knots given as arrays: let FindX compute the interval
+   // directly instead of doing a binary search
+   if (!fKstep && fNp > 2) {
+      Double_t delta = (fPoly[fNp-1].X() - fPoly[0].X())/(fNp-1);
+      Bool_t equidistant = delta > 0;
+      for (i = 1; equidistant && i < fNp-1; ++i)
+         equidistant = TMath::Abs(fPoly[i].X() - (fPoly[0].X() + i*delta)) <= 1.E-10*(fNp-1)*delta;
+      if (equidistant) {
+         fKstep = kTRUE;
+         fDelta = delta;
+      }
+   }
    //***** a tridiagonal linear system for the unknown slopes s(i) of
    //  f  at tau(i), i=1,...,n, is generated and then solved by gauss elim-
    //  ination, with s(i) ending up in c(2,i), all i.
@@ -275,6 +275,50 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheckAccuracyDemo)
    EXPECT_NEAR(0, result_num[2], /*abs_error*/1e-13);
 }
 
+TEST(TFormulaGradientPar, TF1GradientParAD)
+{
+   TF1 f("f1", "[0]*exp(-[1]*x) + [2]*x*x", 0, 10);
+   double p[] = {2, 0.5, 0.1};
+   f.SetParameters(p);
+   // The derivative wrt a fixed parameter is not 0, contrary to GradientPar.
+   f.FixParameter(2, 0.1);
+   double x[] = {1.5};
+   double grad[] = {-1, -1, -1};
+   ASSERT_TRUE(f.GradientParAD(x, grad));
+
+   EXPECT_FLOAT_EQ(std::exp(-0.5 * 1.5), grad[0]);
+   EXPECT_FLOAT_EQ(-2 * 1.5 * std::exp(-0.5 * 1.5), grad[1]);
+   EXPECT_FLOAT_EQ(1.5 * 1.5, grad[2]);
+
+   // Not available for functions which are not formula-based.
+   TF1 g("g", [](double *xx, double *pp) { return pp[0] * xx[0]; }, 0, 1, 1);
+   EXPECT_FALSE(g.GradientParAD(x, grad));
+}
+
+TEST(TFormulaGradientPar, FitWithGradient)
+{
+   TH1D h("h", "h", 50, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 100 * std::exp(-0.5 * (x - 0.3) * (x - 0.3) / 1.2 / 1.2) + 1);
+   }
+
+   TF1 f1("fitNum", "[0]*exp(-0.5*(x-[1])*(x-[1])/([2]*[2]))", -5, 5);
+   f1.SetParameters(80, 0, 1);
+   TF1 f2("fitGrad", "[0]*exp(-0.5*(x-[1])*(x-[1])/([2]*[2]))", -5, 5);
+   f2.SetParameters(80, 0, 1);
+
+   TFitResultPtr rNum = h.Fit(&f1, "Q N S");
+   TFitResultPtr rGrad = h.Fit(&f2, "Q N S G");
+   ASSERT_EQ(0, (int) rNum);
+   ASSERT_EQ(0, (int) rGrad);
+   // The gradient of the fit with option "G" was computed by clad.
+   EXPECT_FALSE(f1.GetFormula()->HasGeneratedGradient());
+   EXPECT_TRUE(f2.GetFormula()->HasGeneratedGradient());
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(f1.GetParameter(i), f2.GetParameter(i), 1e-3 * std::abs(f1.GetParameter(i)));
+}
+
 // FIXME: Add more: crystalball, cheb3, bigaus?
 
 // FIXME: Disable because of a known failure in -Druntime_cxxmodules=On.
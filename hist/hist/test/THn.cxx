@@ -3,6 +3,13 @@
 #include "THn.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "THnOnDisk.h"
+#include "THnSparse.h"
+#include "TFile.h"
+#include "TSystem.h"
+
+#include <memory>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -108,3 +115,249 @@ TEST(THn, Projection) {
 
 
 }
+
+// Bin index of THnSparse: lookups, growth and hash collisions
+TEST(THnSparse, BinIndex) {
+   // Small: the compact coordinate is used as the hash.
+   // Large: 10 dimensions of 1000 bins need more than 8 bytes per coordinate,
+   // so different coordinates can have the same hash.
+   for (Int_t dim : {2, 10}) {
+      std::vector<Int_t> bins(dim, dim == 2 ? 300 : 1000);
+      std::vector<Double_t> xmin(dim, 0.), xmax(dim, 1.);
+      THnSparseD hs("hs", "hs", dim, bins.data(), xmin.data(), xmax.data());
+
+      const Int_t n = 20000;
+      std::vector<Int_t> coord(dim);
+      // distinct coordinates for each i
+      auto setCoord = [&](Int_t i) {
+         coord[0] = 1 + i % bins[0];
+         coord[1] = 1 + (i / bins[0]) % bins[1];
+         for (Int_t d = 2; d < dim; ++d)
+            coord[d] = 1 + (i * (d + 7)) % bins[d];
+      };
+      std::vector<Long64_t> idx(n);
+      for (Int_t i = 0; i < n; ++i) {
+         setCoord(i);
+         idx[i] = hs.GetBin(coord.data(), kTRUE);
+         hs.AddBinContent(idx[i], i + 1.);
+      }
+      EXPECT_EQ(n, hs.GetNbins());
+      for (Int_t i = 0; i < n; ++i) {
+         setCoord(i);
+         EXPECT_EQ(idx[i], hs.GetBin(coord.data(), kFALSE));
+         EXPECT_DOUBLE_EQ(i + 1., hs.GetBinContent(idx[i]));
+      }
+      coord.assign(dim, bins[0]);
+      EXPECT_EQ(-1, hs.GetBin(coord.data(), kFALSE));
+
+      hs.Reset();
+      EXPECT_EQ(0, hs.GetNbins());
+      EXPECT_EQ(-1, hs.GetBin(coord.data(), kFALSE));
+   }
+}
+
+// Batched filling gives the same result as filling one by one
+TEST(THnSparse, FillN) {
+   Int_t bins[3] = {20, 30, 40};
+   Double_t xmin[3] = {0., -3., 0.};
+   Double_t xmax[3] = {10., 3., 1.};
+   THnSparseD hs1("hs1", "hs1", 3, bins, xmin, xmax);
+   THnSparseD hs2("hs2", "hs2", 3, bins, xmin, xmax);
+   hs1.Sumw2();
+   hs2.Sumw2();
+
+   const Int_t n = 1000;
+   std::vector<Double_t> x(3 * n), w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[3 * i] = (i % 23) * 0.47;
+      x[3 * i + 1] = -3.2 + (i % 31) * 0.21;
+      x[3 * i + 2] = (i % 37) * 0.028;
+      w[i] = 0.5 + (i % 5);
+      hs1.Fill(&x[3 * i], w[i]);
+   }
+   hs2.FillN(n, x.data(), w.data());
+
+   EXPECT_EQ(hs1.GetNbins(), hs2.GetNbins());
+   EXPECT_DOUBLE_EQ(hs1.GetEntries(), hs2.GetEntries());
+   Int_t coord[3];
+   for (Long64_t i = 0; i < hs1.GetNbins(); ++i) {
+      Double_t v = hs1.GetBinContent(i, coord);
+      Long64_t j = hs2.GetBin(coord, kFALSE);
+      ASSERT_GE(j, 0);
+      EXPECT_DOUBLE_EQ(v, hs2.GetBinContent(j));
+      EXPECT_DOUBLE_EQ(hs1.GetBinError(i), hs2.GetBinError(j));
+   }
+}
+
+// Out-of-core THn with few resident chunks gives the same results as THnD
+TEST(THnOnDisk, SameAsTHn) {
+   Int_t bins[3] = {10, 6, 8};
+   Double_t xmin[3] = {0., -3., 0.};
+   Double_t xmax[3] = {10., 3., 1.};
+   THnD hn("hn", "hn", 3, bins, xmin, xmax);
+   // 12 * 8 * 10 bins in chunks of 37 bins, at most 2 of them in memory
+   THnOnDiskD hd("hd", "hd", 3, bins, xmin, xmax, 0 /*temporary file*/, 37, 2);
+   hn.Sumw2();
+   hd.Sumw2();
+
+   for (Int_t i = 0; i < 5000; ++i) {
+      Double_t x[3] = {(i % 23) * 0.47, -3.2 + (i % 31) * 0.21, (i % 37) * 0.028};
+      hn.Fill(x, 0.5 + (i % 5));
+      hd.Fill(x, 0.5 + (i % 5));
+   }
+
+   ASSERT_EQ(hn.GetNbins(), hd.GetNbins());
+   EXPECT_DOUBLE_EQ(hn.GetEntries(), hd.GetEntries());
+   for (Long64_t i = 0; i < hn.GetNbins(); ++i) {
+      EXPECT_DOUBLE_EQ(hn.GetBinContent(i), hd.GetBinContent(i));
+      EXPECT_DOUBLE_EQ(hn.GetBinError2(i), hd.GetBinError2(i));
+   }
+
+   TH1D* pn = hn.Projection(1);
+   TH1D* pd = hd.Projection(1);
+   for (Int_t i = 0; i <= pn->GetNbinsX() + 1; ++i)
+      EXPECT_DOUBLE_EQ(pn->GetBinContent(i), pd->GetBinContent(i));
+   delete pn;
+   delete pd;
+
+   hd.Reset();
+   for (Long64_t i = 0; i < hd.GetNbins(); ++i)
+      EXPECT_DOUBLE_EQ(0., hd.GetBinContent(i));
+}
+
+// Writing an out-of-core THn stores its bin contents in the ROOT file
+TEST(THnOnDisk, WriteRead) {
+   Int_t bins[2] = {20, 30};
+   Double_t xmin[2] = {0., 0.};
+   Double_t xmax[2] = {1., 1.};
+   const char* rootFile = "THnOnDisk_WriteRead.root";
+   const char* backingFile = "THnOnDisk_WriteRead.bins";
+
+   {
+      THnOnDiskF hd("hd", "hd", 2, bins, xmin, xmax, backingFile, 50, 3);
+      for (Int_t i = 0; i < 1000; ++i) {
+         Double_t x[2] = {(i % 21) * 0.049, (i % 29) * 0.035};
+         hd.Fill(x, 1. + (i % 3));
+      }
+      TFile f(rootFile, "RECREATE");
+      hd.Write();
+   }
+   // the ROOT file does not need the backing files
+   gSystem->Unlink(backingFile);
+   gSystem->Unlink(TString(backingFile) + ".sumw2");
+
+   THnD hn("hn", "hn", 2, bins, xmin, xmax);
+   for (Int_t i = 0; i < 1000; ++i) {
+      Double_t x[2] = {(i % 21) * 0.049, (i % 29) * 0.035};
+      hn.Fill(x, 1. + (i % 3));
+   }
+
+   {
+      TFile f(rootFile);
+      THnOnDiskF* hd = nullptr;
+      f.GetObject("hd", hd);
+      ASSERT_NE(nullptr, hd);
+      EXPECT_DOUBLE_EQ(hn.GetEntries(), hd->GetEntries());
+      for (Long64_t i = 0; i < hn.GetNbins(); ++i)
+         EXPECT_FLOAT_EQ(hn.GetBinContent(i), hd->GetBinContent(i));
+      delete hd;
+   }
+
+   gSystem->Unlink(rootFile);
+   gSystem->Unlink(backingFile);
+   gSystem->Unlink(TString(backingFile) + ".sumw2");
+}
+
+// A backing file passed to the constructor keeps its content
+TEST(THnOnDisk, ExistingBackingFile) {
+   Int_t bins[1] = {100};
+   Double_t xmin[1] = {0.};
+   Double_t xmax[1] = {1.};
+   const char* backingFile = "THnOnDisk_Existing.bins";
+   {
+      THnOnDiskD hd("hd", "hd", 1, bins, xmin, xmax, backingFile, 10, 2);
+      Double_t x[1] = {0.55};
+      hd.Fill(x, 3.);
+   }
+   {
+      THnOnDiskD hd("hd", "hd", 1, bins, xmin, xmax, backingFile, 10, 2);
+      EXPECT_DOUBLE_EQ(3., hd.GetBinContent(56));
+   }
+   gSystem->Unlink(backingFile);
+   gSystem->Unlink(TString(backingFile) + ".sumw2");
+}
+
+// A clone has its own backing file
+TEST(THnOnDisk, Clone) {
+   Int_t bins[1] = {100};
+   Double_t xmin[1] = {0.};
+   Double_t xmax[1] = {1.};
+   THnOnDiskD hd("hd", "hd", 1, bins, xmin, xmax, 0, 10, 2);
+   Double_t x[1] = {0.55};
+   hd.Fill(x, 3.);
+
+   TString cloneFile;
+   {
+      std::unique_ptr<THnOnDiskD> clone(static_cast<THnOnDiskD*>(hd.Clone("clone")));
+      EXPECT_DOUBLE_EQ(3., clone->GetBinContent(56));
+      clone->Fill(x, 2.);
+      EXPECT_DOUBLE_EQ(5., clone->GetBinContent(56));
+      auto& array = static_cast<const TNDArrayOnDisk&>(clone->GetArray());
+      cloneFile = array.GetFileName();
+      EXPECT_NE(cloneFile, TString(static_cast<const TNDArrayOnDisk&>(hd.GetArray()).GetFileName()));
+   }
+   EXPECT_DOUBLE_EQ(3., hd.GetBinContent(56));
+   hd.Fill(x, 1.);
+   EXPECT_DOUBLE_EQ(4., hd.GetBinContent(56));
+   // the temporary file of the clone is removed with it
+   EXPECT_TRUE(gSystem->AccessPathName(cloneFile));
+}
+
+// Writing an out-of-core THn with temporary backing files does not leave them
+// behind, and the one read back does not modify the backing file it was written from
+TEST(THnOnDisk, TemporaryBackingFiles) {
+   Int_t bins[1] = {100};
+   Double_t xmin[1] = {0.};
+   Double_t xmax[1] = {1.};
+   Double_t x[1] = {0.55};
+   const char* rootFile = "THnOnDisk_Temporary.root";
+   const char* backingFile = "THnOnDisk_Temporary.bins";
+
+   TString tempFile;
+   {
+      THnOnDiskD hd("hd", "hd", 1, bins, xmin, xmax, 0, 10, 2);
+      hd.Fill(x, 3.);
+      tempFile = static_cast<const TNDArrayOnDisk&>(hd.GetArray()).GetFileName();
+      TFile f(rootFile, "RECREATE");
+      hd.Write();
+      THnOnDiskD he("he", "he", 1, bins, xmin, xmax, backingFile, 10, 2);
+      he.Fill(x, 4.);
+      he.Write();
+   }
+   EXPECT_FALSE(tempFile.IsNull());
+   EXPECT_TRUE(gSystem->AccessPathName(tempFile));
+
+   for (const char* name: {"hd", "he"}) {
+      TFile f(rootFile);
+      std::unique_ptr<THnOnDiskD> hd(f.Get<THnOnDiskD>(name));
+      ASSERT_NE(nullptr, hd);
+      const Double_t content = hd->GetBinContent(56);
+      EXPECT_DOUBLE_EQ(name[1] == 'd' ? 3. : 4., content);
+      EXPECT_DOUBLE_EQ(0., hd->GetBinContent(10));
+      auto& array = static_cast<const TNDArrayOnDisk&>(hd->GetArray());
+      EXPECT_NE(TString(backingFile), TString(array.GetFileName()));
+      hd->Fill(x, 2.);
+      EXPECT_DOUBLE_EQ(content + 2., hd->GetBinContent(56));
+      tempFile = array.GetFileName();
+   }
+   EXPECT_TRUE(gSystem->AccessPathName(tempFile));
+
+   {
+      THnOnDiskD he("he", "he", 1, bins, xmin, xmax, backingFile, 10, 2);
+      EXPECT_DOUBLE_EQ(4., he.GetBinContent(56));
+   }
+
+   gSystem->Unlink(rootFile);
+   gSystem->Unlink(backingFile);
+   gSystem->Unlink(TString(backingFile) + ".sumw2");
+}
@@ -0,0 +1,211 @@
+#include "gtest/gtest.h"
+
+#include "TConcurrentEfficiency.h"
+#include "TConcurrentHist.h"
+#include "TEfficiency.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TProfile3D.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Fill from several threads and compare with a sequential fill
+static void CheckConcurrentFill(TConcurrentHist::EStorage storage)
+{
+   const int nthreads = 4;
+   const int n = 10000;
+   TH2D ref("ref", "ref", 20, -1., 1., 10, -1., 1.);
+   TConcurrentHist ch(ref, storage, 2);
+
+   auto value = [](int t, int i, int c) { return -1.2 + 2.4 * ((i * 31 + t * 17 + c * 7) % 97) / 96.; };
+   auto weight = [](int t, int i) { return 0.5 + ((i + t) % 3); };
+
+   std::vector<std::thread> pool;
+   for (int t = 0; t < nthreads; ++t) {
+      pool.emplace_back([&, t]() {
+         for (int i = 0; i < n; ++i) {
+            Double_t x[2] = {value(t, i, 0), value(t, i, 1)};
+            ch.Fill(x, weight(t, i));
+         }
+      });
+   }
+   for (auto &th : pool)
+      th.join();
+
+   for (int t = 0; t < nthreads; ++t)
+      for (int i = 0; i < n; ++i)
+         ref.Fill(value(t, i, 0), value(t, i, 1), weight(t, i));
+
+   std::unique_ptr<TH1> h(ch.Merge("merged"));
+   EXPECT_EQ(TH2D::Class(), h->IsA());
+   EXPECT_EQ(nthreads * n, h->GetEntries());
+   EXPECT_EQ(nthreads * n, ch.GetEntries());
+   for (int bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_NEAR(ref.GetBinContent(bin), h->GetBinContent(bin), 1E-9);
+      EXPECT_NEAR(ref.GetBinError(bin), h->GetBinError(bin), 1E-9);
+   }
+   EXPECT_NEAR(ref.GetMean(1), h->GetMean(1), 1E-9);
+   EXPECT_NEAR(ref.GetMean(2), h->GetMean(2), 1E-9);
+   EXPECT_NEAR(ref.GetRMS(2), h->GetRMS(2), 1E-9);
+
+   ch.Reset();
+   std::unique_ptr<TH1> empty(ch.Merge());
+   EXPECT_EQ(0, empty->GetEntries());
+   EXPECT_EQ(0, empty->GetSumOfWeights());
+}
+
+TEST(TConcurrentHist, Sharded)
+{
+   CheckConcurrentFill(TConcurrentHist::kSharded);
+}
+
+TEST(TConcurrentHist, Atomic)
+{
+   CheckConcurrentFill(TConcurrentHist::kAtomic);
+}
+
+TEST(TConcurrentHist, Fill1D)
+{
+   TH1F model("model", "model", 10, 0., 10.);
+   TConcurrentHist ch(model);
+   EXPECT_EQ(4, ch.Fill(3.5));
+   EXPECT_EQ(0, ch.Fill(-1.));
+   std::unique_ptr<TH1> h(ch.Merge());
+   EXPECT_EQ(TH1F::Class(), h->IsA());
+   EXPECT_EQ(1., h->GetBinContent(4));
+   EXPECT_EQ(1., h->GetBinContent(0));
+   EXPECT_EQ(2., h->GetEntries());
+   EXPECT_EQ(3.5, h->GetMean());
+}
+
+// Each of the first threads filling an object gets a shard of its own, whatever
+// other objects it filled before; further threads share one more shard
+TEST(TConcurrentHist, ShardPerThread)
+{
+   TH1D model("model", "model", 100, 0., 1.);
+   TConcurrentHist other(model, TConcurrentHist::kSharded, 2);
+   TConcurrentHist ch(model, TConcurrentHist::kSharded, 2);
+   EXPECT_EQ(2u, ch.GetNShards());
+   const ULong64_t empty = ch.GetMemoryUsage();
+   const ULong64_t shardBins = model.GetNcells() * 2 * sizeof(Double_t);
+
+   auto fillInThread = [](TConcurrentHist &h) { std::thread([&h]() { h.Fill(0.5); }).join(); };
+   fillInThread(other);
+   fillInThread(ch);
+   EXPECT_EQ(empty + shardBins, ch.GetMemoryUsage());
+   fillInThread(other);
+   fillInThread(ch);
+   EXPECT_EQ(empty + 2 * shardBins, ch.GetMemoryUsage());
+   // the shared shard
+   fillInThread(ch);
+   EXPECT_EQ(empty + 3 * shardBins, ch.GetMemoryUsage());
+   fillInThread(ch);
+   fillInThread(ch);
+   EXPECT_EQ(empty + 3 * shardBins, ch.GetMemoryUsage());
+
+   std::unique_ptr<TH1> h(ch.Merge());
+   EXPECT_EQ(5., h->GetBinContent(51));
+   EXPECT_EQ(5., h->GetEntries());
+}
+
+// The bins filled with atomic additions take the same memory for any number of threads
+TEST(TConcurrentHist, AtomicMemory)
+{
+   TH2D model("model", "model", 100, 0., 1., 100, 0., 1.);
+   TConcurrentHist ch(model, TConcurrentHist::kAtomic, 2);
+   const ULong64_t empty = ch.GetMemoryUsage();
+   EXPECT_GT(empty, model.GetNcells() * 3 * sizeof(Double_t));
+   for (int t = 0; t < 4; ++t)
+      std::thread([&ch]() { Double_t x[2] = {0.5, 0.5}; ch.Fill(x); }).join();
+   EXPECT_EQ(empty, ch.GetMemoryUsage());
+}
+
+// Unsupported models give an object that refuses fills
+TEST(TConcurrentHist, UnsupportedModel)
+{
+   TProfile3D model("model", "model", 2, 0., 1., 2, 0., 1., 2, 0., 1.);
+   TConcurrentHist ch(model);
+   EXPECT_FALSE(ch.IsValid());
+   Double_t x[4] = {0.5, 0.5, 0.5, 1.};
+   EXPECT_EQ(-1, ch.Fill(x));
+   EXPECT_EQ(nullptr, ch.Merge());
+}
+
+// Profiles: the profiled value follows the coordinates
+TEST(TConcurrentHist, Profile)
+{
+   const int nthreads = 4;
+   const int n = 5000;
+   TProfile ref("pref", "pref", 20, -1., 1., -0.5, 0.5);
+   TConcurrentHist ch(ref, TConcurrentHist::kSharded, 2);
+   EXPECT_TRUE(ch.IsProfile());
+
+   auto value = [](int t, int i, int c) { return -1.2 + 2.4 * ((i * 31 + t * 17 + c * 7) % 97) / 96.; };
+   auto weight = [](int t, int i) { return 0.5 + ((i + t) % 3); };
+
+   std::vector<std::thread> pool;
+   for (int t = 0; t < nthreads; ++t) {
+      pool.emplace_back([&, t]() {
+         for (int i = 0; i < n; ++i) {
+            Double_t v[2] = {value(t, i, 0), value(t, i, 1)};
+            ch.Fill(v, weight(t, i));
+         }
+      });
+   }
+   for (auto &th : pool)
+      th.join();
+
+   for (int t = 0; t < nthreads; ++t)
+      for (int i = 0; i < n; ++i)
+         ref.Fill(value(t, i, 0), value(t, i, 1), weight(t, i));
+
+   std::unique_ptr<TH1> h(ch.Merge("pmerged"));
+   EXPECT_EQ(TProfile::Class(), h->IsA());
+   EXPECT_EQ(ref.GetEntries(), h->GetEntries());
+   auto p = static_cast<TProfile *>(h.get());
+   for (int bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_NEAR(ref.GetBinContent(bin), p->GetBinContent(bin), 1E-9);
+      EXPECT_NEAR(ref.GetBinError(bin), p->GetBinError(bin), 1E-9);
+      EXPECT_NEAR(ref.GetBinEffectiveEntries(bin), p->GetBinEffectiveEntries(bin), 1E-9);
+   }
+   EXPECT_NEAR(ref.GetMean(1), h->GetMean(1), 1E-9);
+   EXPECT_NEAR(ref.GetMean(2), h->GetMean(2), 1E-9);
+}
+
+// Efficiencies filled from several threads
+TEST(TConcurrentEfficiency, Fill)
+{
+   const int nthreads = 4;
+   const int n = 5000;
+   TEfficiency ref("eref", "eref;x;y", 10, 0., 1., 5, 0., 1.);
+   TConcurrentEfficiency ce(ref, TConcurrentHist::kAtomic);
+
+   auto value = [](int t, int i, int c) { return ((i * 31 + t * 17 + c * 7) % 97) / 96.; };
+   auto passed = [](int t, int i) { return (i * 13 + t) % 7 < 4; };
+
+   std::vector<std::thread> pool;
+   for (int t = 0; t < nthreads; ++t) {
+      pool.emplace_back([&, t]() {
+         for (int i = 0; i < n; ++i)
+            ce.Fill(passed(t, i), value(t, i, 0), value(t, i, 1));
+      });
+   }
+   for (auto &th : pool)
+      th.join();
+
+   for (int t = 0; t < nthreads; ++t)
+      for (int i = 0; i < n; ++i)
+         ref.Fill(passed(t, i), value(t, i, 0), value(t, i, 1));
+
+   std::unique_ptr<TEfficiency> eff(ce.Merge());
+   EXPECT_STREQ("eref", eff->GetName());
+   EXPECT_FALSE(eff->UsesWeights());
+   EXPECT_EQ(ref.GetTotalHistogram()->GetEntries(), eff->GetTotalHistogram()->GetEntries());
+   for (int bin = 0; bin < ref.GetTotalHistogram()->GetNcells(); ++bin) {
+      EXPECT_EQ(ref.GetTotalHistogram()->GetBinContent(bin), eff->GetTotalHistogram()->GetBinContent(bin));
+      EXPECT_EQ(ref.GetPassedHistogram()->GetBinContent(bin), eff->GetPassedHistogram()->GetBinContent(bin));
+   }
+}
@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+
+#include "TGraph.h"
+#include "TSpline.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Eval on sorted, equidistant and unsorted points
+TEST(TGraph, Eval)
+{
+   // equidistant points
+   TGraph g1;
+   for (int i = 0; i < 11; ++i)
+      g1.SetPoint(i, 0.1 * i, 2. * i);
+   EXPECT_DOUBLE_EQ(0., g1.Eval(0.));
+   EXPECT_DOUBLE_EQ(7., g1.Eval(0.35));
+   EXPECT_DOUBLE_EQ(8., g1.Eval(0.4));
+   EXPECT_DOUBLE_EQ(20., g1.Eval(1.));
+   EXPECT_DOUBLE_EQ(-2., g1.Eval(-0.1));
+   EXPECT_DOUBLE_EQ(22., g1.Eval(1.1));
+
+   // same points, unsorted
+   TGraph g2;
+   for (int i = 0; i < 11; ++i)
+      g2.SetPoint(i, 0.1 * ((3 * i) % 11), 2. * ((3 * i) % 11));
+   for (double x : {-0.1, 0., 0.35, 0.4, 0.77, 1., 1.1})
+      EXPECT_NEAR(g1.Eval(x), g2.Eval(x), 1.E-12);
+
+   // sorted, not equidistant
+   double x3[] = {0., 1., 3., 6.};
+   double y3[] = {0., 1., 3., 6.};
+   TGraph g3(4, x3, y3);
+   EXPECT_DOUBLE_EQ(2., g3.Eval(2.));
+   EXPECT_DOUBLE_EQ(5.5, g3.Eval(5.5));
+   EXPECT_DOUBLE_EQ(7., g3.Eval(7.));
+}
+
+// The cached order of the points is updated when they are modified
+TEST(TGraph, EvalAfterModification)
+{
+   TGraph g;
+   for (int i = 0; i < 5; ++i)
+      g.SetPoint(i, i, i);
+   EXPECT_DOUBLE_EQ(2.5, g.Eval(2.5));
+
+   // no longer equidistant
+   g.SetPoint(4, 10., 10.);
+   EXPECT_DOUBLE_EQ(6.5, g.Eval(6.5));
+
+   // no longer sorted
+   g.SetPoint(0, 20., 0.);
+   EXPECT_DOUBLE_EQ(5., g.Eval(15.));
+
+   g.RemovePoint(0);
+   EXPECT_DOUBLE_EQ(6.5, g.Eval(6.5));
+
+   // direct modification of the points, which are no longer sorted
+   g.GetX()[3] = 0.;
+   g.GetY()[3] = 0.;
+   EXPECT_DOUBLE_EQ(0.5, g.Eval(0.5));
+
+   // direct modification of the points, which are now equidistant
+   for (int i = 0; i < g.GetN(); ++i) {
+      g.GetX()[i] = i;
+      g.GetY()[i] = 2 * i;
+   }
+   EXPECT_DOUBLE_EQ(3., g.Eval(1.5));
+}
+
+// The spline of option "S" is reused and rebuilt after modifications
+TEST(TGraph, EvalSpline)
+{
+   const int n = 20;
+   TGraph g;
+   for (int i = 0; i < n; ++i)
+      g.SetPoint(i, i, i * i);
+   TSpline3 spline("spline", &g);
+   for (double x : {0.5, 3.2, 10., 18.7})
+      EXPECT_DOUBLE_EQ(spline.Eval(x), g.Eval(x, nullptr, "S"));
+
+   g.SetPoint(n - 1, n - 1, 0.);
+   TSpline3 spline2("spline2", &g);
+   EXPECT_DOUBLE_EQ(spline2.Eval(18.7), g.Eval(18.7, nullptr, "S"));
+   EXPECT_NE(spline.Eval(18.7), g.Eval(18.7, nullptr, "S"));
+
+   // modification through GetY()
+   g.GetY()[n - 1] = 100.;
+   TSpline3 spline3("spline3", &g);
+   EXPECT_DOUBLE_EQ(spline3.Eval(18.7), g.Eval(18.7, nullptr, "S"));
+}
+
+// EvalN gives the same results as Eval
+TEST(TGraph, EvalN)
+{
+   TGraph g;
+   for (int i = 0; i < 10; ++i)
+      g.SetPoint(i, i, i * i);
+   std::vector<double> x{-1., 0., 2.5, 7.2, 9., 12.};
+   std::vector<double> y(x.size());
+   for (const char *opt : {"", "S"}) {
+      g.EvalN(x.size(), x.data(), y.data(), opt);
+      for (size_t i = 0; i < x.size(); ++i)
+         EXPECT_DOUBLE_EQ(g.Eval(x[i], nullptr, opt), y[i]);
+   }
+}
+
+// Concurrent Eval calls share the cached spline, also when one of them replaces it
+TEST(TGraph, EvalConcurrent)
+{
+   TGraph g;
+   for (int i = 0; i < 50; ++i)
+      g.SetPoint(i, i, std::sin(0.1 * i));
+   TSpline3 spline("spline", &g);
+   const double expected = spline.Eval(12.3);
+   const double expectedLinear = g.GetY()[12] + 0.5 * (g.GetY()[13] - g.GetY()[12]);
+   EXPECT_NEAR(expectedLinear, g.Eval(12.5), 1.E-15);
+   const double linear = g.Eval(12.5);
+
+   std::vector<std::thread> threads;
+   std::vector<int> failures(4, 0);
+   for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&g, &failures, expected, linear, t]() {
+         for (int i = 0; i < 1000; ++i) {
+            if (g.Eval(12.3, nullptr, "S") != expected)
+               ++failures[t];
+            if (g.Eval(12.5) != linear)
+               ++failures[t];
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   for (int f : failures)
+      EXPECT_EQ(0, f);
+}
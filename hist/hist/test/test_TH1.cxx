@@ -2,6 +2,19 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TEfficiency.h"
+#include "TList.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+#include "TROOT.h"
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +43,320 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// Values covering underflows, overflows, bin edges and NaN
+static std::vector<double> FillNValues(int n, int seed)
+{
+   std::vector<double> v(n);
+   for (int i = 0; i < n; ++i)
+      v[i] = -1.5 + 0.25 * ((i * 7919 + seed * 104729) % 61);
+   v[n / 2] = std::numeric_limits<double>::quiet_NaN();
+   return v;
+}
+
+// FillN gives the same contents, errors and statistics as Fill
+TEST(TH1, FillNSameAsFill)
+{
+   const int n = 1000;
+   auto x = FillNValues(n, 1);
+   auto y = FillNValues(n, 2);
+   auto z = FillNValues(n, 3);
+   auto w = FillNValues(n, 4);
+   w[n / 2] = 2.;
+   const double edges[] = {-1., 0., 0.5, 2., 5., 6.};
+
+   TH1D h1a("h1a", "", 20, -1, 6), h1b("h1b", "", 20, -1, 6);
+   TH1D v1a("v1a", "", 5, edges), v1b("v1b", "", 5, edges);
+   TH2D h2a("h2a", "", 8, -1, 6, 5, edges), h2b("h2b", "", 8, -1, 6, 5, edges);
+   TH3D h3a("h3a", "", 4, -1, 6, 5, -1, 6, 6, -1, 6), h3b("h3b", "", 4, -1, 6, 5, -1, 6, 6, -1, 6);
+   for (int i = 0; i < n; ++i) {
+      h1a.Fill(x[i], w[i]);
+      v1a.Fill(x[i], w[i]);
+      h2a.Fill(x[i], y[i], w[i]);
+      h3a.Fill(x[i], y[i], z[i], w[i]);
+   }
+   h1b.FillN(n, x.data(), w.data());
+   v1b.FillN(n, x.data(), w.data());
+   h2b.FillN(n, x.data(), y.data(), w.data());
+   h3b.FillN(n, x.data(), y.data(), z.data(), w.data());
+
+   std::vector<std::pair<TH1 *, TH1 *>> pairs = {{&h1a, &h1b}, {&v1a, &v1b}, {&h2a, &h2b}, {&h3a, &h3b}};
+   for (auto &hh : pairs) {
+      TH1 *a = hh.first, *b = hh.second;
+      EXPECT_EQ(a->GetEntries(), b->GetEntries());
+      for (int bin = 0; bin < a->GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(a->GetBinContent(bin), b->GetBinContent(bin));
+         EXPECT_DOUBLE_EQ(a->GetBinError(bin), b->GetBinError(bin));
+      }
+      double sa[TH1::kNstat], sb[TH1::kNstat];
+      a->GetStats(sa);
+      b->GetStats(sb);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         EXPECT_DOUBLE_EQ(sa[i], sb[i]);
+   }
+}
+
+// Compare contents, errors, entries and statistics of two histograms
+static void ExpectSameHistograms(const TH1 &a, const TH1 &b)
+{
+   EXPECT_EQ(a.GetEntries(), b.GetEntries());
+   for (int bin = 0; bin < a.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(a.GetBinContent(bin), b.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(a.GetBinError(bin), b.GetBinError(bin));
+   }
+   double sa[TH1::kNstat], sb[TH1::kNstat];
+   a.GetStats(sa);
+   b.GetStats(sb);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_DOUBLE_EQ(sa[i], sb[i]);
+}
+
+// Profile FillN gives the same profile as Fill, also for values outside the range
+TEST(TProfile, FillNSameAsFill)
+{
+   const int n = 1000;
+   auto x = FillNValues(n, 1);
+   auto y = FillNValues(n, 2);
+   auto z = FillNValues(n, 3);
+   auto w = FillNValues(n, 4);
+   w[n / 2] = 2.;
+
+   TProfile p1a("p1a", "", 20, -1, 6, -1, 5), p1b("p1b", "", 20, -1, 6, -1, 5);
+   TProfile2D p2a("p2a", "", 8, -1, 6, 5, -1, 6, -1, 5), p2b("p2b", "", 8, -1, 6, 5, -1, 6, -1, 5);
+   for (int i = 0; i < n; ++i) {
+      p1a.Fill(x[i], y[i], w[i]);
+      p2a.Fill(x[i], y[i], z[i], w[i]);
+   }
+   p1b.FillN(n, x.data(), y.data(), w.data());
+   p2b.FillN(n, x.data(), y.data(), z.data(), w.data());
+
+   ExpectSameHistograms(p1a, p1b);
+   ExpectSameHistograms(p2a, p2b);
+   for (int bin = 0; bin < p1a.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(p1a.GetBinEffectiveEntries(bin), p1b.GetBinEffectiveEntries(bin));
+   for (int bin = 0; bin < p2a.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(p2a.GetBinEffectiveEntries(bin), p2b.GetBinEffectiveEntries(bin));
+}
+
+// TEfficiency::FillN gives the same histograms as Fill and FillWeighted
+TEST(TEfficiency, FillNSameAsFill)
+{
+   const int n = 1000;
+   auto x = FillNValues(n, 1);
+   auto y = FillNValues(n, 2);
+   auto w = FillNValues(n, 4);
+   w[n / 2] = 2.;
+   std::unique_ptr<Bool_t[]> passed(new Bool_t[n]);
+   for (int i = 0; i < n; ++i)
+      passed[i] = (i * 13) % 7 < 4;
+
+   TEfficiency e1a("e1a", "", 20, -1, 6), e1b("e1b", "", 20, -1, 6);
+   TEfficiency e2a("e2a", "", 8, -1, 6, 5, -1, 6), e2b("e2b", "", 8, -1, 6, 5, -1, 6);
+   for (int i = 0; i < n; ++i) {
+      e1a.Fill(passed[i], x[i]);
+      e2a.FillWeighted(passed[i], w[i], x[i], y[i]);
+   }
+   e1b.FillN(n, passed.get(), x.data());
+   e2b.FillN(n, passed.get(), x.data(), y.data(), nullptr, w.data());
+
+   EXPECT_FALSE(e1b.UsesWeights());
+   EXPECT_TRUE(e2b.UsesWeights());
+   ExpectSameHistograms(*e1a.GetTotalHistogram(), *e1b.GetTotalHistogram());
+   ExpectSameHistograms(*e1a.GetPassedHistogram(), *e1b.GetPassedHistogram());
+   ExpectSameHistograms(*e2a.GetTotalHistogram(), *e2b.GetTotalHistogram());
+   ExpectSameHistograms(*e2a.GetPassedHistogram(), *e2b.GetPassedHistogram());
+}
+
+// FillN adds the statistics of the events to the ones computed from the bin
+// contents, when the statistics are not available after SetTotalEvents
+TEST(TEfficiency, FillNAfterSetEvents)
+{
+   const int n = 100;
+   auto x = FillNValues(n, 1);
+   std::unique_ptr<Bool_t[]> passed(new Bool_t[n]);
+   for (int i = 0; i < n; ++i)
+      passed[i] = i % 3 != 0;
+
+   TEfficiency eff("eff", "", 10, -1, 6);
+   eff.SetTotalEvents(3, 10);
+   eff.SetPassedEvents(3, 5);
+   const TH1 *hists[2] = {eff.GetTotalHistogram(), eff.GetPassedHistogram()};
+   double before[2][TH1::kNstat];
+   double entriesBefore[2];
+   for (int k = 0; k < 2; ++k) {
+      hists[k]->GetStats(before[k]);
+      entriesBefore[k] = hists[k]->GetEntries();
+   }
+
+   TEfficiency events("events", "", 10, -1, 6);
+   events.FillN(n, passed.get(), x.data());
+   eff.FillN(n, passed.get(), x.data());
+
+   const TH1 *eventHists[2] = {events.GetTotalHistogram(), events.GetPassedHistogram()};
+   for (int k = 0; k < 2; ++k) {
+      double added[TH1::kNstat], after[TH1::kNstat];
+      eventHists[k]->GetStats(added);
+      hists[k]->GetStats(after);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         EXPECT_DOUBLE_EQ(before[k][i] + added[i], after[i]);
+      EXPECT_EQ(entriesBefore[k] + eventHists[k]->GetEntries(), hists[k]->GetEntries());
+   }
+}
+
+// Merging a list of TEfficiency gives the same result as adding them one by one
+TEST(TEfficiency, Merge)
+{
+   TEfficiency ref("ref", "", 10, 0, 10);
+   TEfficiency merged("merged", "", 10, 0, 10);
+   TList list;
+   for (int i = 0; i < 4; ++i) {
+      auto eff = new TEfficiency(TString::Format("e%d", i).Data(), "", 10, 0, 10);
+      for (int j = 0; j < 100; ++j)
+         eff->Fill((j * 3 + i) % 4 != 0, (j * 7 + i) % 12 - 1);
+      eff->SetWeight(1. + i);
+      list.Add(eff);
+   }
+   for (auto obj : list)
+      ref += *static_cast<TEfficiency *>(obj);
+   merged.Merge(&list);
+
+   EXPECT_DOUBLE_EQ(ref.GetWeight(), merged.GetWeight());
+   ExpectSameHistograms(*ref.GetTotalHistogram(), *merged.GetTotalHistogram());
+   ExpectSameHistograms(*ref.GetPassedHistogram(), *merged.GetPassedHistogram());
+   list.Delete();
+}
+
+// Merging histograms with the same axes adds the bin arrays
+TEST(TH1, MergeSameAxes)
+{
+   TH2F h0("h0", "", 10, 0, 10, 5, 0, 5);
+   TH2F ref("ref", "", 10, 0, 10, 5, 0, 5);
+   h0.Sumw2();
+   ref.Sumw2();
+   TList list;
+   for (int i = 0; i < 5; ++i) {
+      auto h = new TH2F(TString::Format("h%d", i + 1).Data(), "", 10, 0, 10, 5, 0, 5);
+      if (i % 2)
+         h->Sumw2();
+      for (int j = 0; j < 100; ++j)
+         h->Fill((j * 7 + i) % 12 - 1, (j * 3 + i) % 6, 1 + i % 3);
+      list.Add(h);
+   }
+   for (auto h : list) {
+      ref.Add(static_cast<TH1 *>(h));
+   }
+   h0.Merge(&list);
+   EXPECT_EQ(ref.GetEntries(), h0.GetEntries());
+   for (int bin = 0; bin < ref.GetNcells(); ++bin) {
+      EXPECT_FLOAT_EQ(ref.GetBinContent(bin), h0.GetBinContent(bin));
+      EXPECT_FLOAT_EQ(ref.GetBinError(bin), h0.GetBinError(bin));
+   }
+   EXPECT_DOUBLE_EQ(ref.GetMean(1), h0.GetMean(1));
+   EXPECT_DOUBLE_EQ(ref.GetMean(2), h0.GetMean(2));
+   list.Delete();
+}
+
+// Merging profiles with the same bins adds the bin arrays. Inputs with and without
+// bin sum of weights squared give the same result as filling all values in one profile.
+template <class PROFILE, class MAKE, class FILL>
+void CheckProfileMergeSameLimits(MAKE make, FILL fill)
+{
+   std::unique_ptr<PROFILE> ref(make("ref")), p0(make("p0"));
+   ref->Sumw2();
+   p0->Sumw2();
+   TList list;
+   for (int i = 0; i < 4; ++i) {
+      PROFILE *p = make(TString::Format("p%d", i + 1).Data());
+      // the values are integers, so that all sums are exact
+      const double w = (i % 2) ? 2. : 1.;
+      if (i % 2)
+         p->Sumw2();
+      for (int j = 0; j < 200; ++j) {
+         fill(*p, i, j, w);
+         fill(*ref, i, j, w);
+      }
+      list.Add(p);
+   }
+   p0->Merge(&list);
+   EXPECT_EQ(ref->GetEntries(), p0->GetEntries());
+   for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(ref->GetBinContent(bin), p0->GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(ref->GetBinError(bin), p0->GetBinError(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(ref->GetBinEntries(bin), p0->GetBinEntries(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(ref->GetBinEffectiveEntries(bin), p0->GetBinEffectiveEntries(bin)) << "bin " << bin;
+   }
+   EXPECT_DOUBLE_EQ(ref->GetMean(1), p0->GetMean(1));
+   list.Delete();
+}
+
+TEST(TProfile, MergeSameLimits)
+{
+   CheckProfileMergeSameLimits<TProfile>([](const char *name) { return new TProfile(name, "", 10, 0, 10); },
+                                         [](TProfile &p, int i, int j, double w) {
+                                            p.Fill((j * 7 + i) % 12 - 1, (j * 3 + i) % 5, w);
+                                         });
+   CheckProfileMergeSameLimits<TProfile2D>(
+      [](const char *name) { return new TProfile2D(name, "", 10, 0, 10, 5, 0, 5); },
+      [](TProfile2D &p, int i, int j, double w) { p.Fill((j * 7 + i) % 12 - 1, (j * 3 + i) % 6, j % 4, w); });
+   CheckProfileMergeSameLimits<TProfile3D>(
+      [](const char *name) { return new TProfile3D(name, "", 6, 0, 6, 5, 0, 5, 4, 0, 4); },
+      [](TProfile3D &p, int i, int j, double w) {
+         p.Fill((j * 7 + i) % 8 - 1, (j * 3 + i) % 6, (j + i) % 5, j % 4, w);
+      });
+}
+
+// Merging big histograms with the same axes, with the bins split between tasks
+// when implicit MT is enabled, gives the same result as adding them one by one.
+TEST(TH1, MergeSameAxesLarge)
+{
+   // more than 2^20 bin additions, above the threshold for the parallel merge
+   const int nx = 1100, ny = 1000, ninputs = 3;
+   TH2D h0("h0", "", nx, 0, 1, ny, 0, 1);
+   h0.SetDirectory(nullptr);
+   h0.Sumw2();
+   TList list;
+   for (int i = 0; i < ninputs; ++i) {
+      auto h = new TH2D(TString::Format("h%d", i + 1).Data(), "", nx, 0, 1, ny, 0, 1);
+      h->SetDirectory(nullptr);
+      if (i != 1)
+         h->Sumw2();
+      for (int bin = 0; bin < h->GetNcells(); ++bin) {
+         const double content = (bin * (i + 3)) % 17;
+         h->SetBinContent(bin, content);
+         if (i != 1)
+            h->SetBinError(bin, content * 0.5);
+      }
+      h->SetEntries(1000. * (i + 1));
+      list.Add(h);
+   }
+   TH2D ref(h0);
+   ref.SetName("ref");
+   for (auto h : list)
+      ref.Add(static_cast<TH1 *>(h));
+
+   std::vector<bool> imt{false};
+#ifdef R__USE_IMT
+   imt.push_back(true);
+#endif
+   for (bool mt : imt) {
+#ifdef R__USE_IMT
+      if (mt)
+         ROOT::EnableImplicitMT(4);
+#endif
+      TH2D merged(h0);
+      merged.SetName("merged");
+      merged.Merge(&list);
+      EXPECT_EQ(ref.GetEntries(), merged.GetEntries()) << "MT " << mt;
+      int nbad = 0;
+      for (int bin = 0; bin < ref.GetNcells(); ++bin) {
+         if (ref.GetBinContent(bin) != merged.GetBinContent(bin) || ref.GetBinError(bin) != merged.GetBinError(bin))
+            ++nbad;
+      }
+      EXPECT_EQ(0, nbad) << "MT " << mt;
+#ifdef R__USE_IMT
+      if (mt)
+         ROOT::DisableImplicitMT();
+#endif
+   }
+   list.Delete();
+}
@@ -1,10 +1,20 @@
 #include "TF1.h"
 #include "TF1NormSum.h"
+#include "TF2.h"
+#include "TFitResult.h"
+#include "TH1D.h"
 #include "TObjString.h"
+#include "TROOT.h"
+#include "Fit/BinData.h"
+#include "Fit/FitUtil.h"
+#include "Fit/UnBinData.h"
+#include "Math/WrappedMultiTF1.h"
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -219,3 +229,121 @@ TEST(TF1, Constructors)
    for (auto tf1 : vtf1)
       EXPECT_EQ(tf1(&x, &p), 2);
 }
+
+// Evaluating many points at once gives the same values as EvalPar
+TEST(TF1, EvalParBatch)
+{
+   const Int_t n = 1000;
+   std::vector<double> x(2 * n), result(n);
+   for (Int_t i = 0; i < 2 * n; ++i)
+      x[i] = -5. + 0.005 * i;
+
+   // formula, 1 dimension
+   TF1 f1("batchGaus", "gaus", -5, 5);
+   f1.SetParameters(2., 0.3, 1.2);
+   const double p1[3] = {3., -0.5, 0.8};
+   f1.EvalParBatch(n, x.data(), p1, result.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f1.EvalPar(&x[i], p1), result[i]);
+   // current parameters
+   f1.EvalParBatch(n, x.data(), nullptr, result.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f1.Eval(x[i]), result[i]);
+
+   // formula, 2 dimensions
+   TF2 f2("batchXY", "[0]*x*exp(-y*y*[1])", -5, 5, -5, 5);
+   const double p2[2] = {1.5, 0.25};
+   f2.EvalParBatch(n, x.data(), p2, result.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f2.EvalPar(&x[2 * i], p2), result[i]);
+
+   // the batch loop follows a change of the formula, including named parameters and constants
+   TF1 f4("batchChanged", "[a]*x+[b]", -5, 5);
+   f4.EvalParBatch(n, x.data(), p1, result.data());
+   f4.GetFormula()->Compile("[a]*TMath::Exp(-x*x*[b])+pi");
+   f4.SetParameters(p1[0], p1[2]);
+   f4.EvalParBatch(n, x.data(), nullptr, result.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f4.Eval(x[i]), result[i]);
+
+   // not a formula: point by point
+   TF1 f3("batchFunc", func, 0, 1, 1);
+   f3.EvalParBatch(n, x.data(), p1, result.data());
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(x[i] + p1[0], result[i]);
+}
+
+// The chi2 and the likelihood of a formula, computed with the batched
+// evaluation, serially and in parallel, are the sums over the points
+static void ExpectBatchedFitFunctions(ROOT::Fit::ExecutionPolicy policy)
+{
+   TF1 f("batchFitGaus", "gaus", -5, 5);
+   const double p[3] = {100., 0.3, 1.2};
+   ROOT::Math::WrappedMultiTF1 wf(f, 1);
+
+   const unsigned int n = 5003;
+   ROOT::Fit::BinData binData(n, 1);
+   ROOT::Fit::UnBinData unbinData(n, 1);
+   double chi2 = 0;
+   double logL = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      const double x = -5. + 10. * i / n;
+      const double y = 90. * std::exp(-0.5 * (x - 0.2) * (x - 0.2)) + 1.;
+      const double ey = std::sqrt(y);
+      binData.Add(x, y, ey);
+      unbinData.Add(x);
+      const double fval = f.EvalPar(&x, p);
+      chi2 += (y - fval) * (y - fval) / (ey * ey);
+      logL += std::log(fval);
+   }
+
+   unsigned int nPoints = 0;
+   EXPECT_NEAR(chi2, ROOT::Fit::FitUtil::EvaluateChi2(wf, binData, p, nPoints, policy), 1e-10 * chi2);
+   EXPECT_NEAR(-logL, ROOT::Fit::FitUtil::EvaluateLogL(wf, unbinData, p, 0, false, nPoints, policy),
+               1e-10 * std::abs(logL));
+}
+
+TEST(TF1, EvalParBatchFitFunctions)
+{
+   ExpectBatchedFitFunctions(ROOT::Fit::ExecutionPolicy::kSerial);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   ExpectBatchedFitFunctions(ROOT::Fit::ExecutionPolicy::kMultithread);
+   ROOT::DisableImplicitMT();
+#endif
+}
+
+// Fits of a formula, evaluated in batches, give the same result as the fits of
+// the same function evaluated point by point
+TEST(TF1, EvalParBatchFit)
+{
+   TH1D h("batchFitHist", "", 200, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      const double x = h.GetBinCenter(i);
+      h.SetBinContent(i, std::floor(90. * std::exp(-0.5 * (x - 0.2) * (x - 0.2) / 1.1) + 1.));
+   }
+   std::vector<std::string> options{"Q N S", "Q N S L"};
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   options.emplace_back("Q N S MULTITHREAD");
+   options.emplace_back("Q N S L MULTITHREAD");
+#endif
+   for (const auto &opt : options) {
+      TF1 fFormula("batchFitFormula", "[0]*exp(-0.5*(x-[1])*(x-[1])/[2])", -5, 5);
+      TF1 fPoint("batchFitPoint",
+                 [](double *x, double *p) { return p[0] * std::exp(-0.5 * (x[0] - p[1]) * (x[0] - p[1]) / p[2]); }, -5,
+                 5, 3);
+      fFormula.SetParameters(80., 0., 1.);
+      fPoint.SetParameters(80., 0., 1.);
+      TFitResultPtr rFormula = h.Fit(&fFormula, opt.c_str());
+      TFitResultPtr rPoint = h.Fit(&fPoint, opt.c_str());
+      ASSERT_EQ(0, (int)rFormula) << opt;
+      ASSERT_EQ(0, (int)rPoint) << opt;
+      EXPECT_NEAR(rPoint->MinFcnValue(), rFormula->MinFcnValue(), 1e-8 * std::abs(rPoint->MinFcnValue())) << opt;
+      for (int i = 0; i < 3; ++i)
+         EXPECT_NEAR(fPoint.GetParameter(i), fFormula.GetParameter(i), 1e-6 * std::abs(fPoint.GetParameter(i))) << opt;
+   }
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
@@ -208,3 +208,24 @@ TEST(TKDE, tkde_io_binned)
    }
 }
 
+
+/// Grid approximation test
+/// In this test we compare the values of the grid approximation with the exact ones
+TEST(TKDE, tkde_grid)
+{
+   int n = 10000;
+   std::vector<double> v; v.reserve(n);
+   for(int i=0;i<n;++i) v.push_back( (i < 0.2*n) ? gRandom->Gaus(10,1) : gRandom->Gaus(10,4) );
+   for (TString iteration : {"Fixed", "Adaptive"}) {
+      TString opt = "KernelType:Gaussian;Iteration:" + iteration + ";Mirror:noMirror;Binning:Unbinned";
+      TKDE exact(v.size(), &v[0], 0., 20., opt, 1);
+      TKDE grid(v.size(), &v[0], 0., 20., opt, 1);
+      grid.SetGridApproximation(1000);
+      for (double x = 0.05; x < 20.; x += 0.5) {
+         double f = exact(x);
+         EXPECT_NEAR(f, grid(x), 1.E-3 * f + 1.E-6) << iteration << " x = " << x;
+      }
+      // outside the range the estimate is evaluated exactly
+      EXPECT_DOUBLE_EQ(exact(21.), grid(21.));
+   }
+}
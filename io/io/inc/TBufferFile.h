@@ -63,6 +63,7 @@ protected:
    UInt_t CheckObject(UInt_t offset, const TClass *cl, Bool_t readClass = kFALSE);
 
    virtual  void  WriteObjectClass(const void *actualObjStart, const TClass *actualClass, Bool_t cacheReuse);
+   Bool_t HasCompiledLayout(const TClass *cl, Version_t version, const char *const *members);
 
 public:
    enum { kStreamedMemberWise = BIT(14) }; //added to version number to know if a collection has been stored member-wise
@@ -80,7 +81,9 @@ public:
    virtual Version_t  ReadVersion(UInt_t *start = 0, UInt_t *bcnt = 0, const TClass *cl = 0);
    virtual Version_t  ReadVersionNoCheckSum(UInt_t *start = 0, UInt_t *bcnt = 0);
    virtual Version_t  ReadVersionForMemberWise(const TClass *cl = 0);
+   virtual Bool_t     ReadVersionForCompiledStreamer(const TClass *cl, Version_t compiledVersion, const char *const *members, UInt_t *start, UInt_t *bcnt);
    virtual UInt_t     WriteVersion(const TClass *cl, Bool_t useBcnt = kFALSE);
+   virtual Bool_t     WriteVersionForCompiledStreamer(const TClass *cl, Version_t compiledVersion, const char *const *members, UInt_t *bcnt);
    virtual UInt_t     WriteVersionMemberWise(const TClass *cl, Bool_t useBcnt = kFALSE);
 
    virtual void      *ReadObjectAny(const TClass* cast);
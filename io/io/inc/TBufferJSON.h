@@ -16,6 +16,7 @@
 #include "TString.h"
 
 #include <deque>
+#include <iosfwd>
 #include <memory>
 #include <string>
 
@@ -43,8 +44,11 @@ public:
    ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = nullptr);
    static TString ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
-   static Int_t ExportToFile(const char *filename, const TObject *obj, const char *option = nullptr);
-   static Int_t ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option = nullptr);
+   static Long64_t ConvertToJSON(std::ostream &out, const TObject *obj, Int_t compact = 0);
+   static Long64_t ConvertToJSON(std::ostream &out, const void *obj, const TClass *cl, Int_t compact = 0);
+
+   static Long64_t ExportToFile(const char *filename, const TObject *obj, const char *option = nullptr);
+   static Long64_t ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option = nullptr);
 
    static TObject *ConvertFromJSON(const char *str);
    static void *ConvertFromJSONAny(const char *str, TClass **cl = nullptr);
@@ -230,6 +234,8 @@ protected:
 
    TString JsonWriteMember(const void *ptr, TDataMember *member, TClass *memberClass, Int_t arraylen);
 
+   void JsonWriteTopObject(const void *obj, const TClass *cl);
+
    TJSONStackObj *PushStack(Int_t inclevel = 0, void *readnode = nullptr);
    TJSONStackObj *PopStack();
    TJSONStackObj *Stack() { return fStack.back(); }
@@ -274,6 +280,8 @@ protected:
 
    void AppendOutput(const char *line0, const char *line1 = nullptr);
 
+   void FlushOutput();
+
    void JsonPushValue();
 
    template <typename T>
@@ -295,6 +303,8 @@ protected:
    TString fOutBuffer;                 ///<!  main output buffer for json code
    TString *fOutput{nullptr};          ///<!  current output buffer for json code
    TString fValue;                     ///<!  buffer for current value
+   std::ostream *fSink{nullptr};       ///<!  optional stream, where main output buffer is flushed
+   Long64_t fSinkBytes{0};             ///<!  number of bytes already flushed into the sink
    unsigned fJsonrCnt{0};              ///<!  counter for all objects, used for referencing
    std::deque<TJSONStackObj *> fStack; ///<!  hierarchy of currently streamed element
    Int_t fCompact{0};  ///<!  0 - no any compression, 1 - no spaces in the begin, 2 - no new lines, 3 - no spaces at all
@@ -29,6 +29,12 @@ class TBrowser;
 class TKey;
 class TFile;
 
+namespace ROOT {
+namespace Internal {
+class TDirectoryFileKeys;
+}
+}
+
 class TDirectoryFile : public TDirectory {
 
 protected:
@@ -44,13 +50,18 @@ protected:
    Long64_t    fSeekKeys;        ///< Location of Keys record on file
    TFile      *fFile;            ///< Pointer to current file in memory
    TList      *fKeys;            ///< Pointer to keys list in memory
+   mutable ROOT::Internal::TDirectoryFileKeys *fKeysRecords; ///<! Key records of a read-only directory, see ReadKeys()
 
    virtual void         CleanTargets();
+   Int_t CountKeys(const char *classname) const;
    void Init(TClass *cl = 0);
 
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
    void operator=(const TDirectoryFile &); //Directories cannot be copied
+   Int_t IndexKeys(char *buffer, const char *end, Int_t nkeys);
+   void LoadKeys() const;
+   void LoadKeys(const char *name) const;
 
 public:
    // TDirectory status bits
@@ -88,10 +99,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
    virtual TFile      *GetFile() const { return fFile; }
    virtual TKey       *GetKey(const char *name, Short_t cycle=9999) const;
-   virtual TList      *GetListOfKeys() const { return fKeys; }
+   virtual TList      *GetListOfKeys() const;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
    virtual Int_t       GetNbytesKeys() const { return fNbytesKeys; }
-   virtual Int_t       GetNkeys() const { return fKeys->GetSize(); }
+   virtual Int_t       GetNkeys() const;
    virtual Long64_t    GetSeekDir() const { return fSeekDir; }
    virtual Long64_t    GetSeekParent() const { return fSeekParent; }
    virtual Long64_t    GetSeekKeys() const { return fSeekKeys; }
@@ -22,6 +22,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include "Compression.h"
 #include "TDirectoryFile.h"
@@ -31,7 +34,6 @@
 
 #ifdef R__USE_IMT
 #include "ROOT/TRWSpinLock.hxx"
-#include <mutex>
 #endif
 
 
@@ -47,6 +49,7 @@ class TFilePrefetch;
 
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
+  friend class TBufferFile;
   friend class TFilePrefetch;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
@@ -106,6 +109,10 @@ protected:
 
    TList           *fInfoCache;      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases;     ///<!Time info about open phases
+   Bool_t           fConcurrentRead{kFALSE}; ///<!True if objects may be read from several threads at the same time
+   std::mutex       fReadMutex;      ///<!Lock for the read statistics when objects are read concurrently
+   std::unordered_map<const TClass *, std::pair<UInt_t, Bool_t>> fCompiledLayouts; ///<!Per class: checksum and result of HasCompiledLayout
+   std::mutex       fCompiledLayoutsMutex; ///<!Lock for fCompiledLayouts
 
 #ifdef R__USE_IMT
    static ROOT::TRWSpinLock                   fgRwLock;     ///<!Read-write lock to protect global PID list
@@ -130,6 +137,7 @@ protected:
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void  Init(Bool_t create);
    Bool_t                    FlushWriteCache();
+   Bool_t                    HasCompiledLayout(const TClass *cl, Version_t version, const char *const *members);
    Int_t                     ReadBufferViaCache(char *buf, Int_t len);
    Int_t                     WriteBufferViaCache(const char *buf, Int_t len);
 
@@ -151,6 +159,7 @@ protected:
    virtual Int_t    SysOpen(const char *pathname, Int_t flags, UInt_t mode);
    virtual Int_t    SysClose(Int_t fd);
    virtual Int_t    SysRead(Int_t fd, void *buf, Int_t len);
+           Int_t    SysReadAt(Int_t fd, void *buf, Int_t len, Long64_t offset);
    virtual Int_t    SysWrite(Int_t fd, const void *buf, Int_t len);
    virtual Long64_t SysSeek(Int_t fd, Long64_t offset, Int_t whence);
    virtual Int_t    SysStat(Int_t fd, Long_t *id, Long64_t *size, Long_t *flags, Long_t *modtime);
@@ -242,6 +251,7 @@ public:
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
            Bool_t      IsRaw() const { return !fIsRootFile; }
+           Bool_t      IsConcurrentRead() const { return fConcurrentRead; }
    virtual Bool_t      IsOpen() const;
    virtual void        ls(Option_t *option="") const;
    virtual void        MakeFree(Long64_t first, Long64_t last);
@@ -264,6 +274,7 @@ public:
    virtual Int_t       ReOpen(Option_t *mode);
    virtual void        Seek(Long64_t offset, ERelativeTo pos = kBeg);
    virtual void        SetCacheRead(TFileCacheRead *cache, TObject* tree = 0, ECacheAction action = kDisconnect);
+           Bool_t      SetConcurrentRead(Bool_t enable = kTRUE);
    virtual void        SetCacheWrite(TFileCacheWrite *cache);
    virtual void        SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
    virtual void        SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
@@ -102,6 +102,7 @@ protected:
    virtual void        ReadBuffer(char *&buffer);
            void        ReadKeyBuffer(char *&buffer);
    virtual Bool_t      ReadFile();
+           Bool_t      ReadFileBuffer(char *buffer);
    virtual void        SetBuffer() { fBuffer = new char[fNbytes];}
    virtual void        SetParent(const TObject *parent);
            void        SetMotherDir(TDirectory* dir) { fMotherDir = dir; }
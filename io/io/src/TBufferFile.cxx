@@ -36,13 +36,9 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TVirtualMutex.h"
 #include "TROOT.h"
 
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
+#if defined(R__BYTESWAP) && defined(__x86_64__) && defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#define R__BSWAP_SIMD
+#include <immintrin.h>
 #endif
 
 
@@ -57,6 +53,125 @@ const Int_t  kMapOffset         = 2;   // first 2 map entries are taken by null
 
 ClassImp(TBufferFile);
 
+#ifdef R__BYTESWAP
+namespace {
+
+/// Unsigned integer type of a given size, used to byte swap one value.
+template <int kSize> struct BswapWord;
+template <> struct BswapWord<2> { using Type = UShort_t; };
+template <> struct BswapWord<4> { using Type = UInt_t; };
+template <> struct BswapWord<8> { using Type = ULong64_t; };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte swap 'nbytes' bytes (a multiple of kSize) value by value.
+
+template <int kSize>
+inline void BswapCopyScalar(char *out, const char *in, Long64_t nbytes)
+{
+   using Word_t = typename BswapWord<kSize>::Type;
+   for (Long64_t pos = 0; pos < nbytes; pos += kSize) {
+      Word_t w;
+      memcpy(&w, in + pos, kSize);
+      w = host2net(w);
+      memcpy(out + pos, &w, kSize);
+   }
+}
+
+#ifdef R__BSWAP_SIMD
+////////////////////////////////////////////////////////////////////////////////
+/// Byte shuffle reversing each kSize bytes value of a 16 bytes lane.
+
+template <int kSize>
+inline void BswapMask(char *mask, int len)
+{
+   for (int i = 0; i < len; ++i)
+      mask[i] = (i % 16) / kSize * kSize + kSize - 1 - i % kSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte swap 32 bytes at a time with AVX2, return the number of bytes done.
+
+template <int kSize>
+__attribute__((target("avx2"))) Long64_t BswapCopyAVX2(char *out, const char *in, Long64_t nbytes)
+{
+   char m[32];
+   BswapMask<kSize>(m, 32);
+   const __m256i mask = _mm256_loadu_si256((const __m256i *)m);
+   Long64_t pos = 0;
+   for (; pos + 32 <= nbytes; pos += 32) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(in + pos));
+      _mm256_storeu_si256((__m256i *)(out + pos), _mm256_shuffle_epi8(v, mask));
+   }
+   return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte swap 16 bytes at a time with SSSE3, return the number of bytes done.
+
+template <int kSize>
+__attribute__((target("ssse3"))) Long64_t BswapCopySSSE3(char *out, const char *in, Long64_t nbytes)
+{
+   char m[16];
+   BswapMask<kSize>(m, 16);
+   const __m128i mask = _mm_loadu_si128((const __m128i *)m);
+   Long64_t pos = 0;
+   for (; pos + 16 <= nbytes; pos += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(in + pos));
+      _mm_storeu_si128((__m128i *)(out + pos), _mm_shuffle_epi8(v, mask));
+   }
+   return pos;
+}
+
+enum class EBswapISA { kScalar, kSSSE3, kAVX2 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Best instruction set available on the running CPU, determined once.
+
+EBswapISA GetBswapISA()
+{
+   static const EBswapISA isa = []() {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+         return EBswapISA::kAVX2;
+      if (__builtin_cpu_supports("ssse3"))
+         return EBswapISA::kSSSE3;
+      return EBswapISA::kScalar;
+   }();
+   return isa;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy n values of kSize bytes from 'from' into 'to', converting each of
+/// them between host and network byte order. The pointers do not need to be
+/// aligned, the ranges must not overlap.
+///
+/// On x86_64 the bulk of the array is shuffled with AVX2 or SSSE3 when the
+/// CPU supports it (checked at run time), the rest is swapped value by value.
+
+template <int kSize>
+inline void BswapCopy(void *to, const void *from, Int_t n)
+{
+   char *out = (char *)to;
+   const char *in = (const char *)from;
+   Long64_t nbytes = Long64_t(n) * kSize;
+   Long64_t done = 0;
+#ifdef R__BSWAP_SIMD
+   // Not worth the dispatch for a handful of values.
+   if (nbytes >= 64) {
+      switch (GetBswapISA()) {
+         case EBswapISA::kAVX2: done = BswapCopyAVX2<kSize>(out, in, nbytes); break;
+         case EBswapISA::kSSSE3: done = BswapCopySSSE3<kSize>(out, in, nbytes); break;
+         case EBswapISA::kScalar: break;
+      }
+   }
+#endif
+   BswapCopyScalar<kSize>(out + done, in + done, nbytes - done);
+}
+
+} // anonymous namespace
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Thread-safe check on StreamerInfos of a TClass
 
@@ -762,13 +877,8 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   BswapCopy<2>(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -795,13 +905,8 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   BswapCopy<4>(ii, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -854,8 +959,8 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   BswapCopy<8>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -882,13 +987,8 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   BswapCopy<4>(f, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -915,8 +1015,8 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   BswapCopy<8>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1035,13 +1135,8 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   BswapCopy<2>(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1067,13 +1162,8 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   BswapCopy<4>(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1124,8 +1214,8 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   BswapCopy<8>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1151,13 +1241,8 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   BswapCopy<4>(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1183,8 +1268,8 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   BswapCopy<8>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1301,13 +1386,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   BswapCopy<2>(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1323,13 +1403,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   BswapCopy<4>(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1361,8 +1436,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   BswapCopy<8>(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1378,13 +1453,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   BswapCopy<4>(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1400,8 +1470,8 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   BswapCopy<8>(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1734,13 +1804,8 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   BswapCopy<2>(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -1764,13 +1829,8 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   BswapCopy<4>(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -1832,8 +1892,8 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   BswapCopy<8>(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1857,13 +1917,8 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   BswapCopy<4>(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -1887,8 +1942,8 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   BswapCopy<8>(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2000,13 +2055,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   BswapCopy<2>(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -2024,13 +2074,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   BswapCopy<4>(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -2076,8 +2121,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   BswapCopy<8>(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2095,13 +2140,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   BswapCopy<4>(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -2119,8 +2159,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   BswapCopy<8>(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2972,6 +3012,116 @@ Version_t TBufferFile::ReadVersionForMemberWise(const TClass *cl)
    return version;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the in-memory StreamerInfo of class cl for the given
+/// version has the checksum of the class and exactly the elements named in
+/// members. The result is cached per class together with the checksum of the
+/// class, so that a new class loaded at the address of an unloaded one is
+/// checked again.
+
+Bool_t HasCompiledMemoryLayout(const TClass *cl, Version_t version, const char *const *members)
+{
+   static std::mutex mutex;
+   static std::unordered_map<const TClass *, std::pair<UInt_t, Bool_t>> layouts;
+
+   const UInt_t checksum = cl->GetCheckSum();
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto iter = layouts.find(cl);
+      if (iter != layouts.end() && iter->second.first == checksum)
+         return iter->second.second;
+   }
+
+   TStreamerInfo *sinfo = (TStreamerInfo *)cl->GetStreamerInfo(version);
+   const Bool_t result = sinfo && sinfo->TStreamerInfo::GetCheckSum() == checksum && sinfo->MatchElementNames(members);
+
+   std::lock_guard<std::mutex> lock(mutex);
+   layouts[cl] = std::make_pair(checksum, result);
+   return result;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the class version and byte count of an object of class cl whose
+/// Streamer() contains an inlined read of the layout of version
+/// compiledVersion (see the -compiledStreamers option of rootcling).
+///
+/// Return kTRUE if the object was written with exactly the in-memory layout
+/// of that version: the caller then reads the data members itself and calls
+/// CheckByteCount(*start, *bcnt, cl). Otherwise nothing is consumed from the
+/// buffer and kFALSE is returned; the caller must use ReadClassBuffer, which
+/// takes care of schema evolution.
+///
+/// members is the null terminated list of the names of the StreamerInfo
+/// elements read by the caller. The layout of the data is given by the
+/// StreamerInfo of the file the buffer is read from, see HasCompiledLayout.
+
+Bool_t TBufferFile::ReadVersionForCompiledStreamer(const TClass *cl, Version_t compiledVersion, const char *const *members, UInt_t *start, UInt_t *bcnt)
+{
+   if (!cl || cl->GetClassVersion() != compiledVersion)
+      return kFALSE;
+   if (const_cast<TClass *>(cl)->CanIgnoreTObjectStreamer())
+      return kFALSE;
+   const ROOT::Detail::TSchemaRuleSet *rules = cl->GetSchemaRules();
+   if (rules && rules->GetRules()->GetEntriesFast())
+      return kFALSE;
+   if (!HasCompiledLayout(cl, compiledVersion, members))
+      return kFALSE;
+
+   char *const startpos = fBufCur;
+   Version_t version = ReadVersion(start, bcnt, cl);
+   if (version == compiledVersion)
+      return kTRUE;
+   fBufCur = startpos;
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the objects of class cl with the given version are stored
+/// in this buffer with the layout of the in-memory class and of a compiled
+/// Streamer(), i.e. if the StreamerInfo for that version has the checksum of
+/// the in-memory class and exactly the elements named in members.
+/// The StreamerInfo is the one stored in the file the buffer is read from
+/// (see TFile::HasCompiledLayout) or, for a buffer without file, the one
+/// ReadClassBuffer would use. Both results are cached per class.
+
+Bool_t TBufferFile::HasCompiledLayout(const TClass *cl, Version_t version, const char *const *members)
+{
+   if (!GetParent())
+      return HasCompiledMemoryLayout(cl, version, members);
+   TFile *file = dynamic_cast<TFile *>(GetParent());
+   return file && file->HasCompiledLayout(cl, version, members);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the class version and reserve space for the byte count of an object
+/// of class cl whose Streamer() contains an inlined write of the layout of
+/// version compiledVersion (see the -compiledStreamers option of rootcling).
+///
+/// Return kTRUE if the in-memory StreamerInfo of the class has exactly the
+/// elements named in members, in which case the StreamerInfo is registered
+/// with the file like in WriteClassBuffer: the caller then writes the data
+/// members itself and calls SetByteCount(*bcnt, kTRUE). Otherwise nothing is
+/// written and kFALSE is returned; the caller must use WriteClassBuffer.
+
+Bool_t TBufferFile::WriteVersionForCompiledStreamer(const TClass *cl, Version_t compiledVersion, const char *const *members, UInt_t *bcnt)
+{
+   if (!cl || cl->GetClassVersion() != compiledVersion)
+      return kFALSE;
+   if (const_cast<TClass *>(cl)->CanIgnoreTObjectStreamer())
+      return kFALSE;
+   TStreamerInfo *sinfo = (TStreamerInfo *)const_cast<TClass *>(cl)->GetCurrentStreamerInfo();
+   if (!sinfo || !sinfo->IsCompiled() || !HasCompiledMemoryLayout(cl, compiledVersion, members))
+      return kFALSE;
+
+   *bcnt = WriteVersion(cl, kTRUE);
+   TagStreamerInfo(sinfo);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write class version to I/O buffer.
 
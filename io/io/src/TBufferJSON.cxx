@@ -36,6 +36,14 @@ To reconstruct object from the JSON string, one should do:
    TBufferJSON::FromJSON(hnew, json);
    if (hnew) hnew->Draw("hist");
 ~~~
+When JSON should be written into a file or a network stream, one can avoid
+building the complete JSON string in memory by providing an output stream:
+~~~{.cpp}
+   std::ofstream ofs("h1.json");
+   TBufferJSON::ConvertToJSON(ofs, h1, 3);
+~~~
+The JSON code is then flushed into the stream in chunks while the object is converted.
+
 JSON data does not include stored class version, therefore schema evolution
 (reading of older class versions) is not supported. JSON should not be used as
 persistent storage for object data - only for live applications.
@@ -48,8 +56,10 @@ persistent storage for object data - only for live applications.
 #include <string>
 #include <string.h>
 #include <locale.h>
+#include <cerrno>
 #include <cmath>
 #include <memory>
+#include <algorithm>
 
 #include <ROOT/RMakeUnique.hxx>
 
@@ -84,6 +94,9 @@ ClassImp(TBufferJSON);
 
 enum { json_TArray = 100, json_TCollection = -130, json_TString = 110, json_stdstring = 120 };
 
+/// size of main output buffer, after which it is flushed into the sink stream
+const Int_t kJsonSinkChunk = 64 * 1024;
+
 ///////////////////////////////////////////////////////////////
 // TArrayIndexProducer is used to correctly create
 /// JSON array separators for multi-dimensional JSON arrays
@@ -362,6 +375,256 @@ public:
    }
 };
 
+///////////////////////////////////////////////////////////////
+/// TJSONFastParser builds the nlohmann::json document for the JSON
+/// produced by TBufferJSON. Most of the time of the generic parser is
+/// spent in the conversion of numbers, done here without strtod() when
+/// the result is exact. Returns false for anything it does not handle
+/// (invalid JSON, \u escapes); the generic parser is then used, which
+/// also reports the errors.
+
+class TJSONFastParser {
+   const char *fCur{nullptr}; ///<! current parse position
+
+   void SkipSpaces()
+   {
+      while ((*fCur == ' ') || (*fCur == '\n') || (*fCur == '\r') || (*fCur == '\t'))
+         ++fCur;
+   }
+
+   bool ParseString(std::string &res)
+   {
+      const char *start = ++fCur; // skip opening quote
+      while ((*fCur != '"') && (*fCur != '\\')) {
+         if ((unsigned char)*fCur < 0x20)
+            return false;
+         ++fCur;
+      }
+      res.assign(start, fCur);
+      while (*fCur != '"') {
+         if ((unsigned char)*fCur < 0x20)
+            return false;
+         if (*fCur != '\\') {
+            res.push_back(*fCur++);
+            continue;
+         }
+         ++fCur;
+         switch (*fCur++) {
+         case '"': res.push_back('"'); break;
+         case '\\': res.push_back('\\'); break;
+         case '/': res.push_back('/'); break;
+         case 'b': res.push_back('\b'); break;
+         case 'f': res.push_back('\f'); break;
+         case 'n': res.push_back('\n'); break;
+         case 'r': res.push_back('\r'); break;
+         case 't': res.push_back('\t'); break;
+         default: return false;
+         }
+      }
+      ++fCur;
+      return true;
+   }
+
+   /// Exact conversion of numbers with at most 19 significant digits and a
+   /// power of ten representable as double (the "fast path" of Clinger)
+   static bool ExactFloat(const char *p, const char *end, double &res)
+   {
+      static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+      bool neg = (*p == '-');
+      if (neg)
+         ++p;
+      unsigned long long mant = 0;
+      int ndigits = 0, exp10 = 0;
+      for (; (p < end) && (*p >= '0') && (*p <= '9'); ++p) {
+         if (ndigits || (*p != '0'))
+            ndigits++;
+         mant = mant * 10 + (*p - '0');
+      }
+      if ((p < end) && (*p == '.'))
+         for (++p; (p < end) && (*p >= '0') && (*p <= '9'); ++p, --exp10) {
+            if (ndigits || (*p != '0'))
+               ndigits++;
+            mant = mant * 10 + (*p - '0');
+         }
+      if (ndigits > 19)
+         return false;
+      if (p < end) { // exponent, already validated
+         bool eneg = (*++p == '-');
+         if ((*p == '-') || (*p == '+'))
+            ++p;
+         int e = 0;
+         for (; p < end; ++p)
+            if ((e = e * 10 + (*p - '0')) > 1000)
+               return false;
+         exp10 += eneg ? -e : e;
+      }
+      if ((mant > (1ULL << 53)) || (exp10 < -22) || (exp10 > 22))
+         return false;
+      res = (exp10 < 0) ? mant / pow10[-exp10] : mant * pow10[exp10];
+      if (neg)
+         res = -res;
+      return true;
+   }
+
+   /// Same number types as the generic parser: unsigned or signed integer if
+   /// representable, float otherwise, null for non finite values
+   bool ParseNumber(nlohmann::json &res)
+   {
+      const char *start = fCur;
+      bool isfloat = false;
+      auto digits = [this]() {
+         if ((*fCur < '0') || (*fCur > '9'))
+            return false;
+         while ((*fCur >= '0') && (*fCur <= '9'))
+            ++fCur;
+         return true;
+      };
+      if (*fCur == '-')
+         ++fCur;
+      if (*fCur == '0')
+         ++fCur;
+      else if (!digits())
+         return false;
+      if (*fCur == '.') {
+         isfloat = true;
+         ++fCur;
+         if (!digits())
+            return false;
+      }
+      if ((*fCur == 'e') || (*fCur == 'E')) {
+         isfloat = true;
+         ++fCur;
+         if ((*fCur == '+') || (*fCur == '-'))
+            ++fCur;
+         if (!digits())
+            return false;
+      }
+      char *end = nullptr;
+      if (!isfloat) {
+         errno = 0;
+         if (*start == '-') {
+            long long val = std::strtoll(start, &end, 10);
+            if ((errno == 0) && (end == fCur)) {
+               res = (nlohmann::json::number_integer_t)val;
+               return true;
+            }
+         } else {
+            unsigned long long val = std::strtoull(start, &end, 10);
+            if ((errno == 0) && (end == fCur)) {
+               res = (nlohmann::json::number_unsigned_t)val;
+               return true;
+            }
+         }
+      }
+      double val = 0;
+      if (!ExactFloat(start, fCur, val)) {
+         // strtod() depends on the locale, the generic parser handles other decimal points
+         val = std::strtod(start, &end);
+         if (end != fCur)
+            return false;
+      }
+      if (std::isfinite(val))
+         res = val;
+      else
+         res = nullptr;
+      return true;
+   }
+
+   bool ParseValue(nlohmann::json &res, int depth)
+   {
+      if (depth > 1000)
+         return false;
+      SkipSpaces();
+      switch (*fCur) {
+      case '{': {
+         ++fCur;
+         res = nlohmann::json::object();
+         SkipSpaces();
+         if (*fCur == '}') {
+            ++fCur;
+            return true;
+         }
+         std::string key;
+         while (true) {
+            SkipSpaces();
+            if ((*fCur != '"') || !ParseString(key))
+               return false;
+            SkipSpaces();
+            if (*fCur++ != ':')
+               return false;
+            if (!ParseValue(res[key], depth + 1))
+               return false;
+            SkipSpaces();
+            if (*fCur == ',') {
+               ++fCur;
+               continue;
+            }
+            return (*fCur++ == '}');
+         }
+      }
+      case '[': {
+         ++fCur;
+         res = nlohmann::json::array();
+         SkipSpaces();
+         if (*fCur == ']') {
+            ++fCur;
+            return true;
+         }
+         while (true) {
+            res.push_back(nlohmann::json());
+            if (!ParseValue(res.back(), depth + 1))
+               return false;
+            SkipSpaces();
+            if (*fCur == ',') {
+               ++fCur;
+               continue;
+            }
+            return (*fCur++ == ']');
+         }
+      }
+      case '"': {
+         std::string str;
+         if (!ParseString(str))
+            return false;
+         res = std::move(str);
+         return true;
+      }
+      case 't':
+         if (strncmp(fCur, "true", 4) != 0)
+            return false;
+         fCur += 4;
+         res = true;
+         return true;
+      case 'f':
+         if (strncmp(fCur, "false", 5) != 0)
+            return false;
+         fCur += 5;
+         res = false;
+         return true;
+      case 'n':
+         if (strncmp(fCur, "null", 4) != 0)
+            return false;
+         fCur += 4;
+         res = nullptr;
+         return true;
+      default: return ParseNumber(res);
+      }
+   }
+
+public:
+   TJSONFastParser(const char *str) : fCur(str) {}
+
+   /// Parse complete string, returns false if it has to be parsed by the generic parser
+   bool Parse(nlohmann::json &res)
+   {
+      if (!fCur || !ParseValue(res, 0))
+         return false;
+      SkipSpaces();
+      return *fCur == 0;
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates buffer object to serialize data into json.
 
@@ -574,15 +837,81 @@ TString TBufferJSON::ConvertToJSON(const void *obj, const TClass *cl, Int_t comp
 
    buf.SetCompact(compact);
 
-   buf.InitMap();
+   buf.JsonWriteTopObject(actualStart, clActual);
 
-   buf.PushStack(0); // dummy stack entry to avoid extra checks in the beginning
+   return buf.fOutBuffer.Length() ? buf.fOutBuffer : buf.fValue;
+}
 
-   buf.JsonWriteObject(actualStart, clActual);
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object, inherited from TObject class, to JSON and writes it into the stream
+/// JSON code is not accumulated in memory, but flushed into the stream in chunks
+/// Meaning of compact parameter is the same as for ConvertToJSON(const TObject *, Int_t, const char *)
+/// Returns number of bytes written into the stream
 
-   buf.PopStack();
+Long64_t TBufferJSON::ConvertToJSON(std::ostream &out, const TObject *obj, Int_t compact)
+{
+   TClass *clActual = nullptr;
+   void *ptr = (void *)obj;
 
-   return buf.fOutBuffer.Length() ? buf.fOutBuffer : buf.fValue;
+   if (obj) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual)
+         clActual = TObject::Class();
+      else if (clActual != TObject::Class())
+         ptr = (void *)((Long_t)obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   return ConvertToJSON(out, ptr, clActual, compact);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object to JSON and writes it into the stream
+/// JSON code is not accumulated in memory, but flushed into the stream in chunks
+/// Meaning of compact parameter is the same as for ConvertToJSON(const void *, const TClass *, Int_t, const char *)
+/// Returns number of bytes written into the stream
+
+Long64_t TBufferJSON::ConvertToJSON(std::ostream &out, const void *obj, const TClass *cl, Int_t compact)
+{
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+
+   buf.fSink = &out;
+   buf.fOutBuffer.Capacity(kJsonSinkChunk + 1000);
+
+   buf.JsonWriteTopObject(obj, cl);
+
+   if ((buf.fSinkBytes == 0) && (buf.fOutBuffer.Length() == 0)) {
+      // special classes like TArray or STL containers keep complete JSON in the value
+      out.write(buf.fValue.Data(), buf.fValue.Length());
+      buf.fSinkBytes = buf.fValue.Length();
+   }
+
+   buf.FlushOutput();
+
+   return buf.fSinkBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts top-level object into the main output buffer
+
+void TBufferJSON::JsonWriteTopObject(const void *obj, const TClass *cl)
+{
+   TClass *clActual = obj ? cl->GetActualClass(obj) : nullptr;
+   const void *actualStart = obj;
+   if (clActual && (clActual != cl)) {
+      actualStart = (char *)obj - clActual->GetBaseClassOffset(cl);
+   } else {
+      clActual = const_cast<TClass *>(cl);
+   }
+
+   InitMap();
+
+   PushStack(0); // dummy stack entry to avoid extra checks in the beginning
+
+   JsonWriteObject(actualStart, clActual);
+
+   PopStack();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -618,7 +947,7 @@ TString TBufferJSON::ConvertToJSON(const void *ptr, TDataMember *member, Int_t c
 /// Returns size of the produce file
 /// Used in TObject::SaveAs()
 
-Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const char *option)
+Long64_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const char *option)
 {
    if (!obj || !filename || (*filename == 0))
       return 0;
@@ -627,11 +956,14 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
-   TString json = TBufferJSON::ConvertToJSON(obj, compact);
-
    std::ofstream ofs(filename);
 
+   Long64_t len = 0;
+
    if (strstr(filename, ".json.gz")) {
+      TString json = TBufferJSON::ConvertToJSON(obj, compact);
+      len = json.Length();
+
       const char *objbuf = json.Data();
       Long_t objlen = json.Length();
 
@@ -686,19 +1018,20 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const
 
       free(buffer);
    } else {
-      ofs << json.Data();
+      // plain JSON is streamed into the file without building complete string in memory
+      len = TBufferJSON::ConvertToJSON(ofs, obj, compact);
    }
 
    ofs.close();
 
-   return json.Length();
+   return len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert object into JSON and store in text file
 /// Returns size of the produce file
 
-Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option)
+Long64_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option)
 {
    if (!obj || !cl || !filename || (*filename == 0))
       return 0;
@@ -707,11 +1040,14 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TCl
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
-   TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
-
    std::ofstream ofs(filename);
 
+   Long64_t len = 0;
+
    if (strstr(filename, ".json.gz")) {
+      TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
+      len = json.Length();
+
       const char *objbuf = json.Data();
       Long_t objlen = json.Length();
 
@@ -766,12 +1102,13 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TCl
 
       free(buffer);
    } else {
-      ofs << json.Data();
+      // plain JSON is streamed into the file without building complete string in memory
+      len = TBufferJSON::ConvertToJSON(ofs, obj, cl, compact);
    }
 
    ofs.close();
 
-   return json.Length();
+   return len;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -810,7 +1147,9 @@ void *TBufferJSON::ConvertFromJSONAny(const char *str, TClass **cl)
       *cl = nullptr;
    }
 
-   nlohmann::json docu = nlohmann::json::parse(str);
+   nlohmann::json docu;
+   if (!TJSONFastParser(str).Parse(docu))
+      docu = nlohmann::json::parse(str);
 
    if (docu.is_null() || (!docu.is_object() && !docu.is_array()))
       return nullptr;
@@ -1029,6 +1368,23 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if (fSink && (fOutput == &fOutBuffer) && (fOutBuffer.Length() > kJsonSinkChunk))
+      FlushOutput();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write content of main output buffer into the sink stream and clear the buffer
+/// Capacity of the buffer is preserved, therefore no reallocation is performed later
+
+void TBufferJSON::FlushOutput()
+{
+   if (!fSink || (fOutBuffer.Length() == 0))
+      return;
+
+   fSink->write(fOutBuffer.Data(), fOutBuffer.Length());
+   fSinkBytes += fOutBuffer.Length();
+   fOutBuffer.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2540,34 +2896,50 @@ R__ALWAYS_INLINE void TBufferJSON::JsonReadFastArray(T *arr, Int_t arrsize, bool
    } else if (json->is_object() && (json->count("$arr") == 1)) {
       if (json->at("len").get<int>() != arrsize)
          Error("ReadFastArray", "Mismatch compressed array size %d %d", arrsize, json->at("len").get<int>());
-      for (int cnt = 0; cnt < arrsize; ++cnt)
-         arr[cnt] = 0;
+      std::fill(arr, arr + arrsize, T(0));
+      // single lookup per key, key names formatted in local buffer
+      auto end = json->end();
+      char key[20];
       int p = 0, id = 0;
-      std::string idname = "", pname, vname, nname;
       while (p < arrsize) {
-         pname = std::string("p") + idname;
-         if (json->count(pname) == 1)
-            p = json->at(pname).get<int>();
-         vname = std::string("v") + idname;
-         if (json->count(vname) != 1)
+         if (id > 0)
+            snprintf(key, sizeof(key), "p%d", id);
+         auto piter = json->find(id > 0 ? key : "p");
+         if (piter != end)
+            p = piter->get<int>();
+         if (id > 0)
+            key[0] = 'v';
+         auto viter = json->find(id > 0 ? key : "v");
+         if (viter == end)
             break;
-         nlohmann::json &v = json->at(vname);
+         nlohmann::json &v = *viter;
          if (v.is_array()) {
-            for (unsigned sub = 0; sub < v.size(); ++sub)
-               arr[p++] = v[sub].get<T>();
+            int len = std::min((int)v.size(), arrsize - p);
+            for (auto &sub : v) {
+               if (len-- <= 0)
+                  break;
+               arr[p++] = sub.get<T>();
+            }
          } else {
-            nname = std::string("n") + idname;
-            unsigned ncopy = (json->count(nname) == 1) ? json->at(nname).get<unsigned>() : 1;
-            for (unsigned sub = 0; sub < ncopy; ++sub)
-               arr[p++] = v.get<T>();
+            if (id > 0)
+               key[0] = 'n';
+            auto niter = json->find(id > 0 ? key : "n");
+            int ncopy = std::min((niter != end) ? niter->get<int>() : 1, arrsize - p);
+            std::fill(arr + p, arr + p + ncopy, v.get<T>());
+            p += ncopy;
          }
-         idname = std::to_string(++id);
+         ++id;
       }
    } else {
       if ((int)json->size() != arrsize)
          Error("ReadFastArray", "Mismatch array sizes %d %d", arrsize, (int)json->size());
-      for (int cnt = 0; cnt < arrsize; ++cnt)
-         arr[cnt] = json->at(cnt).get<T>();
+      // iterate directly over elements, avoids range checks of at()
+      int cnt = 0;
+      for (auto &elem : *json) {
+         if (cnt >= arrsize)
+            break;
+         arr[cnt++] = elem.get<T>();
+      }
    }
 }
 
@@ -2786,15 +3158,17 @@ R__ALWAYS_INLINE void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t
       }
       fValue.Append("]");
    } else {
-      fValue.Append("{");
-      fValue.Append(TString::Format("\"$arr\":\"%s\"%s\"len\":%d", typname, fArraySepar.Data(), arrsize));
+      // all keys formatted in local buffer, avoids temporary TString for every compressed block
+      char buf[100];
+      snprintf(buf, sizeof(buf), "{\"$arr\":\"%s\"%s\"len\":%d", typname, fArraySepar.Data(), arrsize);
+      fValue.Append(buf);
       Int_t aindx(0), bindx(arrsize);
       while ((aindx < arrsize) && (vname[aindx] == 0))
          aindx++;
       while ((aindx < bindx) && (vname[bindx - 1] == 0))
          bindx--;
       if (aindx < bindx) {
-         TString suffix("");
+         char suffix[20] = "";
          Int_t p(aindx), suffixcnt(-1), lastp(0);
          while (p < bindx) {
             if (vname[p] == 0) {
@@ -2831,15 +3205,20 @@ R__ALWAYS_INLINE void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t
             if (pp <= p0)
                continue;
             if (++suffixcnt > 0)
-               suffix.Form("%d", suffixcnt);
-            if (p0 != lastp)
-               fValue.Append(TString::Format("%s\"p%s\":%d", fArraySepar.Data(), suffix.Data(), p0));
+               snprintf(suffix, sizeof(suffix), "%d", suffixcnt);
+            if (p0 != lastp) {
+               snprintf(buf, sizeof(buf), "%s\"p%s\":%d", fArraySepar.Data(), suffix, p0);
+               fValue.Append(buf);
+            }
             lastp = pp; /* remember cursor, it may be the same */
-            fValue.Append(TString::Format("%s\"v%s\":", fArraySepar.Data(), suffix.Data()));
+            snprintf(buf, sizeof(buf), "%s\"v%s\":", fArraySepar.Data(), suffix);
+            fValue.Append(buf);
             if ((nsame > 1) || (pp - p0 == 1)) {
                JsonWriteBasic(vname[p0]);
-               if (nsame > 1)
-                  fValue.Append(TString::Format("%s\"n%s\":%d", fArraySepar.Data(), suffix.Data(), nsame));
+               if (nsame > 1) {
+                  snprintf(buf, sizeof(buf), "%s\"n%s\":%d", fArraySepar.Data(), suffix, nsame);
+                  fValue.Append(buf);
+               }
             } else {
                fValue.Append("[");
                for (Int_t indx = p0; indx < pp; indx++) {
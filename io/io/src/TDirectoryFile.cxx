@@ -48,11 +48,90 @@ End_Macro
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
+const Int_t  kKeysCapacity = 100; // initial capacity of the hash table of the keys
 
 ClassImp(TDirectoryFile);
 
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The key records of a read-only directory, as written by
+/// TDirectoryFile::WriteKeys(). The TKey of a record is only created when its
+/// name is looked up, or when the complete list of keys is requested.
+
+class TDirectoryFileKeys {
+public:
+   struct TRecord {
+      UInt_t fHash; ///< Hash of the key name
+      Int_t  fPos;  ///< Position of the record in fBuffer
+      TKey  *fKey;  ///< The key, once created
+   };
+
+   std::vector<char>    fBuffer;  ///< The key records
+   std::vector<TRecord> fRecords; ///< The records, sorted by name hash and in file order for equal hashes
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a string written by TString::FillBuffer() without copying it.
+/// Returns its length, or -1 if it does not end before end.
+
+static Int_t ReadKeyString(char *&buffer, const char *end, const char *&str)
+{
+   if (buffer >= end) return -1;
+   UChar_t nwh;
+   frombuf(buffer, &nwh);
+   Int_t nchars = nwh;
+   if (nwh == 255) {
+      if (buffer + sizeof(Int_t) > end) return -1;
+      frombuf(buffer, &nchars);
+   }
+   if (nchars < 0 || buffer + nchars > end) return -1;
+   str = buffer;
+   buffer += nchars;
+   return nchars;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the fields of a key record needed to index it, see TKey::ReadKeyBuffer().
+/// Returns kFALSE if the record does not end before end.
+
+static Bool_t ReadKeyRecord(char *&buffer, const char *end, Long64_t &seekkey, Long64_t &seekpdir,
+                            const char *&classname, Int_t &classlen, const char *&name, Int_t &namelen)
+{
+   // Nbytes, Version, ObjLen, Datime, KeyLen, Cycle
+   if (buffer + 18 > end) return kFALSE;
+   buffer += 4;
+   Version_t version;
+   frombuf(buffer, &version);
+   buffer += 12;
+   if (version > 1000) {
+      if (buffer + 16 > end) return kFALSE;
+      frombuf(buffer, &seekkey);
+      Long64_t pdir;
+      frombuf(buffer, &pdir);
+      seekpdir = pdir & 0xffffffffffffLL; // without the pid offset
+   } else {
+      if (buffer + 8 > end) return kFALSE;
+      UInt_t skey, spdir;
+      frombuf(buffer, &skey);  seekkey  = (Long64_t)skey;
+      frombuf(buffer, &spdir); seekpdir = (Long64_t)spdir;
+   }
+   const char *title;
+   classlen = ReadKeyString(buffer, end, classname);
+   namelen = ReadKeyString(buffer, end, name);
+   return classlen >= 0 && namelen >= 0 && ReadKeyString(buffer, end, title) >= 0;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor
@@ -60,7 +139,7 @@ ClassImp(TDirectoryFile);
 TDirectoryFile::TDirectoryFile() : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecords(0)
 {
 }
 
@@ -80,7 +159,7 @@ TDirectoryFile::TDirectoryFile(const char *name, const char *title, Option_t *cl
            : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecords(0)
 {
    // We must not publish this objects to the list of RecursiveRemove (indirectly done
    // by 'Appending' this object to it's mother) before the object is completely
@@ -180,7 +259,7 @@ void TDirectoryFile::Init(TClass *cl)
 TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(directory)
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecords(0)
 {
    ((TDirectoryFile&)directory).Copy(*this);
 }
@@ -190,6 +269,7 @@ TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(di
 
 TDirectoryFile::~TDirectoryFile()
 {
+   SafeDelete(fKeysRecords);
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -243,6 +323,7 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       return 0;
    }
 
+   LoadKeys();
    fModified = kTRUE;
 
    key->SetMotherDir(this);
@@ -279,7 +360,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = 0;
       TIter nextin(fList);
       TKey *key = 0, *keyo = 0;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -333,7 +414,7 @@ void TDirectoryFile::Build(TFile* motherFile, TDirectory* motherDir)
    fSeekParent = 0;
    fSeekKeys   = 0;
    fList       = new THashList(100,50);
-   fKeys       = new THashList(100,50);
+   fKeys       = new THashList(kKeysCapacity,50);
    fList->UseRWLock();
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
@@ -587,6 +668,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   SafeDelete(fKeysRecords);
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -939,6 +1021,9 @@ TObject *TDirectoryFile::Get(const char *namecycle)
          idcur = 0;
       } else if (cycle == 9999) {
          return idcur;
+      } else if (fFile && fFile->IsConcurrentRead()) {
+         // the objects in memory are shared by all threads, read the requested cycle
+         idcur = 0;
       } else {
          if (idcur->InheritsFrom(TCollection::Class()))
             idcur->Delete();  // delete also list elements
@@ -949,8 +1034,10 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   // only the keys in the hash slot of the name have to be checked, in the same order as in the list of keys
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   LoadKeys(namobj);
+   TIter nextkey(((THashList *)fKeys)->GetListForObject(namobj));
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1057,6 +1144,9 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
             // Check type
             if (expectedClass && objcur->IsA()->GetBaseClassOffset(expectedClass) == -1) return 0;
             else return objcur;
+         } else if (fFile && fFile->IsConcurrentRead()) {
+            // the objects in memory are shared by all threads, read the requested cycle
+            objcur = 0;
          } else {
             if (objcur->InheritsFrom(TCollection::Class()))
                objcur->Delete();  // delete also list elements
@@ -1070,7 +1160,8 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //                        ===========
    void *idcur = 0;
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   LoadKeys(namobj);
+   TIter nextkey(((THashList *)fKeys)->GetListForObject(namobj));
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1107,7 +1198,8 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    if (!fKeys) return nullptr;
 
    // TIter::TIter() already checks for null pointers
-   TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
+   LoadKeys(name);
+   TIter next( ((THashList *)fKeys)->GetListForObject(name) );
 
    TKey *key;
    while (( key = (TKey *)next() )) {
@@ -1306,6 +1398,10 @@ void TDirectoryFile::ReadAll(Option_t* opt)
 /// Every directory has a linked list (fKeys). This linked list has been
 /// written on the file via WriteKeys as a single data record.
 ///
+/// For a directory which is not writable, the record is only indexed: the
+/// keys are created when they are looked up by name (Get(), GetKey(), ...),
+/// or all at once by GetListOfKeys().
+///
 /// It is interesting to call this function in the following situation.
 /// Assume another process1 is connecting this directory in Update mode
 ///   - Process1 is adding/updating objects in this directory
@@ -1337,6 +1433,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    char *buffer;
    if (forceRead) {
+      SafeDelete(fKeysRecords);
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1379,6 +1476,16 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
       TKey *key;
       frombuf(buffer, &nkeys);
+      if (!fWritable) {
+         // only index the key records, the keys are created on demand
+         nkeys = IndexKeys(buffer, headerkey->GetBuffer() + fNbytesKeys, nkeys);
+         delete headerkey;
+         return nkeys;
+      }
+      // size the hash table once for all keys, avoids repeated rehashing and long
+      // collision lists for directories with many keys
+      if (nkeys > kKeysCapacity)
+         ((THashList *)fKeys)->Rehash(nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
          key = new TKey(this);
          key->ReadKeyBuffer(buffer);
@@ -1403,6 +1510,140 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Index the nkeys key records starting at buffer, without creating their TKey.
+/// Called by ReadKeys() for read-only directories: opening a directory and
+/// reading a few of its objects then does not create all its keys, which
+/// matters for directories with many keys.
+/// Returns the number of valid keys.
+
+Int_t TDirectoryFile::IndexKeys(char *buffer, const char *end, Int_t nkeys)
+{
+   using TRecord = ROOT::Internal::TDirectoryFileKeys::TRecord;
+
+   SafeDelete(fKeysRecords);
+   std::unique_ptr<ROOT::Internal::TDirectoryFileKeys> records(new ROOT::Internal::TDirectoryFileKeys);
+   records->fRecords.reserve(nkeys);
+   Long64_t fsize = fFile->GetSize();
+   char *begin = buffer;
+   for (Int_t i = 0; i < nkeys; i++) {
+      char *record = buffer;
+      Long64_t seekkey, seekpdir;
+      const char *classname, *name;
+      Int_t classlen, namelen;
+      if (!ReadKeyRecord(buffer, end, seekkey, seekpdir, classname, classlen, name, namelen) ||
+          seekkey < 64 || seekkey > fsize || seekpdir < 64 || seekpdir > fsize) {
+         Error("ReadKeys","reading illegal key, exiting after %d keys",i);
+         buffer = record;
+         nkeys = i;
+         break;
+      }
+      records->fRecords.push_back({TString::Hash(name, namelen), (Int_t)(record - begin), nullptr});
+   }
+   records->fBuffer.assign(begin, buffer);
+   std::stable_sort(records->fRecords.begin(), records->fRecords.end(),
+                    [](const TRecord &a, const TRecord &b) { return a.fHash < b.fHash; });
+   fKeysRecords = records.release();
+   return nkeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the keys with the given name which were not created yet, if the
+/// directory was read lazily (see IndexKeys()).
+/// The keys are added to fKeys in file order, so that the highest cycle comes first.
+
+void TDirectoryFile::LoadKeys(const char *name) const
+{
+   if (!fKeysRecords || !name) return;
+
+   using TRecord = ROOT::Internal::TDirectoryFileKeys::TRecord;
+   auto &records = fKeysRecords->fRecords;
+   TRecord hash{TString::Hash(name, strlen(name)), 0, nullptr};
+   auto range = std::equal_range(records.begin(), records.end(), hash,
+                                 [](const TRecord &a, const TRecord &b) { return a.fHash < b.fHash; });
+   for (auto rec = range.first; rec != range.second; ++rec) {
+      if (rec->fKey) continue;
+      // keys with another name and the same hash are created as well
+      rec->fKey = new TKey(const_cast<TDirectoryFile *>(this));
+      char *buffer = fKeysRecords->fBuffer.data() + rec->fPos;
+      rec->fKey->ReadKeyBuffer(buffer);
+      fKeys->Add(rec->fKey);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create all the keys not created yet, if the directory was read lazily
+/// (see IndexKeys()). fKeys then holds all the keys in file order.
+
+void TDirectoryFile::LoadKeys() const
+{
+   if (!fKeysRecords) return;
+
+   using TRecord = ROOT::Internal::TDirectoryFileKeys::TRecord;
+   auto &records = fKeysRecords->fRecords;
+   std::sort(records.begin(), records.end(), [](const TRecord &a, const TRecord &b) { return a.fPos < b.fPos; });
+
+   // the keys created already are added again in file order
+   fKeys->Clear("nodelete");
+   Int_t nkeys = records.size();
+   if (nkeys > kKeysCapacity)
+      ((THashList *)fKeys)->Rehash(nkeys);
+   for (auto &rec : records) {
+      if (!rec.fKey) {
+         rec.fKey = new TKey(const_cast<TDirectoryFile *>(this));
+         char *buffer = fKeysRecords->fBuffer.data() + rec.fPos;
+         rec.fKey->ReadKeyBuffer(buffer);
+      }
+      fKeys->Add(rec.fKey);
+   }
+   SafeDelete(fKeysRecords);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of the directory.
+/// The keys of a read-only directory which were not looked up yet are created.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   LoadKeys();
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the directory, also of the ones not created yet.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   return fKeysRecords ? (Int_t)fKeysRecords->fRecords.size() : fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the directory for objects of the class classname,
+/// without creating the keys not created yet.
+
+Int_t TDirectoryFile::CountKeys(const char *classname) const
+{
+   Int_t n = 0;
+   if (!fKeysRecords) {
+      TIter next(fKeys);
+      while (TKey *key = (TKey *)next()) {
+         if (!strcmp(key->GetClassName(), classname)) n++;
+      }
+      return n;
+   }
+
+   Int_t len = strlen(classname);
+   char *buffer = fKeysRecords->fBuffer.data();
+   const char *end = buffer + fKeysRecords->fBuffer.size();
+   Long64_t seekkey, seekpdir;
+   const char *keyclass, *name;
+   Int_t classlen, namelen;
+   while (ReadKeyRecord(buffer, end, seekkey, seekpdir, keyclass, classlen, name, namelen)) {
+      if (classlen == len && !strncmp(keyclass, classname, len)) n++;
+   }
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
 ///
@@ -1416,7 +1657,8 @@ Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
 {
    if (!fFile) { Error("Read","No file open"); return 0; }
    TKey *key = 0;
-   TIter nextkey(GetListOfKeys());
+   LoadKeys(keyname);
+   TIter nextkey(((THashList *)fKeys)->GetListForObject(keyname));
    while ((key = (TKey *) nextkey())) {
       if (strcmp(keyname,key->GetName()) == 0) {
          return key->Read(obj);
@@ -1625,6 +1867,9 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 {
    TDirectory::TContext ctxt(this);
 
+   // keys are only created on demand in read-only directories
+   if (writable)
+      LoadKeys();
    fWritable = writable;
 
    // recursively set all sub-directories
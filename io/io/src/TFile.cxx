@@ -127,6 +127,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TStopwatch.h"
 #include "compiledata.h"
 #include <cmath>
+#include <functional>
 #include <set>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
@@ -869,7 +870,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file.",GetName());
             }
          }
@@ -878,11 +879,7 @@ void TFile::Init(Bool_t create)
 
    // Count number of TProcessIDs in this file
    {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
+      fNProcessIDs = CountKeys("TProcessID");
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
    return;
@@ -1309,10 +1306,55 @@ Long64_t TFile::GetSize() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the cached list of StreamerInfos used in this file.
+/// In concurrent read mode (see SetConcurrentRead()) the list was read when the
+/// mode was enabled and is never modified, so that it can be used by several
+/// threads.
 
 const TList *TFile::GetStreamerInfoCache()
 {
-   return fInfoCache ?  fInfoCache : (fInfoCache=GetStreamerInfoList());
+   if (!fInfoCache && !fConcurrentRead)
+      fInfoCache = GetStreamerInfoList();
+   return fInfoCache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the objects of class cl with the given version are stored
+/// in this file with the layout of the in-memory class and of a compiled
+/// Streamer(), i.e. if the StreamerInfo of this file for that version has the
+/// checksum of the in-memory class and exactly the elements named in members.
+/// Used by TBufferFile::ReadVersionForCompiledStreamer.
+///
+/// The result is cached per class together with the checksum of the class,
+/// so that the list of StreamerInfos is scanned once per class and a new
+/// class loaded at the address of an unloaded one is checked again.
+
+Bool_t TFile::HasCompiledLayout(const TClass *cl, Version_t version, const char *const *members)
+{
+   const UInt_t checksum = cl->GetCheckSum();
+   {
+      std::lock_guard<std::mutex> lock(fCompiledLayoutsMutex);
+      auto iter = fCompiledLayouts.find(cl);
+      if (iter != fCompiledLayouts.end() && iter->second.first == checksum)
+         return iter->second.second;
+   }
+
+   Bool_t result = kFALSE;
+   if (fVersion >= 30000) {
+      R__LOCKGUARD(gInterpreterMutex);
+      if (const TList *infos = GetStreamerInfoCache()) {
+         for (TObject *obj : *infos) {
+            TStreamerInfo *info = dynamic_cast<TStreamerInfo *>(obj);
+            if (info && info->TStreamerInfo::GetClassVersion() == version && !strcmp(info->GetName(), cl->GetName())) {
+               result = info->TStreamerInfo::GetCheckSum() == checksum && info->MatchElementNames(members);
+               break;
+            }
+         }
+      }
+   }
+
+   std::lock_guard<std::mutex> lock(fCompiledLayoutsMutex);
+   fCompiledLayouts[cl] = std::make_pair(checksum, result);
+   return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1617,23 +1659,31 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
    if (IsOpen()) {
 
-      SetOffset(pos);
-
       Int_t st;
       Double_t start = 0;
       if (gPerfStats != 0) start = TTimeStamp();
 
-      if ((st = ReadBufferViaCache(buf, len))) {
-         if (st == 2)
-            return kTRUE;
-         return kFALSE;
-      }
-
-      Seek(pos);
       ssize_t siz;
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
-         ResetErrno();
+      if (fConcurrentRead) {
+         // Neither the file cursor nor the read cache are used, several
+         // threads may read at different positions at the same time.
+         while ((siz = SysReadAt(fD, buf, len, pos + fArchiveOffset)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      } else {
+         SetOffset(pos);
+
+         if ((st = ReadBufferViaCache(buf, len))) {
+            if (st == 2)
+               return kTRUE;
+            return kFALSE;
+         }
+
+         Seek(pos);
+
+         while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      }
 
       if (siz < 0) {
          SysError("ReadBuffer", "error reading from file %s", GetName());
@@ -1644,6 +1694,11 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
                GetName(), (Long_t)siz, len);
          return kTRUE;
       }
+
+      std::unique_lock<std::mutex> lock(fReadMutex, std::defer_lock);
+      if (fConcurrentRead)
+         lock.lock();
+
       fBytesRead  += siz;
       fgBytesRead += siz;
       fReadCalls++;
@@ -2016,6 +2071,7 @@ Int_t TFile::Recover()
          if (!strcmp(key->GetName(),"StreamerInfo")) {
             fSeekInfo = seekkey;
             SafeDelete(fInfoCache);
+            fCompiledLayouts.clear();
             fNbytesInfo = nbytes;
          } else {
             AppendKey(key);
@@ -2235,6 +2291,54 @@ void TFile::SetCompressionSettings(Int_t settings)
    fCompress = settings;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allow objects to be read from this file by several threads at the same time.
+///
+/// In this mode the file is treated as immutable: TDirectoryFile::Get(),
+/// TDirectoryFile::GetObjectChecked(), TKey::ReadObj() and TKey::ReadObjectAny()
+/// can be called concurrently on the same TFile. Data is read with positional
+/// reads and every call uses its own buffers. The directory structure is loaded
+/// once when the mode is enabled, as is the list of StreamerInfos (see
+/// GetStreamerInfoCache()); objects read afterwards are not added to the
+/// directory and are owned by the caller.
+/// ROOT::EnableThreadSafety() must have been called. The mode is only available
+/// for local files opened for reading; no read cache (TTreeCache) is used in this mode.
+/// Returns kFALSE if the mode could not be enabled.
+
+Bool_t TFile::SetConcurrentRead(Bool_t enable)
+{
+   if (!enable) {
+      fConcurrentRead = kFALSE;
+      return kTRUE;
+   }
+   if (!IsOpen() || IsWritable()) {
+      Error("SetConcurrentRead", "file %s must be opened in read mode", GetName());
+      return kFALSE;
+   }
+   if (IsA() != TFile::Class()) {
+      Error("SetConcurrentRead", "concurrent reading is not supported for %s", IsA()->GetName());
+      return kFALSE;
+   }
+
+   // Read all subdirectories now, later lookups then never modify the lists of the directories.
+   std::function<void(TDirectory *)> loadSubdirs = [&loadSubdirs](TDirectory *dir) {
+      TIter next(dir->GetListOfKeys());
+      while (TKey *key = (TKey *)next()) {
+         TClass *cl = TClass::GetClass(key->GetClassName());
+         if (!cl || !cl->InheritsFrom(TDirectoryFile::Class()))
+            continue;
+         if (TDirectory *subdir = dir->GetDirectory(key->GetName()))
+            loadSubdirs(subdir);
+      }
+   };
+   loadSubdirs(this);
+   // Fill the cache now: it is read, and no longer filled, by the concurrent reads.
+   GetStreamerInfoCache();
+
+   fConcurrentRead = kTRUE;
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set a pointer to the read cache.
 ///
@@ -2510,6 +2614,7 @@ void TFile::WriteFree()
 void TFile::WriteHeader()
 {
    SafeDelete(fInfoCache);
+   fCompiledLayouts.clear();
    TFree *lastfree = (TFree*)fFree->Last();
    if (lastfree) fEND  = lastfree->GetFirst();
    const char *root = "root";
@@ -4371,6 +4476,24 @@ Int_t TFile::SysRead(Int_t fd, void *buf, Int_t len)
    return ::read(fd, buf, len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read len bytes at the absolute position offset without using the file
+/// cursor, like POSIX pread(). Used when objects are read concurrently.
+
+Int_t TFile::SysReadAt(Int_t fd, void *buf, Int_t len, Long64_t offset)
+{
+#if defined(R__SEEK64)
+   return ::pread64(fd, buf, len, offset);
+#elif defined(WIN32)
+   std::lock_guard<std::mutex> lock(fReadMutex);
+   if (SysSeek(fd, offset, SEEK_SET) < 0)
+      return -1;
+   return SysRead(fd, buf, len);
+#else
+   return ::pread(fd, buf, len, offset);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to system write. All arguments like in POSIX write().
 
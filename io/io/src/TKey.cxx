@@ -731,41 +731,38 @@ TObject *TKey::ReadObj()
       return (TObject*)ReadObjectAny(0);
    }
 
-   fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
-   if (!fBufferRef) {
+   TBufferFile *bufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   char *buffer = nullptr;
+   if (!bufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
       return 0;
    }
    if (GetFile()==0) return 0;
-   fBufferRef->SetParent(GetFile());
-   fBufferRef->SetPidOffset(fPidOffset);
+   bufferRef->SetParent(GetFile());
+   bufferRef->SetPidOffset(fPidOffset);
 
    if (fObjlen > fNbytes-fKeylen) {
-      fBuffer = new char[fNbytes];
-      if( !ReadFile() )                    //Read object structure from file
+      buffer = new char[fNbytes];
+      if( !ReadFileBuffer(buffer) )            //Read object structure from file
       {
-        delete fBufferRef;
-        delete [] fBuffer;
-        fBufferRef = 0;
-        fBuffer = 0;
+        delete bufferRef;
+        delete [] buffer;
         return 0;
       }
-      memcpy(fBufferRef->Buffer(),fBuffer,fKeylen);
+      memcpy(bufferRef->Buffer(),buffer,fKeylen);
    } else {
-      fBuffer = fBufferRef->Buffer();
-      if( !ReadFile() ) {                   //Read object structure from file
-         delete fBufferRef;
-         fBufferRef = 0;
-         fBuffer = 0;
+      buffer = bufferRef->Buffer();
+      if( !ReadFileBuffer(buffer) ) {           //Read object structure from file
+         delete bufferRef;
          return 0;
       }
    }
 
    // get version of key
-   fBufferRef->SetBufferOffset(sizeof(fNbytes));
-   Version_t kvers = fBufferRef->ReadVersion();
+   bufferRef->SetBufferOffset(sizeof(fNbytes));
+   Version_t kvers = bufferRef->ReadVersion();
 
-   fBufferRef->SetBufferOffset(fKeylen);
+   bufferRef->SetBufferOffset(fKeylen);
    TObject *tobj = 0;
    // Create an instance of this class
 
@@ -784,11 +781,11 @@ TObject *TKey::ReadObj()
    }
    tobj = (TObject*)(pobj+baseOffset);
    if (kvers > 1)
-      fBufferRef->MapObject(pobj,cl);  //register obj in map to handle self reference
+      bufferRef->MapObject(pobj,cl);  //register obj in map to handle self reference
 
    if (fObjlen > fNbytes-fKeylen) {
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
+      char *objbuf = bufferRef->Buffer() + fKeylen;
+      UChar_t *bufcur = (UChar_t *)&buffer[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -802,10 +799,10 @@ TObject *TKey::ReadObj()
          objbuf += nout;
       }
       if (nout) {
-         tobj->Streamer(*fBufferRef); //does not work with example 2 above
-         delete [] fBuffer;
+         tobj->Streamer(*bufferRef); //does not work with example 2 above
+         delete [] buffer;
       } else {
-         delete [] fBuffer;
+         delete [] buffer;
          // Even-though we have a TObject, if the class is emulated the virtual
          // table may not be 'right', so let's go via the TClass.
          cl->Destructor(pobj);
@@ -814,7 +811,7 @@ TObject *TKey::ReadObj()
          goto CLEAR;
       }
    } else {
-      tobj->Streamer(*fBufferRef);
+      tobj->Streamer(*bufferRef);
    }
 
    if (gROOT->GetForceStyle()) tobj->UseCurrentStyle();
@@ -824,11 +821,13 @@ TObject *TKey::ReadObj()
       dir->SetName(GetName());
       dir->SetTitle(GetTitle());
       dir->SetMother(fMotherDir);
-      fMotherDir->Append(dir);
+      // the directories of a file read concurrently must not be modified
+      if (!GetFile()->IsConcurrentRead())
+         fMotherDir->Append(dir);
    }
 
    // Append the object to the directory if requested:
-   {
+   if (!GetFile()->IsConcurrentRead()) {
       ROOT::DirAutoAdd_t addfunc = cl->GetDirectoryAutoAdd();
       if (addfunc) {
          addfunc(pobj, fMotherDir);
@@ -836,9 +835,7 @@ TObject *TKey::ReadObj()
    }
 
 CLEAR:
-   delete fBufferRef;
-   fBufferRef = 0;
-   fBuffer    = 0;
+   delete bufferRef;
 
    return tobj;
 }
@@ -953,11 +950,13 @@ TObject *TKey::ReadObjWithBuffer(char *bufferRead)
       dir->SetName(GetName());
       dir->SetTitle(GetTitle());
       dir->SetMother(fMotherDir);
-      fMotherDir->Append(dir);
+      // the directories of a file read concurrently must not be modified
+      if (!GetFile()->IsConcurrentRead())
+         fMotherDir->Append(dir);
    }
 
    // Append the object to the directory if requested:
-   {
+   if (!GetFile()->IsConcurrentRead()) {
       ROOT::DirAutoAdd_t addfunc = cl->GetDirectoryAutoAdd();
       if (addfunc) {
          addfunc(pobj, fMotherDir);
@@ -999,29 +998,30 @@ CLEAR:
 
 void *TKey::ReadObjectAny(const TClass* expectedClass)
 {
-   fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
-   if (!fBufferRef) {
+   TBufferFile *bufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   char *buffer = nullptr;
+   if (!bufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
       return 0;
    }
    if (GetFile()==0) return 0;
-   fBufferRef->SetParent(GetFile());
-   fBufferRef->SetPidOffset(fPidOffset);
+   bufferRef->SetParent(GetFile());
+   bufferRef->SetPidOffset(fPidOffset);
 
    if (fObjlen > fNbytes-fKeylen) {
-      fBuffer = new char[fNbytes];
-      ReadFile();                    //Read object structure from file
-      memcpy(fBufferRef->Buffer(),fBuffer,fKeylen);
+      buffer = new char[fNbytes];
+      ReadFileBuffer(buffer);            //Read object structure from file
+      memcpy(bufferRef->Buffer(),buffer,fKeylen);
    } else {
-      fBuffer = fBufferRef->Buffer();
-      ReadFile();                    //Read object structure from file
+      buffer = bufferRef->Buffer();
+      ReadFileBuffer(buffer);            //Read object structure from file
    }
 
    // get version of key
-   fBufferRef->SetBufferOffset(sizeof(fNbytes));
-   Version_t kvers = fBufferRef->ReadVersion();
+   bufferRef->SetBufferOffset(sizeof(fNbytes));
+   Version_t kvers = bufferRef->ReadVersion();
 
-   fBufferRef->SetBufferOffset(fKeylen);
+   bufferRef->SetBufferOffset(fKeylen);
    TClass *cl = TClass::GetClass(fClassName.Data());
    TClass *clOnfile = 0;
    if (!cl) {
@@ -1062,11 +1062,11 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    }
 
    if (kvers > 1)
-      fBufferRef->MapObject(pobj,cl);  //register obj in map to handle self reference
+      bufferRef->MapObject(pobj,cl);  //register obj in map to handle self reference
 
    if (fObjlen > fNbytes-fKeylen) {
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
+      char *objbuf = bufferRef->Buffer() + fKeylen;
+      UChar_t *bufcur = (UChar_t *)&buffer[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1080,16 +1080,16 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
          objbuf += nout;
       }
       if (nout) {
-         cl->Streamer((void*)pobj, *fBufferRef, clOnfile);    //read object
-         delete [] fBuffer;
+         cl->Streamer((void*)pobj, *bufferRef, clOnfile);    //read object
+         delete [] buffer;
       } else {
-         delete [] fBuffer;
+         delete [] buffer;
          cl->Destructor(pobj);
          pobj = 0;
          goto CLEAR;
       }
    } else {
-      cl->Streamer((void*)pobj, *fBufferRef, clOnfile);    //read object
+      cl->Streamer((void*)pobj, *bufferRef, clOnfile);    //read object
    }
 
    if (cl->IsTObject()) {
@@ -1108,11 +1108,13 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
          dir->SetName(GetName());
          dir->SetTitle(GetTitle());
          dir->SetMother(fMotherDir);
-         fMotherDir->Append(dir);
+         // the directories of a file read concurrently must not be modified
+         if (!GetFile()->IsConcurrentRead())
+            fMotherDir->Append(dir);
       }
    }
 
-   {
+   if (!GetFile()->IsConcurrentRead()) {
       // Append the object to the directory if requested:
       ROOT::DirAutoAdd_t addfunc = cl->GetDirectoryAutoAdd();
       if (addfunc) {
@@ -1121,9 +1123,7 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    }
 
    CLEAR:
-   delete fBufferRef;
-   fBufferRef = 0;
-   fBuffer    = 0;
+   delete bufferRef;
 
    return ( ((char*)pobj) + baseOffset );
 }
@@ -1251,25 +1251,26 @@ void TKey::ReadKeyBuffer(char *&buffer)
 /// Read the key structure from the file
 
 Bool_t TKey::ReadFile()
+{
+   return ReadFileBuffer(fBuffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the key structure from the file into the provided buffer of at least fNbytes.
+/// The file cursor is not used, therefore the file may be read concurrently
+/// (see TFile::SetConcurrentRead()).
+
+Bool_t TKey::ReadFileBuffer(char *buffer)
 {
    TFile* f = GetFile();
    if (f==0) return kFALSE;
 
    Int_t nsize = fNbytes;
-   f->Seek(fSeekKey);
-#if 0
-   for (Int_t i = 0; i < nsize; i += kMAXFILEBUFFER) {
-      int nb = kMAXFILEBUFFER;
-      if (i+nb > nsize) nb = nsize - i;
-      f->ReadBuffer(fBuffer+i,nb);
-   }
-#else
-   if( f->ReadBuffer(fBuffer,nsize) )
+   if( f->ReadBuffer(buffer,fSeekKey,nsize) )
    {
       Error("ReadFile", "Failed to read data.");
       return kFALSE;
    }
-#endif
    if (gDebug) {
       std::cout << "TKey Reading "<<nsize<< " bytes at address "<<fSeekKey<<std::endl;
    }
@@ -3164,6 +3164,21 @@ TClass *TStreamerInfo::GetActualClass(const void *obj) const
    return (TClass*)fClass;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the elements of this StreamerInfo are, in order, exactly
+/// the ones named in the null terminated array names.
+
+Bool_t TStreamerInfo::MatchElementNames(const char *const *names) const
+{
+   const Int_t n = fElements ? fElements->GetEntriesFast() : 0;
+   Int_t i = 0;
+   for (; names[i]; ++i) {
+      if (i >= n || strcmp(fElements->UncheckedAt(i)->GetName(), names[i]) != 0)
+         return kFALSE;
+   }
+   return i == n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return true if the checksum passed as argument is one of the checksum
 /// value produced by the older checksum calculation algorithm.
@@ -0,0 +1,20 @@
+#include "Rtypes.h"
+#include "TObject.h"
+
+/**
+ * Class whose Streamer() is generated with rootcling -compiledStreamers,
+ * to compare the inlined read with the generic ReadClassBuffer.
+ */
+
+class CompiledStreamerHit : public TObject {
+public:
+   Int_t     fId = 0;
+   Bool_t    fValid = kFALSE;
+   Short_t   fCharge = 0;
+   Float_t   fPos[3] = {0, 0, 0};
+   Double_t  fCov[2][2] = {{0, 0}, {0, 0}};
+   Long64_t  fTime = 0;
+   UChar_t   fFlags = 0;
+   Double_t  fCache = 0; //! transient, not read
+   ClassDef(CompiledStreamerHit, 2);
+};
@@ -0,0 +1,194 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TList.h"
+#include "TStreamerInfo.h"
+
+#include "gtest/gtest.h"
+
+#include "CompiledStreamer.h"
+
+#include <memory>
+
+// The StreamerInfo elements read and written by the generated Streamer().
+static const char *const gMembers[] = {"TObject", "fId", "fValid", "fCharge", "fPos", "fCov", "fTime", "fFlags", nullptr};
+
+static void FillHit(CompiledStreamerHit &hit, Int_t i)
+{
+   hit.fId = i;
+   hit.fValid = (i % 2 == 0);
+   hit.fCharge = Short_t(i % 3 - 1);
+   for (int k = 0; k < 3; ++k)
+      hit.fPos[k] = 0.5f * i + k;
+   for (int k = 0; k < 4; ++k)
+      hit.fCov[k / 2][k % 2] = 1e-3 * i * (k + 1);
+   hit.fTime = 1000000000000LL + i;
+   hit.fFlags = UChar_t(i & 0xff);
+   hit.fCache = -1;
+   hit.SetUniqueID(i + 7);
+}
+
+static void CheckHit(const CompiledStreamerHit &hit, Int_t i)
+{
+   CompiledStreamerHit ref;
+   FillHit(ref, i);
+   EXPECT_EQ(ref.fId, hit.fId);
+   EXPECT_EQ(ref.fValid, hit.fValid);
+   EXPECT_EQ(ref.fCharge, hit.fCharge);
+   for (int k = 0; k < 3; ++k)
+      EXPECT_EQ(ref.fPos[k], hit.fPos[k]);
+   for (int k = 0; k < 4; ++k)
+      EXPECT_EQ(ref.fCov[k / 2][k % 2], hit.fCov[k / 2][k % 2]);
+   EXPECT_EQ(ref.fTime, hit.fTime);
+   EXPECT_EQ(ref.fFlags, hit.fFlags);
+   EXPECT_EQ(ref.GetUniqueID(), hit.GetUniqueID());
+   EXPECT_EQ(0, hit.fCache);
+}
+
+// Many objects in a row: the inlined read must consume exactly the bytes
+// written by WriteClassBuffer.
+TEST(TBufferFile, CompiledStreamerRoundTrip)
+{
+   const Int_t n = 100;
+   TBufferFile buf(TBuffer::kWrite);
+   CompiledStreamerHit hit;
+   for (Int_t i = 0; i < n; ++i) {
+      FillHit(hit, i);
+      hit.Streamer(buf);
+   }
+   buf << Int_t(-42); // Trailer to check the bytes consumed.
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   for (Int_t i = 0; i < n; ++i) {
+      CompiledStreamerHit read;
+      read.Streamer(buf);
+      CheckHit(read, i);
+   }
+   Int_t trailer = 0;
+   buf >> trailer;
+   EXPECT_EQ(-42, trailer);
+}
+
+// The inlined write must produce exactly the bytes of WriteClassBuffer.
+TEST(TBufferFile, CompiledStreamerWrite)
+{
+   CompiledStreamerHit hit;
+   FillHit(hit, 5);
+
+   TBufferFile compiled(TBuffer::kWrite);
+   UInt_t bcnt = 0;
+   EXPECT_TRUE(compiled.WriteVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, gMembers, &bcnt));
+   compiled.SetBufferOffset(0);
+   hit.Streamer(compiled);
+
+   TBufferFile generic(TBuffer::kWrite);
+   generic.WriteClassBuffer(CompiledStreamerHit::Class(), &hit);
+
+   ASSERT_EQ(generic.Length(), compiled.Length());
+   EXPECT_EQ(0, memcmp(generic.Buffer(), compiled.Buffer(), generic.Length()));
+}
+
+// A list of members which is not the one of the StreamerInfo, e.g. because a
+// transient member was taken as persistent, is refused.
+TEST(TBufferFile, CompiledStreamerMembersCheck)
+{
+   static const char *const withTransient[] = {"TObject", "fId", "fValid", "fCharge", "fPos",
+                                               "fCov", "fTime", "fFlags", "fCache", nullptr};
+   static const char *const missingLast[] = {"TObject", "fId", "fValid", "fCharge", "fPos", "fCov", "fTime", nullptr};
+
+   TBufferFile buf(TBuffer::kWrite);
+   UInt_t bcnt = 0;
+   EXPECT_FALSE(buf.WriteVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, withTransient, &bcnt));
+   EXPECT_FALSE(buf.WriteVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, missingLast, &bcnt));
+   EXPECT_EQ(0, buf.Length());
+
+   CompiledStreamerHit hit;
+   FillHit(hit, 1);
+   hit.Streamer(buf);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   UInt_t start = 0;
+   EXPECT_FALSE(buf.ReadVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, withTransient, &start, &bcnt));
+   EXPECT_FALSE(buf.ReadVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, missingLast, &start, &bcnt));
+   EXPECT_EQ(0, buf.Length());
+}
+
+TEST(TBufferFile, CompiledStreamerFromFile)
+{
+   const auto filename = "TBufferFileCompiledStreamer.root";
+   {
+      TFile f(filename, "RECREATE");
+      CompiledStreamerHit hit;
+      for (Int_t i = 0; i < 10; ++i) {
+         FillHit(hit, i);
+         f.WriteObject(&hit, TString::Format("hit%d", i));
+      }
+   }
+   TFile f(filename);
+   for (Int_t i = 0; i < 10; ++i) {
+      std::unique_ptr<CompiledStreamerHit> hit(f.Get<CompiledStreamerHit>(TString::Format("hit%d", i)));
+      ASSERT_NE(nullptr, hit);
+      CheckHit(*hit, i);
+   }
+}
+
+// Write one object in a buffer read back with parent as its file and return
+// whether the inlined read is accepted for it.
+static bool AcceptsCompiledStreamer(TObject *parent)
+{
+   TBufferFile buf(TBuffer::kWrite);
+   CompiledStreamerHit hit;
+   FillHit(hit, 3);
+   hit.Streamer(buf);
+   const Int_t written = buf.Length();
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.SetParent(parent);
+   UInt_t start = 0, bcnt = 0;
+   const bool accepted = buf.ReadVersionForCompiledStreamer(CompiledStreamerHit::Class(), 2, gMembers, &start, &bcnt);
+   if (accepted) {
+      buf.SetBufferOffset(0);
+   } else {
+      // nothing consumed
+      EXPECT_EQ(0, buf.Length());
+   }
+   // Either way the object is read completely.
+   CompiledStreamerHit read;
+   read.Streamer(buf);
+   CheckHit(read, 3);
+   EXPECT_EQ(written, buf.Length());
+   return accepted;
+}
+
+// The inlined read is used from the first object when the StreamerInfo of the
+// file has the checksum of the in-memory class, and not otherwise.
+TEST(TBufferFile, CompiledStreamerLayoutCheck)
+{
+   EXPECT_TRUE(AcceptsCompiledStreamer(nullptr));
+
+   const auto filename = "TBufferFileCompiledStreamerLayout.root";
+   {
+      TFile f(filename, "RECREATE");
+      CompiledStreamerHit hit;
+      f.WriteObject(&hit, "hit");
+   }
+   {
+      TFile f(filename);
+      EXPECT_TRUE(AcceptsCompiledStreamer(&f));
+      // The result is cached by the file.
+      EXPECT_TRUE(AcceptsCompiledStreamer(&f));
+   }
+
+   // Pretend the file was written by a different layout of the same version.
+   TFile f(filename);
+   TStreamerInfo *info = nullptr;
+   for (TObject *obj : *f.GetStreamerInfoCache()) {
+      if (!strcmp(obj->GetName(), "CompiledStreamerHit"))
+         info = dynamic_cast<TStreamerInfo *>(obj);
+   }
+   ASSERT_NE(nullptr, info);
+   info->SetCheckSum(CompiledStreamerHit::Class()->GetCheckSum() + 1);
+   EXPECT_FALSE(AcceptsCompiledStreamer(&f));
+}
@@ -0,0 +1,193 @@
+#include "TBufferFile.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Round trip arrays of primitives of all sizes through the byte swapping
+// array routines, including lengths which are not a multiple of the vector width.
+template <typename T>
+void CheckFastArrayRoundTrip(Int_t n)
+{
+   std::vector<T> in(n), out(n);
+   for (Int_t i = 0; i < n; ++i)
+      in[i] = T(i * 3 - n);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteFastArray(in.data(), n);
+   buf.WriteArray(in.data(), n);
+   ASSERT_EQ(Int_t(2 * sizeof(T) * n + sizeof(Int_t)), buf.Length());
+
+   // The on-file representation is big endian.
+   if (n > 1) {
+      const unsigned char *raw = reinterpret_cast<const unsigned char *>(buf.Buffer()) + sizeof(T);
+      ULong64_t value = 0;
+      for (size_t k = 0; k < sizeof(T); ++k)
+         value = (value << 8) | raw[k];
+      EXPECT_EQ(in[1], T(value));
+   }
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.ReadFastArray(out.data(), n);
+   EXPECT_EQ(in, out);
+   T *ptr = out.data();
+   std::fill(out.begin(), out.end(), T(0));
+   EXPECT_EQ(n, buf.ReadArray(ptr));
+   EXPECT_EQ(in, out);
+}
+
+TEST(TBufferFile, FastArrayRoundTrip)
+{
+   for (Int_t n : {1, 2, 7, 8, 15, 16, 17, 31, 33, 64, 1001}) {
+      CheckFastArrayRoundTrip<Short_t>(n);
+      CheckFastArrayRoundTrip<Int_t>(n);
+      CheckFastArrayRoundTrip<Long64_t>(n);
+   }
+}
+
+TEST(TBufferFile, FastArrayFloatingPoint)
+{
+   const Int_t n = 1003;
+   std::vector<Float_t> f(n), fout(n);
+   std::vector<Double_t> d(n), dout(n);
+   for (Int_t i = 0; i < n; ++i) {
+      f[i] = 0.5f * i - 17.25f;
+      d[i] = 1e-3 * i * i - 42.125;
+   }
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteFastArray(f.data(), n);
+   buf.WriteFastArray(d.data(), n);
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.ReadFastArray(fout.data(), n);
+   buf.ReadFastArray(dout.data(), n);
+   EXPECT_EQ(0, memcmp(f.data(), fout.data(), n * sizeof(Float_t)));
+   EXPECT_EQ(0, memcmp(d.data(), dout.data(), n * sizeof(Double_t)));
+}
+
+// Expected big endian representation of the value, independent of the host byte order.
+template <typename T>
+std::vector<unsigned char> BigEndianBytes(const T &value)
+{
+   ULong64_t word = 0;
+   if (sizeof(T) == 2) {
+      UShort_t w;
+      memcpy(&w, &value, sizeof(T));
+      word = w;
+   } else if (sizeof(T) == 4) {
+      UInt_t w;
+      memcpy(&w, &value, sizeof(T));
+      word = w;
+   } else {
+      memcpy(&word, &value, sizeof(T));
+   }
+   std::vector<unsigned char> bytes(sizeof(T));
+   for (size_t k = 0; k < sizeof(T); ++k)
+      bytes[sizeof(T) - 1 - k] = (word >> (8 * k)) & 0xff;
+   return bytes;
+}
+
+// Compare the buffer content byte by byte and read it back with all array routines,
+// with arbitrary bit patterns (including NaNs for floating point) and the array
+// starting at any offset in the buffer.
+template <typename T>
+void CheckFastArrayBytes(Int_t n, Int_t offset)
+{
+   std::mt19937_64 gen(n * 8 + offset);
+   std::vector<T> in(n), out(n);
+   for (auto &value : in) {
+      ULong64_t bits = gen();
+      memcpy(&value, &bits, sizeof(T));
+   }
+
+   TBufferFile buf(TBuffer::kWrite);
+   for (Int_t k = 0; k < offset; ++k)
+      buf.WriteChar('x');
+   buf.WriteFastArray(in.data(), n);
+   buf.WriteArray(in.data(), n);
+   ASSERT_EQ(Int_t(offset + 2 * sizeof(T) * n + sizeof(Int_t)), buf.Length());
+
+   const unsigned char *raw = reinterpret_cast<const unsigned char *>(buf.Buffer()) + offset;
+   const unsigned char *rawArray = raw + sizeof(T) * n + sizeof(Int_t);
+   for (Int_t i = 0; i < n; ++i) {
+      auto expected = BigEndianBytes(in[i]);
+      ASSERT_EQ(0, memcmp(expected.data(), raw + i * sizeof(T), sizeof(T)))
+         << "WriteFastArray, size " << sizeof(T) << ", n " << n << ", offset " << offset << ", index " << i;
+      ASSERT_EQ(0, memcmp(expected.data(), rawArray + i * sizeof(T), sizeof(T)))
+         << "WriteArray, size " << sizeof(T) << ", n " << n << ", offset " << offset << ", index " << i;
+   }
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(offset);
+   buf.ReadFastArray(out.data(), n);
+   EXPECT_EQ(0, memcmp(in.data(), out.data(), n * sizeof(T))) << "ReadFastArray, n " << n << ", offset " << offset;
+   std::fill(out.begin(), out.end(), T(0));
+   T *ptr = out.data();
+   EXPECT_EQ(n, buf.ReadArray(ptr));
+   EXPECT_EQ(0, memcmp(in.data(), out.data(), n * sizeof(T))) << "ReadArray, n " << n << ", offset " << offset;
+
+   buf.SetBufferOffset(offset + sizeof(T) * n);
+   std::fill(out.begin(), out.end(), T(0));
+   EXPECT_EQ(n, buf.ReadStaticArray(out.data()));
+   EXPECT_EQ(0, memcmp(in.data(), out.data(), n * sizeof(T))) << "ReadStaticArray, n " << n << ", offset " << offset;
+}
+
+TEST(TBufferFile, FastArrayBytes)
+{
+   // around the 16 and 32 bytes vector widths, the 64 bytes dispatch threshold and odd tails
+   for (Int_t n : {1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 1001}) {
+      for (Int_t offset = 0; offset < 8; ++offset) {
+         CheckFastArrayBytes<Short_t>(n, offset);
+         CheckFastArrayBytes<Int_t>(n, offset);
+         CheckFastArrayBytes<Long64_t>(n, offset);
+         CheckFastArrayBytes<Float_t>(n, offset);
+         CheckFastArrayBytes<Double_t>(n, offset);
+      }
+   }
+}
+
+// Micro benchmark of the array conversion, as used for std::vector<float> members
+// and flat ntuple branches, against reading the same floats one at a time. Only the
+// results are checked; the throughputs are reported, as timings are not reliable in CI.
+TEST(TBufferFile, FastArrayThroughput)
+{
+   const Int_t n = 1 << 20;
+   const Int_t nrepeat = 20;
+   std::vector<Float_t> values(n), bulk(n), single(n);
+   std::iota(values.begin(), values.end(), 0.f);
+
+   TBufferFile buf(TBuffer::kWrite, n * sizeof(Float_t) + 1024);
+   buf.WriteFastArray(values.data(), n);
+   buf.SetReadMode();
+
+   TStopwatch bulkTimer;
+   for (Int_t r = 0; r < nrepeat; ++r) {
+      buf.SetBufferOffset(0);
+      buf.ReadFastArray(bulk.data(), n);
+   }
+   bulkTimer.Stop();
+
+   TStopwatch singleTimer;
+   for (Int_t r = 0; r < nrepeat; ++r) {
+      buf.SetBufferOffset(0);
+      for (Int_t i = 0; i < n; ++i)
+         buf.ReadFloat(single[i]);
+   }
+   singleTimer.Stop();
+
+   EXPECT_EQ(values, bulk);
+   EXPECT_EQ(values, single);
+
+   const double megabytes = 1e-6 * nrepeat * n * sizeof(Float_t);
+   if (bulkTimer.RealTime() > 0 && singleTimer.RealTime() > 0)
+      printf("ReadFastArray(Float_t*): %.1f MB/s, ReadFloat loop: %.1f MB/s\n", megabytes / bulkTimer.RealTime(),
+             megabytes / singleTimer.RealTime());
+}
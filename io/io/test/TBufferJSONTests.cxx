@@ -0,0 +1,106 @@
+#include "TBufferJSON.h"
+#include "TH2.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+static std::unique_ptr<TH2D> MakeHist()
+{
+   auto h = std::make_unique<TH2D>("h2", "json test", 200, 0., 1., 200, 0., 1.);
+   h->SetDirectory(nullptr);
+   // sparse content with repetitions, exercises all kinds of array compression
+   for (Int_t i = 0; i < 100000; ++i)
+      h->Fill(0.3 + 0.2 * ((i * 7919) % 1000) / 1000., 0.5 + 0.1 * ((i * 104729) % 997) / 997.);
+   for (Int_t bin = 1; bin <= 50; ++bin)
+      h->SetBinContent(bin, 190, 5.);
+   return h;
+}
+
+// The streamed output must be identical to the string produced by ConvertToJSON
+TEST(TBufferJSON, StreamToSink)
+{
+   auto h = MakeHist();
+   for (Int_t compact : {0, 3, 13, 23}) {
+      TString json = TBufferJSON::ConvertToJSON(h.get(), compact);
+      std::ostringstream os;
+      Long64_t len = TBufferJSON::ConvertToJSON(os, h.get(), compact);
+      EXPECT_EQ(json.Length(), len);
+      EXPECT_EQ(std::string(json.Data()), os.str());
+   }
+}
+
+TEST(TBufferJSON, CompressedArraysRoundTrip)
+{
+   auto h = MakeHist();
+   for (Int_t compact : {0, 13, 23}) {
+      TString json = TBufferJSON::ConvertToJSON(h.get(), compact);
+      TH2D *hread = nullptr;
+      ASSERT_TRUE(TBufferJSON::FromJSON(hread, json.Data()));
+      std::unique_ptr<TH2D> guard(hread);
+      ASSERT_EQ(h->GetNcells(), hread->GetNcells());
+      for (Int_t bin = 0; bin < h->GetNcells(); ++bin)
+         EXPECT_EQ(h->GetBinContent(bin), hread->GetBinContent(bin));
+      EXPECT_EQ(h->GetEntries(), hread->GetEntries());
+   }
+}
+
+// Strings with escaped characters and edge numbers are read back exactly
+TEST(TBufferJSON, SpecialValuesRoundTrip)
+{
+   TNamed named("name", "title with \"quotes\", back\\slash, /slash,\ttab and\nnew line");
+   TString json = TBufferJSON::ToJSON(&named);
+   TNamed *nread = nullptr;
+   ASSERT_TRUE(TBufferJSON::FromJSON(nread, json.Data()));
+   std::unique_ptr<TNamed> nguard(nread);
+   EXPECT_STREQ(named.GetTitle(), nread->GetTitle());
+
+   TH1D h("h1", "edge values", 10, 0., 1.);
+   h.SetDirectory(nullptr);
+   const Double_t values[] = {4.9e-324, 2.2250738585072014e-308, 1.7976931168e+308, 9007199254740993.,
+                              -0.,      0.1,                     1e23,              123456789012345678901.,
+                              -1e-5,    3.141592653589793};
+   for (Int_t bin = 1; bin <= 10; ++bin)
+      h.SetBinContent(bin, values[bin - 1]);
+   json = TBufferJSON::ToJSON(&h);
+   TH1D *hread = nullptr;
+   ASSERT_TRUE(TBufferJSON::FromJSON(hread, json.Data()));
+   std::unique_ptr<TH1D> hguard(hread);
+   // doubles are stored with a limited precision, compare with the value of the stored text
+   char buf[200];
+   for (Int_t bin = 1; bin <= 10; ++bin)
+      EXPECT_EQ(std::strtod(TBufferText::ConvertDouble(values[bin - 1], buf, sizeof(buf)), nullptr),
+                hread->GetBinContent(bin))
+         << "bin " << bin;
+}
+
+// Unicode escapes are not produced by TBufferJSON, but must be accepted
+TEST(TBufferJSON, UnicodeEscape)
+{
+   TNamed named("name", "title");
+   TString json = TBufferJSON::ToJSON(&named);
+   json.ReplaceAll("\"title\"", "\"\\u0074itle \\u00e9\"");
+   TNamed *nread = nullptr;
+   ASSERT_TRUE(TBufferJSON::FromJSON(nread, json.Data()));
+   std::unique_ptr<TNamed> guard(nread);
+   EXPECT_STREQ("title \xc3\xa9", nread->GetTitle());
+}
+
+// The size returned by ExportToFile is the size of the JSON
+TEST(TBufferJSON, ExportToFile)
+{
+   auto h = MakeHist();
+   const char *fname = "TBufferJSONTests_export.json";
+   TString json = TBufferJSON::ConvertToJSON(h.get(), 23);
+   EXPECT_EQ(json.Length(), TBufferJSON::ExportToFile(fname, h.get(), "23"));
+   std::ifstream ifs(fname);
+   std::stringstream content;
+   content << ifs.rdbuf();
+   EXPECT_EQ(std::string(json.Data()), content.str());
+   gSystem->Unlink(fname);
+}
@@ -1,8 +1,18 @@
+#include "TDirectoryFile.h"
 #include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TROOT.h"
 #include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 // Tests ROOT-9857
 TEST(TFile, ReadFromSameFile)
 {
@@ -22,4 +32,159 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+TEST(TFile, ConcurrentRead)
+{
+   ROOT::EnableThreadSafety();
+
+   const auto filename = "ConcurrentRead.root";
+   const int nobj = 200;
+   {
+      TFile f(filename, "RECREATE");
+      auto sub = f.mkdir("sub");
+      for (int i = 0; i < nobj; ++i) {
+         TNamed obj(TString::Format("obj%d", i), TString::Format("title %d", i));
+         f.WriteTObject(&obj);
+         sub->WriteTObject(&obj);
+      }
+   }
+
+   TFile f(filename);
+   ASSERT_TRUE(f.SetConcurrentRead());
+   // the StreamerInfos are read when the mode is enabled, not by the reading threads
+   const TList *infos = f.GetStreamerInfoCache();
+   ASSERT_NE(nullptr, infos);
+   EXPECT_NE(nullptr, infos->FindObject("TNamed"));
+
+   std::atomic<int> nerrors(0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&f, &nerrors, infos, t]() {
+         for (int i = 0; i < nobj; ++i) {
+            const int n = (i + 17 * t) % nobj;
+            std::unique_ptr<TNamed> o1(f.Get<TNamed>(TString::Format("obj%d", n)));
+            std::unique_ptr<TObject> o2(f.Get(TString::Format("sub/obj%d", n)));
+            if (!o1 || !o2 || (o1->GetTitle() != TString::Format("title %d", n)) ||
+                (o2->GetTitle() != TString::Format("title %d", n)) || f.GetStreamerInfoCache() != infos)
+               ++nerrors;
+         }
+      });
+   }
+   for (auto &th : threads)
+      th.join();
+
+   EXPECT_EQ(0, nerrors);
+   // read objects are owned by the caller, the directories are not modified
+   EXPECT_EQ(1, f.GetList()->GetSize());
+
+   TFile fw(filename, "UPDATE");
+   EXPECT_FALSE(fw.SetConcurrentRead());
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, GetKeyCycles)
+{
+   const auto filename = "GetKeyCycles.root";
+   const int nobj = 5000;
+   {
+      TFile f(filename, "RECREATE");
+      for (int i = 0; i < nobj; ++i) {
+         TNamed obj(TString::Format("obj%d", i).Data(), "cycle 1");
+         f.WriteTObject(&obj);
+      }
+      TNamed obj("obj42", "cycle 2");
+      f.WriteTObject(&obj);
+   }
+
+   TFile f(filename);
+   EXPECT_EQ(nobj + 1, f.GetNkeys());
+   std::unique_ptr<TNamed> last(f.Get<TNamed>("obj42"));
+   ASSERT_TRUE(last != nullptr);
+   EXPECT_STREQ("cycle 2", last->GetTitle());
+   std::unique_ptr<TNamed> first(f.Get<TNamed>("obj42;1"));
+   ASSERT_TRUE(first != nullptr);
+   EXPECT_STREQ("cycle 1", first->GetTitle());
+   std::unique_ptr<TObject> any(f.Get("obj4999"));
+   EXPECT_TRUE(any != nullptr);
+   EXPECT_EQ(nullptr, f.Get("obj5000"));
+
+   gSystem->Unlink(filename);
+}
+
+namespace {
+// Number of keys of a directory which were created already
+struct TKeysInMemory : public TDirectoryFile {
+   static Int_t Get(const TDirectoryFile &dir) { return (dir.*(&TKeysInMemory::fKeys))->GetSize(); }
+};
+} // namespace
+
+// The keys of a read-only directory are created when they are looked up
+TEST(TFile, LazyKeys)
+{
+   const auto filename = "LazyKeys.root";
+   const int nobj = 5000;
+   {
+      TFile f(filename, "RECREATE");
+      for (int i = 0; i < nobj; ++i) {
+         TNamed obj(TString::Format("obj%d", i).Data(), "cycle 1");
+         f.WriteTObject(&obj);
+      }
+      TNamed obj("obj42", "cycle 2");
+      f.WriteTObject(&obj);
+      TNamed subobj("subobj", "in sub");
+      f.mkdir("sub")->WriteTObject(&subobj);
+   }
+
+   {
+      TFile f(filename);
+      EXPECT_EQ(nobj + 2, f.GetNkeys());
+      EXPECT_EQ(0, TKeysInMemory::Get(f));
+
+      std::unique_ptr<TNamed> last(f.Get<TNamed>("obj42"));
+      ASSERT_TRUE(last != nullptr);
+      EXPECT_STREQ("cycle 2", last->GetTitle());
+      std::unique_ptr<TNamed> first(f.Get<TNamed>("obj42;1"));
+      ASSERT_TRUE(first != nullptr);
+      EXPECT_STREQ("cycle 1", first->GetTitle());
+      EXPECT_TRUE(f.GetKey("obj4999") != nullptr);
+      EXPECT_EQ(nullptr, f.GetKey("obj5000"));
+      std::unique_ptr<TNamed> subobj(f.Get<TNamed>("sub/subobj"));
+      ASSERT_TRUE(subobj != nullptr);
+      EXPECT_STREQ("in sub", subobj->GetTitle());
+      // obj42 (2 cycles), obj4999 and sub, and the keys with a colliding hash
+      EXPECT_LT(TKeysInMemory::Get(f), 10);
+
+      // all the keys, in file order
+      TList *keys = f.GetListOfKeys();
+      ASSERT_EQ(nobj + 2, keys->GetSize());
+      EXPECT_EQ(nobj + 2, TKeysInMemory::Get(f));
+      EXPECT_STREQ("obj0", keys->At(0)->GetName());
+      EXPECT_STREQ("obj42", keys->At(42)->GetName());
+      EXPECT_EQ(2, ((TKey *)keys->At(42))->GetCycle());
+      EXPECT_EQ(1, ((TKey *)keys->At(43))->GetCycle());
+      EXPECT_STREQ("sub", keys->Last()->GetName());
+      EXPECT_EQ(keys->At(42), f.GetKey("obj42"));
+   }
+
+   // keys are created for writing
+   {
+      TFile f(filename);
+      std::unique_ptr<TNamed> obj(f.Get<TNamed>("obj7"));
+      ASSERT_EQ(0, f.ReOpen("UPDATE"));
+      EXPECT_EQ(nobj + 2, TKeysInMemory::Get(f));
+      TNamed newobj("obj7", "cycle 2");
+      f.WriteTObject(&newobj);
+   }
+   {
+      TFile f(filename, "UPDATE");
+      EXPECT_EQ(nobj + 3, TKeysInMemory::Get(f));
+   }
+   TFile f(filename);
+   EXPECT_EQ(nobj + 3, f.GetNkeys());
+   std::unique_ptr<TNamed> obj7(f.Get<TNamed>("obj7"));
+   ASSERT_TRUE(obj7 != nullptr);
+   EXPECT_STREQ("cycle 2", obj7->GetTitle());
+
+   gSystem->Unlink(filename);
+}
@@ -18,12 +18,52 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TRint.h"
+#ifndef WIN32
+#include "TSystem.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef int (*TMPForkServer_t)(const char *sockpath, int nlibs, char **libs);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run a fork server: `root.exe --fork-server <socket path> [libraries]`.
+/// The session is initialized and the libraries are loaded once, then the
+/// session is forked for every job submitted with TMPForkServer::Submit().
+/// libMultiProc is only loaded in this mode.
+
+static int RunForkServer(int argc, char **argv, int iarg)
+{
+   int bargc = 2;
+   char batch[] = "-b";
+   char *bargv[] = { argv[0], batch, nullptr };
+   TApplication theApp("ForkServer", &bargc, bargv);
+
+   const char *mplib = "libMultiProc";
+   if (gSystem->Load(mplib) < 0) {
+      fprintf(stderr, "%s: can't load %s\n", argv[0], mplib);
+      return 1;
+   }
+   Func_t f = gSystem->DynFindSymbol(mplib, "RunTMPForkServer");
+   if (!f) {
+      fprintf(stderr, "%s: can't find RunTMPForkServer\n", argv[0]);
+      return 1;
+   }
+   return (*((TMPForkServer_t)f))(argv[iarg + 1], argc - iarg - 2, argv + iarg + 2);
+}
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Create an interactive ROOT application
 
 int main(int argc, char **argv)
 {
+#ifndef WIN32
+   // the root launcher passes -splash as first argument
+   int iarg = (argc > 1 && !strcmp(argv[1], "-splash")) ? 2 : 1;
+   if (argc > iarg + 1 && !strcmp(argv[iarg], "--fork-server"))
+      return RunForkServer(argc, argv, iarg);
+#endif
+
    TRint *theApp = new TRint("Rint", &argc, argv);
 
    // and enter the event loop...
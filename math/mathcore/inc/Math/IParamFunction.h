@@ -127,6 +127,19 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+         Evaluate function at the n points x for given parameters p, storing the values in result.
+         The coordinates of the points are stored one after the other, NDim() values each.
+         The default implementation evaluates the points one by one; derived classes can
+         re-implement it with a more efficient (e.g. vectorized) loop.
+         */
+         virtual void EvalBatch(unsigned int n, const T *x, const double *p, T *result) const
+         {
+            const unsigned int ndim = this->NDim();
+            for (unsigned int i = 0; i < n; ++i)
+               result[i] = DoEvalPar(x + i * ndim, p);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -49,6 +49,10 @@ namespace ROOT {
 
       namespace FitUtil {
 
+         // number of points for which the model function is evaluated at once
+         // in EvaluateChi2 and EvaluateLogL
+         const unsigned int kNEvalBlock = 256;
+
          // derivative with respect of the parameter to be integrated
          template<class GradFunc = IGradModelFunction>
          struct ParamDerivFunc {
@@ -270,99 +274,115 @@ namespace ROOT {
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
-
-      double chi2{};
-      double fval{};
+   // The model is evaluated for blocks of points at once, so that functions
+   // implementing EvalBatch() can run a single (vectorizable) loop over them.
+   const unsigned int ndim = data.NDim();
+   const unsigned int nBlocks = (n + kNEvalBlock - 1) / kNEvalBlock;
 
-      const auto x1 = data.GetCoordComponent(i, 0);
-      const auto y = data.Value(i);
-      auto invError = data.InvError(i);
+#ifdef R__USE_IMT
+   // the first batch evaluation may need to prepare the (jitted) batch function:
+   // do it here in sequential mode, as in EvaluateLogL
+   if (n > 0 && !useBinIntegral) {
+      std::vector<double> x(ndim);
+      for (unsigned int j = 0; j < ndim; ++j)
+         x[j] = *data.GetCoordComponent(0, j);
+      double fval = 0;
+      func.EvalBatch(1, x.data(), p, &fval);
+   }
+#endif
 
-      //invError = (invError!= 0.0) ? 1.0/invError :1;
+   auto mapFunction = [&](const unsigned iBlock){
 
-      const double * x = nullptr;
-      std::vector<double> xc;
-      double binVolume = 1.0;
-      if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         const double * x2 = data.BinUpEdge(i);
-         xc.resize(data.NDim());
-         for (unsigned int j = 0; j < ndim; ++j) {
-            auto xx = *data.GetCoordComponent(i, j);
-            binVolume *= std::abs(x2[j]- xx);
-            xc[j] = 0.5*(x2[j]+ xx);
+      double chi2{};
+      const unsigned int iBegin = iBlock * kNEvalBlock;
+      const unsigned int nb = std::min(n - iBegin, kNEvalBlock);
+
+      std::vector<double> xb(nb * ndim);
+      double fvals[kNEvalBlock];
+      double binVolumes[kNEvalBlock];
+
+      for (unsigned int k = 0; k < nb; ++k) {
+         const unsigned int i = iBegin + k;
+         double * x = &xb[k * ndim];
+         double binVolume = 1.0;
+         if (useBinVolume) {
+            const double * x2 = data.BinUpEdge(i);
+            for (unsigned int j = 0; j < ndim; ++j) {
+               auto xx = *data.GetCoordComponent(i, j);
+               binVolume *= std::abs(x2[j]- xx);
+               x[j] = 0.5*(x2[j]+ xx);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
+         } else {
+            for (unsigned int j = 0; j < ndim; ++j)
+               x[j] = *data.GetCoordComponent(i, j);
          }
-         x = xc.data();
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      } else if(data.NDim() > 1) {
-         xc.resize(data.NDim());
-         xc[0] = *x1;
-         for (unsigned int j = 1; j < data.NDim(); ++j)
-            xc[j] = *data.GetCoordComponent(i, j);
-         x = xc.data();
-      } else {
-            x = x1;
+         binVolumes[k] = binVolume;
       }
 
-
       if (!useBinIntegral) {
-#ifdef USE_PARAMCACHE
-         fval = func ( x );
-#else
-         fval = func ( x, p );
-#endif
+         func.EvalBatch(nb, xb.data(), p, fvals);
       }
       else {
          // calculate integral normalized by bin volume
          // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x, data.BinUpEdge(i)) ;
+         for (unsigned int k = 0; k < nb; ++k)
+            fvals[k] = igEval( &xb[k * ndim], data.BinUpEdge(iBegin + k)) ;
       }
-      // normalize result if requested according to bin volume
-      if (useBinVolume) fval *= binVolume;
 
-      // expected errors
-      if (useExpErrors) {
-         double invWeight  = 1.0; 
-         if (isWeighted) {
-            // we need first to check if a weight factor needs to be applied
-            // weight = sumw2/sumw = error**2/content
-            //invWeight = y * invError * invError;
-            // we use always the global weight and not the observed one in the bin
-            // for empty bins use global weight (if it is weighted data.SumError2() is not zero)
-            invWeight = data.SumOfContent()/ data.SumOfError2();
-            //if (invError > 0) invWeight = y * invError * invError;
-         }
+      for (unsigned int k = 0; k < nb; ++k) {
+         const unsigned int i = iBegin + k;
+         const auto y = data.Value(i);
+         auto invError = data.InvError(i);
+         double fval = fvals[k];
+         double binVolume = binVolumes[k];
+
+         // normalize result if requested according to bin volume
+         if (useBinVolume) fval *= binVolume;
+
+         // expected errors
+         if (useExpErrors) {
+            double invWeight  = 1.0; 
+            if (isWeighted) {
+               // we need first to check if a weight factor needs to be applied
+               // weight = sumw2/sumw = error**2/content
+               //invWeight = y * invError * invError;
+               // we use always the global weight and not the observed one in the bin
+               // for empty bins use global weight (if it is weighted data.SumError2() is not zero)
+               invWeight = data.SumOfContent()/ data.SumOfError2();
+               //if (invError > 0) invWeight = y * invError * invError;
+            }
          
-         //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
-         invError = std::sqrt(invError2);
-         //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
-      }
+            //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
+            // compute expected error  as f(x) / weight
+            double invError2 = (fval > 0) ? invWeight / fval : 0.0;
+            invError = std::sqrt(invError2);
+            //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
+         }
 
 //#define DEBUG
 #ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
+         std::cout << xb[k * ndim] << "  " << y << "  " << 1./invError << " params : ";
+         for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+            std::cout << p[ipar] << "\t";
+         std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
 #endif
 //#undef DEBUG
 
-      if (invError > 0) {
+         if (invError > 0) {
 
-         double tmp = ( y -fval )* invError;
-         double resval = tmp * tmp;
+            double tmp = ( y -fval )* invError;
+            double resval = tmp * tmp;
 
 
-         // avoid inifinity or nan in chi2 values due to wrong function values
-         if ( resval < maxResValue )
-            chi2 += resval;
-         else {
-            //nRejected++;
-            chi2 += maxResValue;
+            // avoid inifinity or nan in chi2 values due to wrong function values
+            if ( resval < maxResValue )
+               chi2 += resval;
+            else {
+               //nRejected++;
+               chi2 += maxResValue;
+            }
          }
       }
       return chi2;
@@ -385,14 +405,14 @@ namespace ROOT {
 
   double res{};
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+    for (unsigned int ib=0; ib<nBlocks; ++ib) {
+      res += mapFunction(ib);
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
     ROOT::TThreadExecutor pool;
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(nBlocks);
+    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -918,15 +938,19 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
          // in case parameter needs to be propagated to user function use trick to set parameters by calling one time the function
          // this will be done in sequential mode and parameters can be set in a thread safe manner
          if (!normalizeFunc) {
+            // the first batch evaluation may also need to prepare the (jitted) batch function
+            double fval = 0;
             if (data.NDim() == 1) {
                const double * x = data.GetCoordComponent(0,0);
                func( x, p);
+               func.EvalBatch(1, x, p, &fval);
             }
             else {
                std::vector<double> x(data.NDim());
                for (unsigned int j = 0; j < data.NDim(); ++j)
                   x[j] = *data.GetCoordComponent(0, j);
                func( x.data(), p);
+               func.EvalBatch(1, x.data(), p, &fval);
             }
          }
 #endif
@@ -959,49 +983,55 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
 
          // needed to compue effective global weight in case of extended likelihood
 
-         auto mapFunction = [&](const unsigned i) {
-            double W = 0;
-            double W2 = 0;
-            double fval = 0;
+         // The model is evaluated for blocks of points at once, so that functions
+         // implementing EvalBatch() can run a single (vectorizable) loop over them.
+         const unsigned int ndim = data.NDim();
+         const unsigned int nBlocks = (n + kNEvalBlock - 1) / kNEvalBlock;
 
-            if (data.NDim() > 1) {
-               std::vector<double> x(data.NDim());
-               for (unsigned int j = 0; j < data.NDim(); ++j)
-                  x[j] = *data.GetCoordComponent(i, j);
-#ifdef USE_PARAMCACHE
-               fval = func(x.data());
-#else
-               fval = func(x.data(), p);
-#endif
+         auto mapFunction = [&](const unsigned iBlock) {
+            const unsigned int iBegin = iBlock * kNEvalBlock;
+            const unsigned int nb = std::min(n - iBegin, kNEvalBlock);
+            double fvals[kNEvalBlock];
+
+            if (ndim > 1) {
+               std::vector<double> xb(nb * ndim);
+               for (unsigned int k = 0; k < nb; ++k)
+                  for (unsigned int j = 0; j < ndim; ++j)
+                     xb[k * ndim + j] = *data.GetCoordComponent(iBegin + k, j);
+               func.EvalBatch(nb, xb.data(), p, fvals);
 
-               // one -dim case
+               // one -dim case: the coordinates are contiguous
             } else {
-               const auto x = data.GetCoordComponent(i, 0);
-#ifdef USE_PARAMCACHE
-               fval = func(x);
-#else
-               fval = func(x, p);
-#endif
+               func.EvalBatch(nb, data.GetCoordComponent(iBegin, 0), p, fvals);
             }
 
-            if (normalizeFunc)
-               fval = fval * (1 / norm);
-
-            // function EvalLog protects against negative or too small values of fval
-            double logval = ROOT::Math::Util::EvalLog(fval);
-            if (iWeight > 0) {
-               double weight = data.Weight(i);
-               logval *= weight;
-               if (iWeight == 2) {
-                  logval *= weight; // use square of weights in likelihood
-                  if (!extended) {
-                     // needed sum of weights and sum of weight square if likelkihood is extended
-                     W = weight;
-                     W2 = weight * weight;
+            LikelihoodAux<double> res(0.0, 0.0, 0.0);
+            for (unsigned int k = 0; k < nb; ++k) {
+               const unsigned int i = iBegin + k;
+               double W = 0;
+               double W2 = 0;
+               double fval = fvals[k];
+
+               if (normalizeFunc)
+                  fval = fval * (1 / norm);
+
+               // function EvalLog protects against negative or too small values of fval
+               double logval = ROOT::Math::Util::EvalLog(fval);
+               if (iWeight > 0) {
+                  double weight = data.Weight(i);
+                  logval *= weight;
+                  if (iWeight == 2) {
+                     logval *= weight; // use square of weights in likelihood
+                     if (!extended) {
+                        // needed sum of weights and sum of weight square if likelkihood is extended
+                        W = weight;
+                        W2 = weight * weight;
+                     }
                   }
                }
+               res += LikelihoodAux<double>(logval, W, W2);
             }
-            return LikelihoodAux<double>(logval, W, W2);
+            return res;
          };
 
 #ifdef R__USE_IMT
@@ -1034,8 +1064,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   double sumW{};
   double sumW2{};
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      auto resArray = mapFunction(i);
+    for (unsigned int ib=0; ib<nBlocks; ++ib) {
+      auto resArray = mapFunction(ib);
       logl+=resArray.logvalue;
       sumW+=resArray.weight;
       sumW2+=resArray.weight2;
@@ -1043,8 +1073,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
     ROOT::TThreadExecutor pool;
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(nBlocks);
+    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
     logl=resArray.logvalue;
     sumW=resArray.weight;
     sumW2=resArray.weight2;
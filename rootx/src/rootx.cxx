@@ -315,6 +315,7 @@ int main(int argc, char **argv)
       if (!strcmp(argv[i], "-config"))    gNoLogo  = true;
       if (!strcmp(argv[i], "--version"))  gNoLogo  = true;
       if (!strcmp(argv[i], "--notebook")) notebook = true;
+      if (!strcmp(argv[i], "--fork-server")) batch = true;
    }
 
    if (notebook) {
@@ -105,6 +105,9 @@ protected:
    TVirtualCollectionIterators           *fIterators;      ///<! holds the iterators when the branch is of fType==4.
    TVirtualCollectionIterators           *fWriteIterators; ///<! holds the read (non-staging) iterators when the branch is of fType==4 and associative containers.
    TVirtualCollectionPtrIterators        *fPtrIterators;   ///<! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
+   std::vector<void*>                     fElementPool;    ///<! elements of a split collection of pointers kept for reuse (see TTree::SetReuseCollectionElements).
+   Long64_t                               fNElementsNew{0};    ///<! number of elements of a split collection of pointers created while reading.
+   Long64_t                               fNElementsReused{0}; ///<! number of elements of a split collection of pointers reused while reading.
 
 // Not implemented
 private:
@@ -162,6 +165,7 @@ protected:
    void FillLeavesCustomStreamer(TBuffer& b);
    void FillLeavesMemberBranchCount(TBuffer& b);
    void FillLeavesMemberCounter(TBuffer& b);
+   void                     ClearElementPool();
    void FillLeavesMember(TBuffer& b);
    void SetFillLeavesPtr();
    void SetFillActionSequence();
@@ -202,6 +206,8 @@ public:
    virtual const char      *GetParentName() const { return fParentName.Data(); }
    virtual Int_t            GetMaximum() const;
            Int_t            GetNdata() const { return fNdata; }
+           Long64_t         GetNElementsNew() const { return fNElementsNew; }
+           Long64_t         GetNElementsReused() const { return fNElementsReused; }
            Int_t            GetType() const { return fType; }
            Int_t            GetStreamerType() const { return fStreamerType; }
    virtual TClass          *GetTargetClass() { return fTargetClass; }
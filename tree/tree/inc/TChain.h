@@ -44,6 +44,8 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Long64_t     fNElementsNew{0};    ///<! Elements of split collections of pointers created by the trees read before the current one
+   Long64_t     fNElementsReused{0}; ///<! Elements of split collections of pointers reused by the trees read before the current one
 
 private:
    TChain(const TChain&);            // not implemented
@@ -93,6 +95,7 @@ public:
    virtual Long64_t  GetCacheSize() const { return fTree ? fTree->GetCacheSize() : fCacheSize; }
    virtual Long64_t  GetChainEntryNumber(Long64_t entry) const;
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
+   virtual void      GetCollectionElementsCounts(Long64_t &created, Long64_t &reused) const;
            Int_t     GetNtrees() const { return fNtrees; }
    virtual Long64_t  GetEntries() const;
    virtual Long64_t  GetEntries(const char *sel) { return TTree::GetEntries(sel); }
@@ -163,6 +166,7 @@ public:
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
+   virtual void      SetReuseCollectionElements(Bool_t enabled = kTRUE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
 
@@ -14,6 +14,9 @@
 
 #include "TNamed.h"
 
+#include <utility>
+#include <vector>
+
 class TTree;
 class TDirectory;
 class TObjArray;
@@ -69,6 +72,7 @@ class TEntryList: public TNamed
    virtual TEntryList *GetEntryList(const char *treename, const char *filename, Option_t *opt="");
    virtual Long64_t    GetEntry(Int_t index);
    virtual Long64_t    GetEntryAndTree(Int_t index, Int_t &treenum);
+   virtual Long64_t    GetEntryRuns(Long64_t first, Long64_t last, std::vector<std::pair<Long64_t, Long64_t>> &runs, TTree *tree = 0);
    virtual Long64_t    GetEntriesToProcess() const {return fEntriesToProcess;}
    virtual TList      *GetLists() const { return fLists; }
    virtual TDirectory *GetDirectory() const { return fDirectory; }
@@ -84,6 +88,7 @@ class TEntryList: public TNamed
       return kFALSE;
    }
 
+   virtual void        Intersect(const TEntryList *elist);
    virtual Int_t       Merge(TCollection *list);
 
    virtual Long64_t    Next();
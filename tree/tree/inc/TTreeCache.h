@@ -31,6 +31,7 @@
 class TTree;
 class TBranch;
 class TObjArray;
+class TEntryList;
 
 class TTreeCache : public TFileCacheRead {
 
@@ -54,6 +55,7 @@ protected:
    TObjArray   *fBranches{nullptr};   ///<! List of branches to be stored in the cache
    TList       *fBrNames{nullptr};    ///<! list of branch names in the cache
    TTree       *fTree{nullptr};       ///<! pointer to the current Tree
+   TEntryList  *fEntryList{nullptr};  ///<! entry list selecting the baskets to prefetch (if 0, the one of fTree)
    Bool_t       fIsLearning{kTRUE};   ///<! true if cache is in learning mode
    Bool_t       fIsManual{kFALSE};    ///<! true if cache is StopLearningPhase was used
    Bool_t       fFirstBuffer{kTRUE};  ///<! true if first buffer is used for prefetching
@@ -143,6 +145,7 @@ public:
    EPrefillType         GetConfiguredPrefillType() const;
    Double_t             GetEfficiency() const;
    Double_t             GetEfficiencyRel() const;
+   TEntryList          *GetEntryList() const {return fEntryList;}
    virtual Int_t        GetEntryMin() const {return fEntryMin;}
    virtual Int_t        GetEntryMax() const {return fEntryMax;}
    static Int_t         GetLearnEntries();
@@ -166,6 +169,7 @@ public:
    void                 ResetMissCache(); // Reset the miss cache.
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
+   virtual void         SetEntryList(TEntryList *elist) {fEntryList = elist;}
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
    virtual void         SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect);
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
@@ -46,7 +46,7 @@ public:
 
    TVirtualTreePlayer() { }
    virtual ~TVirtualTreePlayer();
-   virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname) = 0;
+   virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname, Option_t *option = "") = 0;
    virtual TTree         *CopyTree(const char *selection, Option_t *option=""
                                    ,Long64_t nentries=kMaxEntries, Long64_t firstentry=0) = 0;
    virtual Long64_t       DrawScript(const char *wrapperPrefix,
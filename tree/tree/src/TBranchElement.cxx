@@ -977,6 +977,7 @@ TBranchElement::~TBranchElement()
    if (fType == 4 || fType == 0) {
       // Only the top level TBranchElement containing an STL container,
       // owns the collectionproxy.
+      ClearElementPool();
       delete fCollProxy;
    }
    fCollProxy = 0;
@@ -988,6 +989,21 @@ TBranchElement::~TBranchElement()
    delete fPtrIterators;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the elements kept for reuse by ReadLeavesCollection.
+
+void TBranchElement::ClearElementPool()
+{
+   if (fElementPool.empty())
+      return;
+   TClass *elClass = fCollProxy ? fCollProxy->GetValueClass() : nullptr;
+   for (void *el : fElementPool) {
+      if (elClass)
+         elClass->Destructor(el);
+   }
+   fElementPool.clear();
+}
+
 //
 // This function is located here to allow inlining by the optimizer.
 //
@@ -4154,8 +4170,23 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
    // TODO: Exception safety a la TPushPop
    TVirtualCollectionProxy* proxy = GetCollectionProxy();
    TVirtualCollectionProxy::TPushPop helper(proxy, fObject);
+
+   // For a split sequence of pointers, Allocate deletes all the elements which
+   // are then re-created below. When requested, keep them aside instead.
+   const Bool_t splitPointers = proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers;
+   if (splitPointers && GetTree()->GetReuseCollectionElements() && !(proxy->GetProperties() & TVirtualCollectionProxy::kIsAssociative)) {
+      UInt_t nold = proxy->Size();
+      for (UInt_t i = 0; i < nold; ++i) {
+         void **el = (void**)proxy->At(i);
+         if (*el) {
+            fElementPool.push_back(*el);
+            *el = nullptr;
+         }
+      }
+   }
+
    void* alternate = proxy->Allocate(fNdata, true);
-   if(fSTLtype != ROOT::kSTLvector && proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers ) {
+   if(fSTLtype != ROOT::kSTLvector && splitPointers ) {
       fPtrIterators->CreateIterators(alternate, proxy);
    } else {
       fIterators->CreateIterators(alternate, proxy);
@@ -4188,7 +4219,7 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
    // We have split this stuff, so we need to create the the pointers
    /////////////////////////////////////////////////////////////////////////////
 
-   if( proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers )
+   if( splitPointers )
    {
       TClass *elClass = proxy->GetValueClass();
 
@@ -4205,8 +4236,20 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
       for( ; i < fNdata; ++i )
       {
          void **el = (void**)proxy->At( i );
-         // coverity[dereference] since this is a member streaming action by definition the collection contains objects and elClass is not null.
-         *el = elClass->New();
+         if (!fElementPool.empty()) {
+            // Only the memory is reused: the data members without an active
+            // sub-branch (disabled, missing on file or transient) must not keep
+            // the values of the previous entry, so the object is reconstructed.
+            void *mem = fElementPool.back();
+            fElementPool.pop_back();
+            elClass->Destructor(mem, kTRUE);
+            *el = elClass->New(mem);
+            ++fNElementsReused;
+         } else {
+            // coverity[dereference] since this is a member streaming action by definition the collection contains objects and elClass is not null.
+            *el = elClass->New();
+            ++fNElementsNew;
+         }
       }
    }
 
@@ -4649,6 +4692,8 @@ void TBranchElement::ResetAddress()
       if (br) br->ResetAddress();
    }
 
+   ClearElementPool();
+
    //
    // SetAddress may have allocated an object.
    //
@@ -4851,6 +4896,12 @@ void TBranchElement::SetAddress(void* addr)
 
    fReadEntry = -1;
 
+   //
+   //  The elements kept for reuse may not match the new object.
+   //
+
+   ClearElementPool();
+
    //
    // Make sure our branch class is instantiated.
    //
@@ -5692,8 +5743,9 @@ void TBranchElement::SetTargetClass(const char *name)
    if (strcmp(fTargetClass.GetClassName(),name) != 0 )
    {
       // We are changing target class, let's reset the meta information and
-      // the sub-branches.
+      // the sub-branches. The elements kept for reuse are of the old class.
 
+      ClearElementPool();
       ResetInitInfo(/*recurse=*/ kFALSE);
 
       Int_t nbranches = fBranches.GetEntriesFast();
@@ -920,6 +920,21 @@ TTree::TClusterIterator TChain::GetClusterIterator(Long64_t /* firstentry */)
    return TTree::GetClusterIterator(-1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return in created and reused the number of elements of split collections of
+/// pointers created and reused (see SetReuseCollectionElements) while reading
+/// all the trees of the chain loaded so far.
+
+void TChain::GetCollectionElementsCounts(Long64_t &created, Long64_t &reused) const
+{
+   created = 0;
+   reused = 0;
+   if (fTree)
+      fTree->GetCollectionElementsCounts(created, reused);
+   created += fNElementsNew;
+   reused += fNElementsReused;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return absolute entry number in the chain.
 /// The input parameter entry is the entry number in
@@ -1229,6 +1244,14 @@ Double_t TChain::GetWeight() const
 
 void TChain::InvalidateCurrentTree()
 {
+   if (fTree) {
+      // The branches of the current tree, which count the reused collection
+      // elements, are about to be deleted.
+      Long64_t created, reused;
+      fTree->GetCollectionElementsCounts(created, reused);
+      fNElementsNew += created;
+      fNElementsReused += reused;
+   }
    if (fTree && fTree->GetListOfClones()) {
       for (TObjLink* lnk = fTree->GetListOfClones()->FirstLink(); lnk; lnk = lnk->Next()) {
          TTree* clone = (TTree*) lnk->GetObject();
@@ -1630,6 +1653,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   fTree->SetReuseCollectionElements(fReuseCollectionElements);
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
@@ -2902,6 +2926,18 @@ void TChain::SetProof(Bool_t on, Bool_t refresh, Bool_t gettreeheader)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the reuse of the elements of split collections of pointers,
+/// for the current tree and the trees loaded next.
+/// See TTree::SetReuseCollectionElements.
+
+void TChain::SetReuseCollectionElements(Bool_t enabled /* = kTRUE */)
+{
+   TTree::SetReuseCollectionElements(enabled);
+   if (fTree)
+      fTree->SetReuseCollectionElements(enabled);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set chain weight.
 ///
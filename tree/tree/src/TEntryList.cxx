@@ -55,6 +55,10 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - same as Subtract(), but keeps only the entries of the first list
+               that are also in the second list
+- __GetEntryRuns__() - appends the ranges of consecutive entries of the list in a given
+               interval to a vector; this is the fastest way to scan a list
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -648,6 +652,40 @@ Bool_t TEntryList::Remove(Long64_t entry, TTree *tree)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append to runs the ranges [begin, end) of consecutive entries of this list
+/// between first (included) and last (excluded), in increasing order.
+/// Returns the number of entries of the list between first and last.
+///
+/// The entry numbers are local to a tree. If this list has sub-lists, the ranges
+/// are taken from the sub-list of tree (see SetTree()) or, if tree is 0, from the
+/// current sub-list.
+///
+/// This is much faster than calling Next() or Contains() for each entry, the
+/// blocks being scanned a 16-bit word at a time, and lets the caller (for example
+/// TTreeCache) find out which ranges of the tree are actually needed.
+
+Long64_t TEntryList::GetEntryRuns(Long64_t first, Long64_t last, std::vector<std::pair<Long64_t, Long64_t>> &runs, TTree *tree)
+{
+   if (fLists){
+      if (tree) SetTree(tree->GetTree());
+      if (!fCurrent) fCurrent = (TEntryList*)fLists->First();
+      return fCurrent ? fCurrent->GetEntryRuns(first, last, runs) : 0;
+   }
+   if (!fBlocks) return 0;
+   if (first < 0) first = 0;
+   Long64_t npassed = 0;
+   for (Int_t nblock = first/kBlockSize; nblock < fNBlocks; nblock++){
+      Long64_t shift = (Long64_t)nblock*kBlockSize;
+      if (shift >= last) break;
+      TEntryListBlock *block = (TEntryListBlock*)fBlocks->UncheckedAt(nblock);
+      Int_t bfirst = first > shift ? first - shift : 0;
+      Int_t blast = last - shift < kBlockSize ? last - shift : kBlockSize;
+      npassed += block->GetRuns(bfirst, blast, shift, runs);
+   }
+   return npassed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the number of the entry \#index of this TEntryList in the TTree or TChain
 /// See also Next().
@@ -1229,13 +1267,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1270,6 +1312,53 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the entries of this entry list, that are not contained in elist.
+/// Sub-lists for trees that are not in elist become empty.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   TEntryList *templist = 0;
+   if (!fLists){
+      if (!fBlocks) return;
+      const TEntryList *other = 0;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         //second list has sublists, try to find one for the same tree as this list
+         TIter next1(elist->GetLists());
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //intersect block by block, blocks missing in the other list are emptied
+      TEntryListBlock empty;
+      Int_t nother = (other && other->fBlocks) ? other->fNBlocks : 0;
+      fN = 0;
+      for (Int_t i=0; i<fNBlocks; i++){
+         TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+         TEntryListBlock *block2 = i < nother ? (TEntryListBlock*)other->fBlocks->UncheckedAt(i) : &empty;
+         fN += block1->Intersect(block2);
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      fN = 0;
+      while ((templist = (TEntryList*)next2())){
+         templist->Intersect(elist);
+         fN += templist->GetN();
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
@@ -38,6 +38,11 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Subtract__(), __Intersect__() - removes the entries that are (respectively are
+             not) contained in the other block
+ - __GetRuns__() - appends the ranges of consecutive passing entries to a vector.
+             Together with the set operations above, it works on whole 16-bit words
+             of the bits representation rather than on single entries
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,8 +51,76 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <cstring>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in a word
+
+inline Int_t CountBits(UShort_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_popcount(word);
+#else
+   Int_t count = 0;
+   for (; word; ++count)
+      word &= word - 1;
+   return count;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Position of the lowest bit set in a non-zero word
+
+inline Int_t FirstBit(UShort_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(word);
+#else
+   Int_t pos = 0;
+   while (!(word & 1)) {
+      word >>= 1;
+      ++pos;
+   }
+   return pos;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in an array of nwords words
+
+Int_t CountBits(const UShort_t *bits, Int_t nwords)
+{
+   Int_t count = 0;
+   for (Int_t i = 0; i < nwords; i++)
+      count += CountBits(bits[i]);
+   return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the position of the first bit with the given value in [pos, last),
+/// or last if there is none. Whole words are skipped at once.
+
+Int_t FindBit(const UShort_t *bits, Int_t pos, Int_t last, Bool_t value)
+{
+   const UShort_t flip = value ? 0 : 0xFFFF;
+   const Int_t nwords = (last + 15) >> 4;
+   Int_t i = pos >> 4;
+   UShort_t word = (bits[i] ^ flip) & (UShort_t)(0xFFFF << (pos & 15));
+   while (!word) {
+      if (++i >= nwords)
+         return last;
+      word = bits[i] ^ flip;
+   }
+   Int_t found = (i << 4) + FirstBit(word);
+   return found < last ? found : last;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -242,10 +315,12 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
+      if (fIndices)
+         delete [] fIndices;
       fN = block->fN;
       fIndices = new UShort_t[fN];
       for (i=0; i<fN; i++)
@@ -259,36 +334,12 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
       return fNPassed;
    }
    if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
-      }
+      //stored as bits, merge word by word
+      UShort_t buffer[kBlockSize];
+      const UShort_t *bits = block->GetBits(buffer);
+      for (i=0; i<kBlockSize; i++)
+         fIndices[i] |= bits[i];
+      fNPassed = CountBits(fIndices, kBlockSize);
    } else {
       //stored as a list
       if (GetNPassed() + block->GetNPassed() > kBlockSize){
@@ -334,16 +385,19 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
             UShort_t *newlist = new UShort_t[newsize];
             Int_t newpos, current;
             newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
+            for (Int_t iword=0; iword<kBlockSize; iword++){
+               UShort_t word = block->fIndices[iword];
+               for (; word; word &= word-1){
+                  i = (iword<<4) + FirstBit(word);
+                  while(current < fNPassed && fIndices[current]<i){
+                     newlist[newpos] = fIndices[current];
+                     current++;
+                     newpos++;
+                  }
+                  if (current < fNPassed && fIndices[current]==i) current++;
+                  newlist[newpos] = i;
                   newpos++;
                }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
             }
             while(current<fNPassed){
                newlist[newpos] = fIndices[current];
@@ -363,6 +417,85 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove from this block all the entries contained in the other block.
+/// The operation is done word by word on the bits representation.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   if (fType!=0){
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   UShort_t buffer[kBlockSize];
+   const UShort_t *bits = block->GetBits(buffer);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] &= ~bits[i];
+   fNPassed = CountBits(fIndices, kBlockSize);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep in this block only the entries also contained in the other block.
+/// The operation is done word by word on the bits representation.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   if (fType!=0){
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   UShort_t buffer[kBlockSize];
+   const UShort_t *bits = block->GetBits(buffer);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] &= bits[i];
+   fNPassed = CountBits(fIndices, kBlockSize);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append to runs the ranges [begin, end) of consecutive passing entries
+/// of this block between first (included) and last (excluded), shifted by shift.
+/// A range starting where the last range of runs ends is merged with it, so
+/// that consecutive blocks produce a single run.
+/// Returns the number of passing entries between first and last
+
+Int_t TEntryListBlock::GetRuns(Int_t first, Int_t last, Long64_t shift, std::vector<std::pair<Long64_t, Long64_t>> &runs)
+{
+   if (first < 0) first = 0;
+   if (last > kBlockSize*16) last = kBlockSize*16;
+   if (first >= last || GetNPassed() == 0) return 0;
+
+   UShort_t buffer[kBlockSize];
+   const UShort_t *bits = GetBits(buffer);
+   Int_t npassed = 0;
+   Int_t pos = first;
+   while (pos < last) {
+      Int_t begin = FindBit(bits, pos, last, kTRUE);
+      if (begin >= last) break;
+      Int_t end = FindBit(bits, begin, last, kFALSE);
+      npassed += end - begin;
+      if (!runs.empty() && runs.back().second == begin + shift)
+         runs.back().second = end + shift;
+      else
+         runs.emplace_back(begin + shift, end + shift);
+      pos = end;
+   }
+   return npassed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -387,14 +520,15 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //count the entries word by word, then locate the bit in the last word
+         while (entries_found + CountBits(fIndices[i]) < entry+1){
+            entries_found += CountBits(fIndices[i]);
+            if (++i >= kBlockSize) return -1;
          }
+         UShort_t word = fIndices[i];
+         for (; entries_found<entry; entries_found++)
+            word &= word-1;
+         j = FirstBit(word);
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
@@ -454,18 +588,13 @@ Int_t TEntryListBlock::Next()
 
    if (fType==0) {
       //bits
-      Int_t i=0;
-      Int_t j=0;
+      //skip the empty words, there is at least one more entry in the block
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      UShort_t word = fIndices[i] & (UShort_t)(0xFFFF << (fLastIndexReturned & 15));
+      while (!word)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+FirstBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -567,18 +696,12 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    Int_t ilist = 0;
    Int_t ibite, ibit;
    if (!dir) {
-         for (i=0; i<kBlockSize*16; i++){
-            ibite = i >> 4;
-            ibit = i & 15;
-            Bool_t result = (fIndices[ibite] & (1<<ibit))!=0;
-            if (result && fPassing){
-               //fill with the entries that pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
-            else if (!result && !fPassing){
-               //fill with the entries that don't pass
-               indexnew[ilist] = i;
+         //fill with the entries that pass (fPassing) or that don't pass (!fPassing)
+         const UShort_t flip = fPassing ? 0 : 0xFFFF;
+         for (ibite=0; ibite<kBlockSize; ibite++){
+            UShort_t word = fIndices[ibite] ^ flip;
+            for (; word; word &= word-1){
+               indexnew[ilist] = (ibite<<4) + FirstBit(word);
                ilist++;
             }
          }
@@ -618,3 +741,21 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    fPassing = 1;
    return;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the passing entries of this block in the bits representation:
+/// fIndices itself if the block is stored as bits, otherwise buffer (of size
+/// kBlockSize) filled from the list
+
+const UShort_t *TEntryListBlock::GetBits(UShort_t *buffer) const
+{
+   if (fType==0 && fIndices)
+      return fIndices;
+   const Bool_t allPass = fType==1 && !fPassing;
+   memset(buffer, allPass ? 0xFF : 0, kBlockSize*sizeof(UShort_t));
+   if (fType==1 && fIndices){
+      for (Int_t i=0; i<fNPassed; i++)
+         buffer[fIndices[i]>>4] ^= 1<<(fIndices[i] & 15);
+   }
+   return buffer;
+}
@@ -2516,6 +2516,10 @@ void TTree::Browse(TBrowser* b)
 /// See a description of the parameters and functionality in
 /// TTreeIndex::TTreeIndex().
 ///
+/// If option contains "hash", a TTreeHashIndex is built instead: its index
+/// values do not need to be sorted, neither within a tree nor across the
+/// trees of a chain.
+///
 /// The return value is the number of entries in the Index (< 0 indicates failure).
 ///
 /// A TTreeIndex object pointed by fTreeIndex is created.
@@ -2525,9 +2529,9 @@ void TTree::Browse(TBrowser* b)
 /// assigned to the TTree via the TTree::SetTreeIndex() method.
 /// See also comments in TTree::SetTreeIndex().
 
-Int_t TTree::BuildIndex(const char* majorname, const char* minorname /* = "0" */)
+Int_t TTree::BuildIndex(const char* majorname, const char* minorname /* = "0" */, Option_t* option /* = "" */)
 {
-   fTreeIndex = GetPlayer()->BuildIndex(this, majorname, minorname);
+   fTreeIndex = GetPlayer()->BuildIndex(this, majorname, minorname, option);
    if (fTreeIndex->IsZombie()) {
       delete fTreeIndex;
       fTreeIndex = 0;
@@ -4295,6 +4299,16 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// You can use the option "goff" to turn off the graphics output
 /// of TTree::Draw in the above example.
 ///
+/// ### Parallel processing
+///
+/// When implicit multi-threading is enabled (see ROOT::EnableImplicitMT),
+/// the expression is projected into an existing histogram with fixed binning
+/// (e.g. with TTree::Project or `"x>>h"`) or into an entry list, and all the
+/// entries are requested, the entries are processed in parallel; see
+/// TTreePlayer::DrawSelectMT for the exact conditions. GetSelectedRows, GetV1,
+/// GetV2, GetV3, GetVal and GetW then return the same results as with the
+/// sequential loop, but the formulas (GetVar1 etc.) are not available.
+///
 /// ### Automatic interface to TTree::Draw via the TTreeViewer
 ///
 /// A complete graphical interface to this function is implemented
@@ -5216,6 +5230,24 @@ Long64_t TTree::GetCacheAutoSize(Bool_t withDefault /* = kFALSE */ ) const
    return cacheSize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return in created and reused the number of elements of split collections of
+/// pointers created and reused (see SetReuseCollectionElements) by the branches
+/// of this tree while reading.
+
+void TTree::GetCollectionElementsCounts(Long64_t &created, Long64_t &reused) const
+{
+   created = 0;
+   reused = 0;
+   TIter next(const_cast<TTree*>(this)->GetListOfLeaves());
+   while (TLeaf *leaf = (TLeaf*)next()) {
+      if (TBranchElement *br = dynamic_cast<TBranchElement*>(leaf->GetBranch())) {
+         created += br->GetNElementsNew();
+         reused  += br->GetNElementsReused();
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return an iterator over the cluster of baskets starting at firstentry.
 ///
@@ -8906,6 +8938,28 @@ void TTree::SetPerfStats(TVirtualPerfStats *perf)
    fPerfStats = perf;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the reuse of the elements of split collections of pointers
+/// (e.g. `std::vector<Hit*>` split into sub-branches) from entry to entry.
+///
+/// By default, reading an entry deletes the elements of the collection read
+/// for the previous entry and allocates new ones. When enabled, the memory of
+/// the previous elements is kept and the new elements are constructed in it,
+/// which saves an allocation and a deallocation per element. The elements are
+/// still constructed anew, so that their data members which are not read
+/// (disabled or missing sub-branches, transient members) have their default
+/// values rather than the ones of the previous entry; pointers to the elements
+/// of the previous entry must not be used anymore, as without reuse.
+/// Associative collections and TClonesArray (which recycles its objects
+/// anyway) are not affected.
+/// The number of elements created and reused is returned by
+/// GetCollectionElementsCounts().
+
+void TTree::SetReuseCollectionElements(Bool_t enabled /* = kTRUE */)
+{
+   fReuseCollectionElements = enabled;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The current TreeIndex is replaced by the new index.
 /// Note that this function does not delete the previous index.
@@ -283,6 +283,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranch.h"
 #include "TBranchElement.h"
 #include "TEventList.h"
+#include "TEntryList.h"
 #include "TObjArray.h"
 #include "TObjString.h"
 #include "TRegexp.h"
@@ -292,6 +293,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
+#include <algorithm>
 #include <limits.h>
 
 Int_t TTreeCache::fgLearnEntries = 100;
@@ -1097,10 +1099,65 @@ struct BasketRanges {
       }
    }
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of the entries of tree selected by elist, or 0 if
+/// the selection is not known for this tree: for a chain, the entries are
+/// taken from the current sub-list, i.e. the one of the tree being read.
+
+TEntryList *GetSelectionForTree(TEntryList *elist, const TTree *tree)
+{
+   if (!elist)
+      return nullptr;
+   TEntryList *sublist = elist;
+   if (elist->GetLists() || !elist->IsValid())
+      sublist = elist->GetCurrentList();
+   if (!sublist || sublist->GetLists() || !sublist->IsValid())
+      return nullptr;
+   if (sublist != elist) {
+      TString treename = sublist->GetTreeName();
+      if (!treename.IsNull() && treename != tree->GetName() && !treename.EndsWith(TString("/") + tree->GetName()))
+         return nullptr;
+   }
+   return sublist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Ranges of entries selected by a TEntryList, retrieved from the list
+/// (see TEntryList::GetEntryRuns) for a window of entries at a time.
+
+struct SelectedRanges {
+   static constexpr Long64_t kWindow = 16 * TEntryList::kBlockSize;
+
+   TEntryList *fList{nullptr};
+   std::vector<std::pair<Long64_t, Long64_t>> fRuns; ///< Sorted ranges [begin, end[ of selected entries
+   Long64_t fFirst{0};                               ///< First entry covered by fRuns
+   Long64_t fLast{-1};                               ///< End+1 of the entries covered by fRuns
+
+   SelectedRanges(TEntryList *list) : fList(list) {}
+
+   /// Return true if at least one entry in [first, last] is selected.
+   Bool_t ContainsRange(Long64_t first, Long64_t last)
+   {
+      if (first < fFirst || last >= fLast) {
+         fFirst = first;
+         fLast = std::max(last + 1, first + kWindow);
+         fRuns.clear();
+         fList->GetEntryRuns(fFirst, fLast, fRuns);
+      }
+      auto run = std::upper_bound(fRuns.begin(), fRuns.end(), first,
+                                  [](Long64_t e, const std::pair<Long64_t, Long64_t> &r) { return e < r.second; });
+      return run != fRuns.end() && run->first <= last;
+   }
+};
 } // Anonymous namespace.
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the cache buffer with the branches in the cache.
+///
+/// If the owner tree has a TEventList, or a TEntryList (or if one was given
+/// with SetEntryList()), only the baskets containing at least one selected
+/// entry are prefetched, and clusters without any selected entry are skipped.
 
 Bool_t TTreeCache::FillBuffer()
 {
@@ -1295,6 +1352,8 @@ Bool_t TTreeCache::FillBuffer()
          chainOffset = chain->GetTreeOffset()[t];
       }
    }
+   // Same for a TEntryList, which holds the entry numbers local to each tree.
+   SelectedRanges selected(elist ? nullptr : GetSelectionForTree(fEntryList ? fEntryList : fTree->GetEntryList(), tree));
 
    //clear cache buffer
    Int_t ntotCurrentBuf = 0;
@@ -1351,7 +1410,7 @@ Bool_t TTreeCache::FillBuffer()
       };
 
       auto CollectBaskets = [this, elist, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
-       &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
+       &selected, &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
        &ranges, &memRanges, &reqRanges,
        &ntotCurrentBuf, &nReadPrefRequest](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
@@ -1448,7 +1507,9 @@ Bool_t TTreeCache::FillBuffer()
                   continue;
                }
 
-               if (nReadPrefRequest && entries[j] > (reqRanges.AllIncludedRange().fMax + 1)) {
+               if (nReadPrefRequest && entries[j] > (reqRanges.AllIncludedRange().fMax + 1) &&
+                   !(selected.fList &&
+                     !selected.ContainsRange(reqRanges.AllIncludedRange().fMax + 1, entries[j] - 1))) {
                   // There is a gap between this basket and the max of the 'lowest' already loaded basket
                   // If we are tight in memory, reading this basket may prevent reading the basket (for the other branches)
                   // that covers this gap, forcing those baskets to be read uncached (because the cache wont be reloaded
@@ -1457,6 +1518,8 @@ Bool_t TTreeCache::FillBuffer()
                   //   b1: [428, 514[ // 'this' basket and we can assume [321 to 428[ is already in memory
                   //   b2: [400, 424[
                   // and when reading entry 425 we will read b2's basket uncached.
+                  // With an entry list, a gap without any selected entry does not matter
+                  // since none of its baskets will be read.
 
                   if (showMore || gDebug > 8)
                      Info("FillBuffer", "Skipping for now due to gap %d/%d with %lld > %lld", i, j, entries[j],
@@ -1477,6 +1540,9 @@ Bool_t TTreeCache::FillBuffer()
                      emax = entries[j + 1] - 1;
                   if (!elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
                      continue;
+               } else if (selected.fList) {
+                  if (!selected.ContainsRange(entries[j], maxOfBasket(j)))
+                     continue;
                }
 
                if (b->fCacheInfo.HasBeenUsed(j) || b->fCacheInfo.IsInCache(j) || b->fCacheInfo.IsVetoed(j)) {
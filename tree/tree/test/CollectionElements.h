@@ -0,0 +1,25 @@
+#include <vector>
+
+/**
+ * Event with a split collection of pointers, to test the reuse of its
+ * elements while reading.
+ */
+
+struct Hit {
+   float fX = 0;
+   float fY = 0;
+   float fTransient = 0; //! not stored
+};
+
+struct HitEvent {
+   std::vector<Hit *> fHits;
+
+   HitEvent() = default;
+   HitEvent(const HitEvent &) = delete;
+   HitEvent &operator=(const HitEvent &) = delete;
+   ~HitEvent()
+   {
+      for (auto hit : fHits)
+         delete hit;
+   }
+};
@@ -0,0 +1,240 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "CollectionElements.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace {
+
+const Int_t kEntries = 20;
+
+Int_t GetNHits(Int_t entry)
+{
+   return 1 + (entry * 3) % 5;
+}
+
+Float_t GetX(Int_t entry, Int_t hit)
+{
+   return entry + 0.1 * hit;
+}
+
+// Write a tree of kEntries entries with a split vector of pointers
+void WriteTree(const char *fileName)
+{
+   TFile file(fileName, "RECREATE");
+   TTree tree("tree", "tree");
+   HitEvent event;
+   HitEvent *eventPtr = &event;
+   tree.Branch("event", &eventPtr, 32000, 199);
+   for (Int_t entry = 0; entry < kEntries; ++entry) {
+      for (auto hit : event.fHits)
+         delete hit;
+      event.fHits.clear();
+      for (Int_t i = 0; i < GetNHits(entry); ++i) {
+         event.fHits.push_back(new Hit);
+         event.fHits.back()->fX = GetX(entry, i);
+         event.fHits.back()->fY = -GetX(entry, i);
+      }
+      tree.Fill();
+   }
+   file.Write();
+}
+
+// Number of elements created and reused when reading entries [first, last)
+// starting with previous elements left in the collection and in the pool
+void ExpectedCounts(Int_t first, Int_t last, Long64_t previous, Long64_t &created, Long64_t &reused)
+{
+   Long64_t pool = 0;
+   created = 0;
+   reused = 0;
+   for (Int_t entry = first; entry < last; ++entry) {
+      pool += previous;
+      const Long64_t n = GetNHits(entry);
+      const Long64_t taken = std::min(pool, n);
+      reused += taken;
+      created += n - taken;
+      pool -= taken;
+      previous = n;
+   }
+}
+
+void ExpectEntry(const HitEvent &event, Int_t entry)
+{
+   ASSERT_EQ(GetNHits(entry), (Int_t)event.fHits.size());
+   for (Int_t i = 0; i < GetNHits(entry); ++i) {
+      EXPECT_FLOAT_EQ(GetX(entry, i), event.fHits[i]->fX);
+      EXPECT_FLOAT_EQ(-GetX(entry, i), event.fHits[i]->fY);
+   }
+}
+
+} // namespace
+
+// The elements of the previous entry are reused and overwritten
+TEST(TTreeReuseCollectionElements, Reuse)
+{
+   const char *fileName = "ReuseCollectionElements.root";
+   WriteTree(fileName);
+
+   for (Bool_t reuse : {kFALSE, kTRUE}) {
+      TFile file(fileName);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(nullptr, tree);
+      tree->SetReuseCollectionElements(reuse);
+      HitEvent *event = new HitEvent;
+      tree->SetBranchAddress("event", &event);
+      for (Int_t entry = 0; entry < kEntries; ++entry) {
+         tree->GetEntry(entry);
+         ExpectEntry(*event, entry);
+      }
+
+      Long64_t created, reused, expectedCreated, expectedReused;
+      tree->GetCollectionElementsCounts(created, reused);
+      ExpectedCounts(0, kEntries, 0, expectedCreated, expectedReused);
+      if (reuse) {
+         EXPECT_EQ(expectedCreated, created);
+         EXPECT_EQ(expectedReused, reused);
+         EXPECT_GT(reused, 0);
+      } else {
+         EXPECT_EQ(expectedCreated + expectedReused, created);
+         EXPECT_EQ(0, reused);
+      }
+      tree->ResetBranchAddresses();
+      delete event;
+   }
+   gSystem->Unlink(fileName);
+}
+
+// Changing the address drops the elements kept for reuse
+TEST(TTreeReuseCollectionElements, AddressChange)
+{
+   const char *fileName = "ReuseCollectionElementsAddress.root";
+   WriteTree(fileName);
+   // some elements are left in the pool after reading entry 2 after entry 1
+   ASSERT_GT(GetNHits(1), GetNHits(2));
+
+   TFile file(fileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(nullptr, tree);
+   tree->SetReuseCollectionElements();
+   HitEvent *event1 = new HitEvent;
+   tree->SetBranchAddress("event", &event1);
+   tree->GetEntry(1);
+   tree->GetEntry(2);
+   ExpectEntry(*event1, 2);
+
+   HitEvent *event2 = new HitEvent;
+   tree->SetBranchAddress("event", &event2);
+   tree->GetEntry(1);
+   ExpectEntry(*event2, 1);
+   // the entry read into event2 creates all its elements
+   Long64_t created, reused;
+   tree->GetCollectionElementsCounts(created, reused);
+   EXPECT_EQ(2 * GetNHits(1), created);
+   EXPECT_EQ(GetNHits(2), reused);
+   // the elements of event1 were not touched
+   ExpectEntry(*event1, 2);
+
+   tree->ResetBranchAddresses();
+   delete event1;
+   delete event2;
+   gSystem->Unlink(fileName);
+}
+
+// A chain counts the elements of all the trees it read
+TEST(TTreeReuseCollectionElements, Chain)
+{
+   const char *fileNames[2] = {"ReuseCollectionElements1.root", "ReuseCollectionElements2.root"};
+   TChain chain("tree");
+   for (auto fileName : fileNames) {
+      WriteTree(fileName);
+      chain.Add(fileName);
+   }
+   chain.SetReuseCollectionElements();
+   HitEvent *event = new HitEvent;
+   chain.SetBranchAddress("event", &event);
+   for (Int_t entry = 0; entry < 2 * kEntries; ++entry) {
+      chain.GetEntry(entry);
+      ExpectEntry(*event, entry % kEntries);
+   }
+
+   // the first entry of the second tree reuses the elements of the last entry of the first one
+   Long64_t created, reused, created1, reused1, created2, reused2;
+   chain.GetCollectionElementsCounts(created, reused);
+   ExpectedCounts(0, kEntries, 0, created1, reused1);
+   ExpectedCounts(0, kEntries, GetNHits(kEntries - 1), created2, reused2);
+   EXPECT_EQ(created1 + created2, created);
+   EXPECT_EQ(reused1 + reused2, reused);
+
+   chain.ResetBranchAddresses();
+   delete event;
+   for (auto fileName : fileNames)
+      gSystem->Unlink(fileName);
+}
+
+// Reused elements do not keep the values of the previous entry in the data
+// members which are not read: transient ones and disabled sub-branches
+TEST(TTreeReuseCollectionElements, MembersNotRead)
+{
+   const char *fileName = "ReuseCollectionElementsNotRead.root";
+   WriteTree(fileName);
+
+   TFile file(fileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(nullptr, tree);
+   tree->SetReuseCollectionElements();
+   tree->SetBranchStatus("*fHits.fY", 0);
+   HitEvent *event = new HitEvent;
+   tree->SetBranchAddress("event", &event);
+   for (Int_t entry = 0; entry < kEntries; ++entry) {
+      tree->GetEntry(entry);
+      ASSERT_EQ(GetNHits(entry), (Int_t)event->fHits.size());
+      for (auto hit : event->fHits) {
+         EXPECT_FLOAT_EQ(0., hit->fY);
+         EXPECT_FLOAT_EQ(0., hit->fTransient);
+         hit->fY = 42.;
+         hit->fTransient = 42.;
+      }
+   }
+   Long64_t created, reused;
+   tree->GetCollectionElementsCounts(created, reused);
+   EXPECT_GT(reused, 0);
+
+   tree->ResetBranchAddresses();
+   delete event;
+   gSystem->Unlink(fileName);
+}
+
+// Enabling the reuse on a chain applies to the tree already loaded
+TEST(TTreeReuseCollectionElements, ChainCurrentTree)
+{
+   const char *fileName = "ReuseCollectionElementsChain.root";
+   WriteTree(fileName);
+   TChain chain("tree");
+   chain.Add(fileName);
+   HitEvent *event = new HitEvent;
+   chain.SetBranchAddress("event", &event);
+   chain.GetEntry(0);
+   ASSERT_NE(nullptr, chain.GetTree());
+   EXPECT_FALSE(chain.GetTree()->GetReuseCollectionElements());
+
+   chain.SetReuseCollectionElements();
+   EXPECT_TRUE(chain.GetTree()->GetReuseCollectionElements());
+   for (Int_t entry = 1; entry < kEntries; ++entry) {
+      chain.GetEntry(entry);
+      ExpectEntry(*event, entry);
+   }
+   Long64_t created, reused, expectedCreated, expectedReused;
+   chain.GetCollectionElementsCounts(created, reused);
+   ExpectedCounts(1, kEntries, GetNHits(0), expectedCreated, expectedReused);
+   EXPECT_EQ(GetNHits(0) + expectedCreated, created);
+   EXPECT_EQ(expectedReused, reused);
+
+   chain.ResetBranchAddresses();
+   delete event;
+   gSystem->Unlink(fileName);
+}
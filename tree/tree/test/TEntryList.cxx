@@ -0,0 +1,133 @@
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+// Fill the list and the reference set with entries in [0, n) selected with the given probability
+static void FillRandom(TEntryList &elist, std::set<Long64_t> &ref, Long64_t n, double prob, UInt_t seed)
+{
+   TRandom3 rnd(seed);
+   for (Long64_t i = 0; i < n; ++i) {
+      if (rnd.Rndm() < prob) {
+         elist.Enter(i);
+         ref.insert(i);
+      }
+   }
+   elist.OptimizeStorage();
+}
+
+static void ExpectSameEntries(TEntryList &elist, const std::set<Long64_t> &ref)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)ref.size());
+   Long64_t i = 0;
+   for (auto entry : ref)
+      EXPECT_EQ(elist.GetEntry(i++), entry);
+}
+
+TEST(TEntryList, SetOperations)
+{
+   // Mix of sparse (list) and dense (bits and inverted list) blocks
+   const Long64_t n = 5 * TEntryList::kBlockSize + 123;
+   for (auto probs : {std::make_pair(0.01, 0.5), std::make_pair(0.5, 0.99), std::make_pair(0.999, 0.02)}) {
+      TEntryList a, b;
+      std::set<Long64_t> ra, rb;
+      FillRandom(a, ra, n, probs.first, 1);
+      FillRandom(b, rb, n - TEntryList::kBlockSize, probs.second, 2);
+
+      std::set<Long64_t> sum(ra), diff, inter;
+      sum.insert(rb.begin(), rb.end());
+      for (auto entry : ra) {
+         if (rb.count(entry))
+            inter.insert(entry);
+         else
+            diff.insert(entry);
+      }
+
+      TEntryList eadd(a), esub(a), eint(a);
+      eadd.Add(&b);
+      esub.Subtract(&b);
+      eint.Intersect(&b);
+      ExpectSameEntries(eadd, sum);
+      ExpectSameEntries(esub, diff);
+      ExpectSameEntries(eint, inter);
+   }
+}
+
+TEST(TEntryList, GetEntryRuns)
+{
+   TEntryList elist;
+   std::set<Long64_t> ref;
+   FillRandom(elist, ref, 3 * TEntryList::kBlockSize, 0.7, 3);
+   // A run across the boundary of two blocks
+   for (Long64_t i = TEntryList::kBlockSize - 10; i < TEntryList::kBlockSize + 10; ++i) {
+      elist.Enter(i);
+      ref.insert(i);
+   }
+
+   const Long64_t first = 1000, last = 2 * TEntryList::kBlockSize + 17;
+   std::vector<std::pair<Long64_t, Long64_t>> runs;
+   const auto npassed = elist.GetEntryRuns(first, last, runs);
+
+   std::set<Long64_t> fromRuns;
+   Long64_t previousEnd = -1;
+   for (auto &run : runs) {
+      EXPECT_LT(previousEnd, run.first); // sorted and not adjacent
+      EXPECT_LT(run.first, run.second);
+      for (auto i = run.first; i < run.second; ++i)
+         fromRuns.insert(i);
+      previousEnd = run.second;
+   }
+   std::set<Long64_t> expected(ref.lower_bound(first), ref.lower_bound(last));
+   EXPECT_EQ(npassed, (Long64_t)expected.size());
+   EXPECT_EQ(fromRuns, expected);
+}
+
+TEST(TEntryList, CachePrefetchesSelectedBaskets)
+{
+   const char *filename = "TEntryListCache.root";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t("t", "t");
+      double x;
+      t.Branch("x", &x);
+      t.SetAutoFlush(1000);
+      TRandom3 rnd(4);
+      for (int i = 0; i < 1000000; ++i) {
+         x = rnd.Rndm();
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   // Select a few entries in 3 clusters out of 1000
+   TEntryList elist;
+   for (Long64_t i : {2000, 2001, 500500, 900999})
+      elist.Enter(i);
+
+   TFile f(filename);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(20000000);
+   t->AddBranchToCache("x", true);
+   t->StopCacheLearningPhase();
+   double x = 0, sum = 0;
+   t->SetBranchAddress("x", &x);
+   t->SetEntryList(&elist);
+   for (Long64_t i = 0; i < elist.GetN(); ++i) {
+      t->GetEntry(t->GetEntryNumber(i));
+      sum += x;
+   }
+   EXPECT_GT(sum, 0.);
+   // Without the entry list the cache would read the whole file from the first cluster.
+   EXPECT_LT(f.GetBytesRead(), f.GetSize() / 10);
+   t->SetEntryList(nullptr);
+
+   gSystem->Unlink(filename);
+}
@@ -111,6 +111,7 @@ public:
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
    virtual void      SetEstimate(Long64_t n);
+   void              SetValues(TTree *tree, Int_t dimension, Long64_t selectedRows, Int_t n, Double_t *const *values, const Double_t *w);
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
    virtual void      TakeEstimate();
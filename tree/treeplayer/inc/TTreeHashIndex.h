@@ -0,0 +1,51 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeHashIndex
+#define ROOT_TTreeHashIndex
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeHashIndex                                                       //
+//                                                                      //
+// A Tree Index with majorname and minorname based on a hash table.     //
+// The index values do not need to be sorted, neither within a tree     //
+// nor across the trees of a chain.                                     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "TTreeIndex.h"
+
+#include <vector>
+
+class TTreeHashIndex : public TTreeIndex {
+
+protected:
+   std::vector<Long64_t> fSlots;        //! Open addressing hash table, position+1 in the value arrays (0: empty)
+
+   virtual void   BuildSearchTree();
+
+private:
+   TTreeHashIndex(const TTreeHashIndex&);            // Not implemented.
+   TTreeHashIndex &operator=(const TTreeHashIndex&); // Not implemented.
+
+public:
+   TTreeHashIndex();
+   TTreeHashIndex(const TTree *T, const char *majorname, const char *minorname = "0");
+   virtual void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE);
+   virtual Long64_t       FindValues(Long64_t major, Long64_t minor) const;
+   virtual Long64_t       GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const;
+
+   ClassDef(TTreeHashIndex,1);  //A Tree Index with majorname and minorname based on a hash table.
+};
+
+#endif
@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+#include <vector>
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -38,6 +40,9 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   std::vector<Long64_t> fSearchTree;   //! Sampled (major, minor, position) triplets in Eytzinger order, used by FindValues
+
+   virtual void   BuildSearchTree();
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
@@ -49,7 +54,7 @@ public:
    virtual               ~TTreeIndex();
    virtual void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE);
    bool                   ConvertOldToNew();
-   Long64_t               FindValues(Long64_t major, Long64_t minor) const;
+   virtual Long64_t       FindValues(Long64_t major, Long64_t minor) const;
    virtual Long64_t       GetEntryNumberFriend(const TTree *parent);
    virtual Long64_t       GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const;
    virtual Long64_t       GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const;
@@ -59,6 +59,8 @@ protected:
    Double_t      fDiskTime;      //Time spent in pure raw disk IO
    Double_t      fUnzipTime;     //Time spent uncompressing the data.
    Double_t      fCompress;      //Tree compression factor
+   Long64_t      fElementsNew;   //Number of elements of split collections of pointers created while reading
+   Long64_t      fElementsReused;//Number of elements of split collections of pointers reused while reading
    TString       fName;          //name of this TTreePerfStats
    TString       fHostInfo;      //name of the host system, ROOT version and date
    TFile        *fFile;          //!pointer to the file containing the Tree
@@ -89,6 +91,8 @@ public:
    virtual Long64_t GetBytesReadExtra() const {return fBytesReadExtra;}
    virtual Double_t GetCpuTime()   const {return fCpuTime;}
    virtual Double_t GetDiskTime()  const {return fDiskTime;}
+   virtual Long64_t GetElementsNew() const {return fElementsNew;}
+   virtual Long64_t GetElementsReused() const {return fElementsReused;}
    TGraphErrors    *GetGraphIO()     {return fGraphIO;}
    TGraphErrors    *GetGraphTime()   {return fGraphTime;}
    const char      *GetHostInfo() const{return fHostInfo.Data();}
@@ -147,7 +151,7 @@ public:
 
    BasketList_t     GetDuplicateBasketCache() const;
 
-   ClassDef(TTreePerfStats, 7) // TTree I/O performance measurement
+   ClassDef(TTreePerfStats, 8) // TTree I/O performance measurement
 };
 
 #endif
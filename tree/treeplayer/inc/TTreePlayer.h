@@ -59,11 +59,13 @@ protected:
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Long64_t       DrawSelectMT(const char *varexp, const char *selection, Option_t *option,
+                               Long64_t nentries, Long64_t firstentry);
 
 public:
    TTreePlayer();
    virtual ~TTreePlayer();
-   virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname);
+   virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname, Option_t *option = "");
    virtual TTree    *CopyTree(const char *selection, Option_t *option
                               ,Long64_t nentries, Long64_t firstentry);
    virtual Long64_t  DrawScript(const char* wrapperPrefix,
@@ -24,6 +24,7 @@ and kept inside this chain index.
 #include "TChain.h"
 #include "TTreeFormula.h"
 #include "TTreeIndex.h"
+#include "TTreeHashIndex.h"
 #include "TFile.h"
 #include "TError.h"
 
@@ -109,8 +110,11 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
          return;
       }
 
+      // the values of a TTreeHashIndex are not sorted, they do not give the range of the tree
       TTreeIndex *ti_index = dynamic_cast<TTreeIndex*>(index);
-      if (ti_index == 0) {
+      if (ti_index == 0 || ti_index->InheritsFrom(TTreeHashIndex::Class())) {
+         DeleteIndices();
+         MakeZombie();
          Error("TChainIndex", "The underlying TTree must have a TTreeIndex but has a %s.",
                index->IsA()->GetName());
          return;
@@ -138,9 +142,10 @@ void TChainIndex::Append(const TVirtualIndex *index, Bool_t delaySort )
 {
    if (index) {
       const TTreeIndex *ti_index = dynamic_cast<const TTreeIndex*>(index);
-      if (ti_index == 0) {
+      if (ti_index == 0 || ti_index->InheritsFrom(TTreeHashIndex::Class())) {
          Error("Append", "The given index is not a TTreeIndex but a %s",
                index->IsA()->GetName());
+         return;
       }
 
       TChainIndexEntry entry;
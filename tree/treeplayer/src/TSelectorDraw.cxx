@@ -36,6 +36,8 @@ A specialized TSelector for TTree::Draw.
 #include "TClass.h"
 #include "TColor.h"
 
+#include <algorithm>
+
 ClassImp(TSelectorDraw);
 
 const Int_t kCustomHistogram = BIT(17);
@@ -1351,6 +1353,34 @@ void TSelectorDraw::SetEstimate(Long64_t)
    delete [] fW;   fW  = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the values returned by GetVal and GetW to the n rows of values (one
+/// array per dimension) and w, as if they were the last rows filled by this
+/// selector for tree, and the number of selected rows to selectedRows.
+/// n must not be greater than the estimate of tree.
+/// The formulas of the previous query are deleted.
+/// Used by TTreePlayer::DrawSelectMT, which fills the output without a selector.
+
+void TSelectorDraw::SetValues(TTree *tree, Int_t dimension, Long64_t selectedRows, Int_t n, Double_t *const *values, const Double_t *w)
+{
+   ClearFormula();
+   InitArrays(dimension);
+   fTree = tree;
+   fDimension = dimension;
+   fSelectedRows = selectedRows;
+   fNfill = n;
+   if (dimension <= 0)
+      return;
+
+   const Int_t estimate = (Int_t)fTree->GetEstimate();
+   for (Int_t i = 0; i < dimension; ++i) {
+      if (!fVal[i]) fVal[i] = new Double_t[estimate];
+      std::copy(values[i], values[i] + n, fVal[i]);
+   }
+   if (!fW) fW = new Double_t[estimate];
+   std::copy(w, w + n, fW);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action for object obj fNfill times.
 
@@ -0,0 +1,311 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeHashIndex
+A Tree Index with majorname and minorname based on a hash table.
+
+Contrary to TTreeIndex and TChainIndex, the (major, minor) pairs are not
+sorted: they are kept in entry order and looked up through an open
+addressing hash table built when the index is created or read back.
+This makes the index usable on chains whose files cover overlapping or
+unordered ranges of index values (for instance reprocessed event streams),
+which TChainIndex refuses.
+
+~~~{.cpp}
+   TChain friendChain("reco");
+   friendChain.Add("reco_*.root");
+   friendChain.BuildIndex("run", "event", "hash");
+   mainChain.AddFriend(&friendChain);
+~~~
+
+When implicit multi-threading is enabled, the index of a TChain is built
+by reading its files in parallel. The entry numbers are global chain entry
+numbers, each file providing the number of entries the chain has for it.
+The index can be stored in a file, either together with its TTree
+(TTree::Write) or on its own with TObject::Write, and attached again with
+TTree::SetTreeIndex, so that it does not need to be rebuilt. Only the index
+values are stored (as for a TTreeIndex), the hash table is rebuilt when they
+are read.
+
+GetEntryNumberWithBestIndex can only return exact matches, the index values
+being unordered.
+*/
+
+#include "TTreeHashIndex.h"
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#include "ROOT/TSeq.hxx"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <memory>
+
+ClassImp(TTreeHashIndex);
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mix the bits of the (major, minor) pair.
+
+inline ULong64_t HashValues(Long64_t major, Long64_t minor)
+{
+   ULong64_t h = (ULong64_t)major * 0x9E3779B97F4A7C15ULL ^ (ULong64_t)minor;
+   h ^= h >> 30;
+   h *= 0xBF58476D1CE4E5B9ULL;
+   h ^= h >> 27;
+   h *= 0x94D049BB133111EBULL;
+   h ^= h >> 31;
+   return h;
+}
+
+struct IndexValues {
+   std::vector<Long64_t> fMajor;
+   std::vector<Long64_t> fMinor;
+   std::vector<Long64_t> fEntry;
+   Bool_t fOk = kFALSE;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the index expressions for the first 'nentries' entries of 'tree'
+/// (all of them if negative), appending the values to 'values'; 'offset' is
+/// added to the entry numbers.
+/// Returns false if the expressions cannot be evaluated on this tree.
+
+Bool_t ReadIndexValues(TTree *tree, const TString &majorname, const TString &minorname, Long64_t offset,
+                       Long64_t nentries, IndexValues &values)
+{
+   TTreeFormula major("Major", majorname.Data(), tree);
+   TTreeFormula minor("Minor", minorname.Data(), tree);
+   if (major.GetNdim() != 1 || minor.GetNdim() != 1)
+      return kFALSE;
+   major.SetQuickLoad(kTRUE);
+   minor.SetQuickLoad(kTRUE);
+
+   const Long64_t n = nentries < 0 ? tree->GetEntries() : nentries;
+   values.fMajor.reserve(values.fMajor.size() + n);
+   values.fMinor.reserve(values.fMinor.size() + n);
+   values.fEntry.reserve(values.fEntry.size() + n);
+   Long64_t oldEntry = tree->GetReadEntry();
+   Int_t current = -1;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (tree->LoadTree(i) < 0)
+         break;
+      if (tree->GetTreeNumber() != current) {
+         current = tree->GetTreeNumber();
+         major.UpdateFormulaLeaves();
+         minor.UpdateFormulaLeaves();
+      }
+      values.fMajor.push_back((Long64_t)major.EvalInstance<LongDouble_t>());
+      values.fMinor.push_back((Long64_t)minor.EvalInstance<LongDouble_t>());
+      values.fEntry.push_back(offset + i);
+   }
+   tree->LoadTree(oldEntry);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the index values of the files of a chain in parallel.
+/// The entries of each file are numbered and limited as in the chain, from
+/// its tree offsets.
+/// Returns false if the chain can not be processed this way.
+
+Bool_t ReadChainValuesParallel(const TTree *tree, const TString &majorname, const TString &minorname,
+                               IndexValues &values)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !tree->InheritsFrom(TChain::Class()))
+      return kFALSE;
+   const TChain *chain = static_cast<const TChain *>(tree);
+   TObjArray *elements = chain->GetListOfFiles();
+   const Int_t nfiles = elements ? elements->GetEntriesFast() : 0;
+   if (nfiles < 2 || nfiles != chain->GetNtrees())
+      return kFALSE;
+   // makes sure the number of entries of all files is known
+   if (chain->GetEntries() == TTree::kMaxEntries)
+      return kFALSE;
+
+   struct FileInfo {
+      std::string fTreeName;
+      std::string fFileName;
+      Long64_t fOffset;
+      Long64_t fEntries;
+   };
+   std::vector<FileInfo> files;
+   const Long64_t *offsets = chain->GetTreeOffset();
+   for (Int_t i = 0; i < nfiles; ++i) {
+      auto element = static_cast<TChainElement *>(elements->UncheckedAt(i));
+      files.push_back({element->GetName(), element->GetTitle(), offsets[i], offsets[i + 1] - offsets[i]});
+   }
+
+   auto readFile = [&](unsigned i) {
+      IndexValues fileValues;
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(files[i].fFileName.c_str()));
+      if (!file || file->IsZombie())
+         return fileValues;
+      TTree *t = nullptr; // owned by the file
+      file->GetObject(files[i].fTreeName.c_str(), t);
+      // a file with less entries than the chain expects is left to the serial reading
+      if (!t || t->GetEntries() < files[i].fEntries)
+         return fileValues;
+      fileValues.fOk =
+         ReadIndexValues(t, majorname, minorname, files[i].fOffset, files[i].fEntries, fileValues);
+      return fileValues;
+   };
+
+   ROOT::TThreadExecutor pool;
+   auto perFile = pool.Map(readFile, ROOT::TSeqU(nfiles));
+
+   for (auto &fileValues : perFile) {
+      if (!fileValues.fOk)
+         return kFALSE;
+      values.fMajor.insert(values.fMajor.end(), fileValues.fMajor.begin(), fileValues.fMajor.end());
+      values.fMinor.insert(values.fMinor.end(), fileValues.fMinor.begin(), fileValues.fMinor.end());
+      values.fEntry.insert(values.fEntry.end(), fileValues.fEntry.begin(), fileValues.fEntry.end());
+   }
+   values.fOk = kTRUE;
+   return kTRUE;
+#else
+   (void)tree; (void)majorname; (void)minorname; (void)values;
+   return kFALSE;
+#endif
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor for TTreeHashIndex
+
+TTreeHashIndex::TTreeHashIndex(): TTreeIndex()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Normal constructor for TTreeHashIndex
+///
+/// Build a hash index on the values of the expressions "majorname" and
+/// "minorname" (converted to integers) for all the entries of the tree or
+/// chain T. See TTreeIndex::TTreeIndex for the meaning of the parameters.
+/// If several entries have the same (major, minor) pair, the one with the
+/// lowest entry number is returned by the lookups.
+
+TTreeHashIndex::TTreeHashIndex(const TTree *T, const char *majorname, const char *minorname)
+           : TTreeIndex()
+{
+   fTree               = (TTree*)T;
+   fMajorName          = majorname;
+   fMinorName          = minorname;
+   if (!T) return;
+   if (T->GetEntries() <= 0) {
+      MakeZombie();
+      Error("TTreeHashIndex","Cannot build a TTreeHashIndex with a Tree having no entries");
+      return;
+   }
+
+   IndexValues values;
+   if (ReadChainValuesParallel(T, fMajorName, fMinorName, values)) {
+      if (gDebug > 0)
+         Info("TTreeHashIndex", "Index values of %lld entries read in parallel", (Long64_t)values.fEntry.size());
+   } else {
+      values = IndexValues();
+      values.fOk = ReadIndexValues(fTree, fMajorName, fMinorName, 0, -1, values);
+   }
+   if (!values.fOk) {
+      MakeZombie();
+      Error("TTreeHashIndex","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
+      return;
+   }
+
+   fN = values.fEntry.size();
+   fIndexValues = new Long64_t[fN];
+   fIndexValuesMinor = new Long64_t[fN];
+   fIndex = new Long64_t[fN];
+   std::copy(values.fMajor.begin(), values.fMajor.end(), fIndexValues);
+   std::copy(values.fMinor.begin(), values.fMinor.end(), fIndexValuesMinor);
+   std::copy(values.fEntry.begin(), values.fEntry.end(), fIndex);
+   BuildSearchTree();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append 'add' to this index.  Entry 0 in add will become entry n+1 in this.
+/// The values are not sorted. If delaySort is true, the hash table is not
+/// rebuilt, then you must call Append(0,kFALSE) before using the index.
+
+void TTreeHashIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
+{
+   TTreeIndex::Append(add, kTRUE);
+   if (delaySort) fSlots.clear();
+   else           BuildSearchTree();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the open addressing (linear probing) hash table on the index values.
+/// The table has at least twice as many slots as values.
+
+void TTreeHashIndex::BuildSearchTree()
+{
+   fSlots.clear();
+   if (fN <= 0 || !fIndexValues || !fIndexValuesMinor) return;
+   ULong64_t size = 16;
+   while (size < 2 * (ULong64_t)fN) size <<= 1;
+   fSlots.assign(size, 0);
+   const ULong64_t mask = size - 1;
+   for (Long64_t pos = 0; pos < fN; ++pos) {
+      ULong64_t slot = HashValues(fIndexValues[pos], fIndexValuesMinor[pos]) & mask;
+      while (true) {
+         const Long64_t other = fSlots[slot] - 1;
+         if (other < 0) {
+            fSlots[slot] = pos + 1;
+            break;
+         }
+         if (fIndexValues[other] == fIndexValues[pos] && fIndexValuesMinor[other] == fIndexValuesMinor[pos]) {
+            if (fIndex[pos] < fIndex[other]) fSlots[slot] = pos + 1;
+            break;
+         }
+         slot = (slot + 1) & mask;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the position of the major|minor values in the IndexValues tables,
+/// or fN if they are not in the index.
+/// This is the index in IndexValues table, not entry# !
+
+Long64_t TTreeHashIndex::FindValues(Long64_t major, Long64_t minor) const
+{
+   if (fSlots.empty()) return fN;
+   const ULong64_t mask = fSlots.size() - 1;
+   ULong64_t slot = HashValues(major, minor) & mask;
+   while (true) {
+      const Long64_t pos = fSlots[slot] - 1;
+      if (pos < 0) return fN;
+      if (fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor) return pos;
+      slot = (slot + 1) & mask;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return entry number corresponding to major and minor number.
+/// The index values not being sorted, only an exact match can be found:
+/// this is the same as GetEntryNumberWithIndex.
+
+Long64_t TTreeHashIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const
+{
+   return GetEntryNumberWithIndex(major, minor);
+}
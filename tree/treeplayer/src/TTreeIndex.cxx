@@ -16,29 +16,158 @@ A Tree Index with majorname and minorname.
 #include "TTreeIndex.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TLeafB.h"
+#include "TLeafI.h"
+#include "TLeafL.h"
+#include "TLeafS.h"
+#include "ROOT/TSeq.hxx"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
 
 ClassImp(TTreeIndex);
 
+namespace {
 
-struct IndexSortComparator {
+/// Number of sorted index values covered by one node of the search tree.
+const Long64_t kSearchBlock = 16;
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+/// Minimum number of values for which the sort is done in parallel.
+const Long64_t kMinParallelSort = 1000000;
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
-   }
+/// One (major, minor) pair with its entry number, sorted together so that the
+/// comparisons do not have to follow an index into two separate arrays.
+struct IndexRecord {
+   Long64_t fMajor;
+   Long64_t fMinor;
+   Long64_t fEntry;
 
-  // pointers to the start of index values tables keeping uppder 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
+   bool operator<(const IndexRecord &other) const
+   {
+      if (fMajor != other.fMajor)
+         return fMajor < other.fMajor;
+      if (fMinor != other.fMinor)
+         return fMinor < other.fMinor;
+      return fEntry < other.fEntry;
+   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the records, in parallel if implicit multi-threading is enabled:
+/// each worker sorts one chunk, the chunks are then merged pairwise.
+
+void SortRecords(std::vector<IndexRecord> &records)
+{
+#ifdef R__USE_IMT
+   const Long64_t n = records.size();
+   if (ROOT::IsImplicitMTEnabled() && n >= kMinParallelSort) {
+      const unsigned nChunks = std::max(2u, ROOT::GetImplicitMTPoolSize());
+      std::vector<Long64_t> bounds(nChunks + 1);
+      for (unsigned i = 0; i <= nChunks; ++i)
+         bounds[i] = n * i / nChunks;
+      auto first = records.begin();
+
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned i) { std::sort(first + bounds[i], first + bounds[i + 1]); },
+                   ROOT::TSeqU(nChunks));
+      for (unsigned width = 1; width < nChunks; width *= 2) {
+         std::vector<unsigned> merges;
+         for (unsigned i = 0; i + width < nChunks; i += 2 * width)
+            merges.push_back(i);
+         pool.Foreach(
+            [&](unsigned i) {
+               std::inplace_merge(first + bounds[i], first + bounds[i + width],
+                                  first + bounds[std::min(i + 2 * width, nChunks)]);
+            },
+            merges);
+      }
+      return;
+   }
+#endif
+   std::sort(records.begin(), records.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the index expression 'name' with the bulk I/O interface
+/// of TBranch, one basket at a time, when 'name' is a simple integer leaf.
+/// Returns false if this is not possible, in which case the values must be
+/// computed with a TTreeFormula.
+
+Bool_t ReadValuesBulk(TTree *tree, const TString &name, std::vector<IndexRecord> &records,
+                      Long64_t IndexRecord::*member)
+{
+   if (tree->IsA() != TTree::Class())
+      return kFALSE;
+   TFile *file = tree->GetCurrentFile();
+   // Baskets still in memory can not be read in bulk.
+   if (!file || file->IsWritable())
+      return kFALSE;
+   TLeaf *leaf = tree->GetLeaf(name);
+   if (!leaf || leaf->GetLen() != 1 || leaf->GetLeafCount())
+      return kFALSE;
+   TBranch *branch = leaf->GetBranch();
+   if (!branch || branch->GetTree() != tree || !branch->SupportsBulkRead())
+      return kFALSE;
+   const Long64_t n = records.size();
+   if (branch->GetEntries() != n)
+      return kFALSE;
+
+   Int_t size = 0;
+   if (leaf->IsA() == TLeafB::Class())      size = 1;
+   else if (leaf->IsA() == TLeafS::Class()) size = 2;
+   else if (leaf->IsA() == TLeafI::Class()) size = 4;
+   else if (leaf->IsA() == TLeafL::Class()) size = 8;
+   else return kFALSE;
+   const Bool_t isUnsigned = leaf->IsUnsigned();
+
+   TBufferFile buf(TBuffer::kWrite, 10000);
+   Long64_t entry = 0;
+   while (entry < n) {
+      Int_t count = branch->GetBulkRead().GetBulkEntries(entry, buf);
+      if (count <= 0)
+         return kFALSE;
+      count = (Int_t)std::min<Long64_t>(count, n - entry);
+      const char *data = buf.GetCurrent();
+      for (Int_t i = 0; i < count; ++i) {
+         Long64_t value;
+         switch (size) {
+            case 1: value = isUnsigned ? (Long64_t)((const UChar_t *)data)[i] : (Long64_t)((const Char_t *)data)[i]; break;
+            case 2: value = isUnsigned ? (Long64_t)((const UShort_t *)data)[i] : (Long64_t)((const Short_t *)data)[i]; break;
+            case 4: value = isUnsigned ? (Long64_t)((const UInt_t *)data)[i] : (Long64_t)((const Int_t *)data)[i]; break;
+            default: value = ((const Long64_t *)data)[i]; break;
+         }
+         records[entry + i].*member = value;
+      }
+      entry += count;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Place the sorted samples into 'tree' in Eytzinger (breadth-first) order,
+/// 'node' being the 1-based slot to fill.
+
+void FillSearchTree(Long64_t *tree, Long64_t node, Long64_t nsamples, Long64_t &sample, const Long64_t *major,
+                    const Long64_t *minor)
+{
+   if (node > nsamples)
+      return;
+   FillSearchTree(tree, 2 * node, nsamples, sample, major, minor);
+   tree[3 * node] = major[sample * kSearchBlock];
+   tree[3 * node + 1] = minor[sample * kSearchBlock];
+   tree[3 * node + 2] = sample;
+   ++sample;
+   FillSearchTree(tree, 2 * node + 1, nsamples, sample, major, minor);
+}
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -161,35 +290,36 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    //   return;
    //}
 
-   Long64_t *tmp_major = new Long64_t[fN];
-   Long64_t *tmp_minor = new Long64_t[fN];
+   std::vector<IndexRecord> records(fN);
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!ReadValuesBulk(fTree, fMajorName, records, &IndexRecord::fMajor) ||
+       !ReadValuesBulk(fTree, fMinorName, records, &IndexRecord::fMinor)) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         records[i].fMajor = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         records[i].fMinor = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
+   for (i = 0; i < fN; i++) { records[i].fEntry = i; }
+   SortRecords(records);
    fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
    for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+      fIndexValues[i] = records[i].fMajor;
+      fIndexValuesMinor[i] = records[i].fMinor;
+      fIndex[i] = records[i].fEntry;
    }
+   BuildSearchTree();
 
-   delete [] tmp_major;
-   delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
@@ -216,6 +346,7 @@ TTreeIndex::~TTreeIndex()
 void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 {
 
+   fSearchTree.clear();
    if (add && add->GetN()) {
       // Create new buffer (if needed)
 
@@ -262,33 +393,37 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
    // Sort.
    if (!delaySort) {
-      Long64_t *addValues = GetIndexValues();
-      Long64_t *addValues2 = GetIndexValuesMinor();
-      Long64_t *ind = fIndex;
-      Long64_t *conv = new Long64_t[fN];
-
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
-      fIndex = new Long64_t[fN];
-      fIndexValues = new Long64_t[fN];
-      fIndexValuesMinor = new Long64_t[fN];
-
-      for (Int_t i=0;i<fN;i++) {
-         fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
+      std::vector<IndexRecord> records(fN);
+      for (Long64_t i = 0; i < fN; i++) {
+         records[i].fMajor = fIndexValues[i];
+         records[i].fMinor = fIndexValuesMinor[i];
+         records[i].fEntry = fIndex[i];
+      }
+      SortRecords(records);
+      for (Long64_t i = 0; i < fN; i++) {
+         fIndex[i] = records[i].fEntry;
+         fIndexValues[i] = records[i].fMajor;
+         fIndexValuesMinor[i] = records[i].fMinor;
       }
-      delete [] addValues;
-      delete [] addValues2;
-      delete [] ind;
-      delete [] conv;
+      BuildSearchTree();
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Build the search structure used by FindValues: one sorted (major, minor)
+/// value out of kSearchBlock is stored in Eytzinger order, so that the first
+/// levels of the search stay in cache and the final step is a short scan of
+/// the contiguous index values.
 
+void TTreeIndex::BuildSearchTree()
+{
+   fSearchTree.clear();
+   if (fN < 2 * kSearchBlock || !fIndexValues || !fIndexValuesMinor) return;
+   const Long64_t nsamples = (fN + kSearchBlock - 1) / kSearchBlock;
+   fSearchTree.resize(3 * (nsamples + 1));
+   Long64_t sample = 0;
+   FillSearchTree(fSearchTree.data(), 1, nsamples, sample, fIndexValues, fIndexValuesMinor);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// conversion from old 64bit indexes
@@ -353,6 +488,29 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
+   if (!fSearchTree.empty()) {
+      // Descend the Eytzinger tree looking for the first sample not less
+      // than major|minor, then scan the block preceding it.
+      const Long64_t nsamples = fSearchTree.size() / 3 - 1;
+      const Long64_t *tree = fSearchTree.data();
+      Long64_t node = 1;
+      while (node <= nsamples) {
+         const Long64_t *val = tree + 3 * node;
+         node = 2 * node + (val[0] < major || (val[0] == major && val[1] < minor));
+      }
+      // Drop the trailing right turns and the last left turn.
+      while (node & 1) node >>= 1;
+      node >>= 1;
+      const Long64_t rank = node ? tree[3 * node + 2] : nsamples;
+      if (rank == 0) return 0;
+      Long64_t pos = (rank - 1) * kSearchBlock;
+      const Long64_t end = std::min(rank * kSearchBlock, fN);
+      while (pos < end && (fIndexValues[pos] < major ||
+                           (fIndexValues[pos] == major && fIndexValuesMinor[pos] < minor)))
+         ++pos;
+      return pos;
+   }
+
    Long64_t mid, step, pos = 0, count = fN;
    // find lower bound using bisection
    while( count > 0 ) {
@@ -561,6 +719,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
+      BuildSearchTree();
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
       TVirtualIndex::Streamer(R__b);
@@ -66,6 +66,9 @@ The Draw or Print functions print the following information:
  -  ReadUZCP  = Unipped MBytes per CP second
  -  ReadRT    = Zipped MBytes per RT second
  -  ReadCP    = Zipped MBytes per CP second
+ -  CollElems = Elements of split collections of pointers created and
+               reused while reading (see TTree::SetReuseCollectionElements),
+               only printed when not zero
 
  ### NOTE 1 :
 The ReadTotal value indicates the effective number of zipped bytes
@@ -124,6 +127,8 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fDiskTime      = 0;
    fUnzipTime     = 0;
    fCompress      = 0;
+   fElementsNew   = 0;
+   fElementsReused= 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
 }
@@ -161,6 +166,8 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fUnzipTime     = 0;
    fRealTimeAxis  = 0;
    fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
+   fElementsNew   = 0;
+   fElementsReused= 0;
 
    Bool_t isUNIX = strcmp(gSystem->GetName(), "Unix") == 0;
    if (isUNIX)
@@ -327,6 +334,7 @@ void TTreePerfStats::Finish()
    fBytesReadExtra= fFile->GetBytesReadExtra();
    fRealTime      = fWatch->RealTime();
    fCpuTime       = fWatch->CpuTime();
+   fTree->GetCollectionElementsCounts(fElementsNew, fElementsReused);
    Int_t npoints  = fGraphIO->GetN();
    if (!npoints) return;
    Double_t iomax = TMath::MaxElement(npoints,fGraphIO->GetY());
@@ -553,6 +561,8 @@ void TTreePerfStats::Print(Option_t * option) const
    printf("ReadUZCP  = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fCpuTime);
    printf("ReadRT    = %7.3f MBytes/s\n",1e-6*fBytesRead/fRealTime);
    printf("ReadCP    = %7.3f MBytes/s\n",1e-6*fBytesRead/fCpuTime);
+   if (fElementsNew || fElementsReused)
+      printf("CollElems = %lld created, %lld reused\n",fElementsNew,fElementsReused);
    if (unzip) {
       printf("ReadStrCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/(fCpuTime-fUnzipTime));
       printf("ReadZipCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fUnzipTime);
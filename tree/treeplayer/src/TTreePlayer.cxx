@@ -26,6 +26,7 @@ extra libraries (Histogram, display, etc).
 #include "TFile.h"
 #include "TEventList.h"
 #include "TEntryList.h"
+#include "TCut.h"
 #include "TBranchObject.h"
 #include "TBranchElement.h"
 #include "TStreamerInfo.h"
@@ -70,6 +71,7 @@ extra libraries (Histogram, display, etc).
 #include "TTreeProxyGenerator.h"
 #include "TTreeReaderGenerator.h"
 #include "TTreeIndex.h"
+#include "TTreeHashIndex.h"
 #include "TChainIndex.h"
 #include "TRefProxy.h"
 #include "TRefArrayProxy.h"
@@ -77,6 +79,19 @@ extra libraries (Histogram, display, etc).
 #include "TTreeCache.h"
 #include "TStyle.h"
 #include "TVirtualMutex.h"
+#include "TTreeDrawArgsParser.h"
+#include "TProfile3D.h"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
 
 #include "HFitInterface.h"
 #include "Foption.h"
@@ -138,8 +153,10 @@ TTreePlayer::~TTreePlayer()
 ////////////////////////////////////////////////////////////////////////////////
 /// Build the index for the tree (see TTree::BuildIndex)
 
-TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, const char *minorname)
+TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, const char *minorname, Option_t *option)
 {
+   if (TString(option).Contains("hash", TString::kIgnoreCase))
+      return new TTreeHashIndex(T, majorname, minorname);
    TVirtualIndex *index;
    if (dynamic_cast<const TChain*>(T)) {
       index = new TChainIndex(T, majorname, minorname);
@@ -334,6 +351,11 @@ Long64_t TTreePlayer::DrawScript(const char* wrapperPrefix,
 /// Returns -1 in case of error or number of selected events in case of success.
 ///
 /// See the documentation of TTree::Draw for the complete details.
+///
+/// When implicit multi-threading is enabled (see ROOT::EnableImplicitMT) and
+/// the expression is projected into an already existing histogram with fixed
+/// binning (typically through TTree::Project or `"x>>h"`), the entries are
+/// processed in parallel, see TTreePlayer::DrawSelectMT.
 
 Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Option_t *option,Long64_t nentries, Long64_t firstentry)
 {
@@ -415,6 +437,20 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    // Do not process more than fMaxEntryLoop entries
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
+   if (!optpara && !optcandle && !optgl5d) {
+      Long64_t nrowsMT = DrawSelectMT(varexp0, selection, option, nentries, firstentry);
+      if (nrowsMT >= 0) {
+         fSelectedRows = nrowsMT;
+         if (fDimension <= 0) return fSelectedRows;
+         if (optnorm) {
+            Double_t sumh = fHistogram->GetSumOfWeights();
+            if (sumh != 0) fHistogram->Scale(1./sumh);
+         }
+         if (!opt.Contains("goff")) fHistogram->Draw(opt.Data());
+         return fSelectedRows;
+      }
+   }
+
    // invoke the selector
    Long64_t nrows = Process(fSelector,option,nentries,firstentry);
    fSelectedRows = nrows;
@@ -535,6 +571,461 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    return fSelectedRows;
 }
 
+#ifdef R__USE_IMT
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The values and weights of the rows selected in one cluster by
+/// TTreePlayer::DrawSelectMT, in entry order.
+
+struct TDrawMTRows {
+   Long64_t fFirstEntry = -1;     ///< The first entry read in the cluster
+   std::vector<Double_t> fVal[3]; ///< The values of the expressions, one vector per dimension
+   std::vector<Double_t> fW;      ///< The weights
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The formulas evaluated by one thread of TTreePlayer::DrawSelectMT for the
+/// chain it reads. They are kept for all the clusters read from that chain.
+
+class TDrawMTFormulas {
+public:
+   TDrawMTFormulas(TTree *chain, const TString &select, const std::vector<TString> &exprs);
+   Bool_t   IsFor(TTree *chain) const;
+   Long64_t Fill(TTreeReader &reader, TH1 *h, TEntryList *el, Bool_t globalWeight, Double_t weight, TDrawMTRows *rows);
+   static TString GetFirstFile(TTree *chain);
+
+private:
+
+   TTree   *fChain;              ///< The chain the formulas are built for
+   TString  fFile;               ///< The first file of fChain, identifies it together with fChain
+   TTree   *fTree = nullptr;     ///< The tree of fChain the leaves of the formulas belong to
+   Int_t    fTreeNumber = -1;    ///< The number of fTree in fChain
+   TString  fSelection;          ///< The selection
+   std::vector<TString> fExprs;  ///< The expressions, one per dimension
+   TTreeFormulaManager *fManager = nullptr;          ///< Owned by the formulas, deleted with the last of them
+   std::unique_ptr<TTreeFormula> fSelect;            ///< Formula of the selection
+   std::vector<std::unique_ptr<TTreeFormula>> fVars; ///< Formulas of the expressions
+   Bool_t   fSelectMultiple = kFALSE;
+   Bool_t   fVarMultiple[3] = {kFALSE, kFALSE, kFALSE};
+   Bool_t   fForceRead = kFALSE;
+   Int_t    fMultiplicity = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The formulas are created once the first entry is loaded.
+
+TDrawMTFormulas::TDrawMTFormulas(TTree *chain, const TString &select, const std::vector<TString> &exprs)
+   : fChain(chain), fFile(GetFirstFile(chain)), fSelection(select), fExprs(exprs)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the first file of a chain.
+
+TString TDrawMTFormulas::GetFirstFile(TTree *chain)
+{
+   TChain *ch = dynamic_cast<TChain *>(chain);
+   TObject *first = ch && ch->GetListOfFiles() ? ch->GetListOfFiles()->First() : nullptr;
+   return first ? first->GetTitle() : "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the formulas can be used for chain, i.e. if it is the chain
+/// they were built for and not a new one created at the same address.
+
+Bool_t TDrawMTFormulas::IsFor(TTree *chain) const
+{
+   return chain == fChain && GetFirstFile(chain) == fFile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram h, or the entry list el, with the entries of reader.
+/// The entries are weighted with weight if globalWeight is true, else with the
+/// weight of their tree. The values and weights filled are also appended to
+/// rows, if not null.
+/// Same logic as TSelectorDraw::ProcessFill and TSelectorDraw::ProcessFillMultiple.
+/// Returns the number of values filled.
+
+Long64_t TDrawMTFormulas::Fill(TTreeReader &reader, TH1 *h, TEntryList *el, Bool_t globalWeight, Double_t weight,
+                               TDrawMTRows *rows)
+{
+   const Int_t dimension = fExprs.size();
+   Long64_t nfilled = 0;
+
+   while (reader.Next()) {
+      TTree *current = fChain->GetTree();
+      if (!fManager) {
+         fManager = new TTreeFormulaManager();
+         if (fSelection.Length()) {
+            fSelect.reset(new TTreeFormula("Selection", fSelection, fChain));
+            fManager->Add(fSelect.get());
+            fSelectMultiple = fSelect->GetMultiplicity();
+         }
+         for (Int_t i = 0; i < dimension; ++i) {
+            fVars.emplace_back(new TTreeFormula(TString::Format("Var%i", i + 1), fExprs[i], fChain));
+            fVars.back()->SetQuickLoad(kTRUE);
+            fManager->Add(fVars.back().get());
+            fVarMultiple[i] = fVars.back()->GetMultiplicity();
+         }
+         fManager->Sync();
+         fForceRead = fManager->GetMultiplicity() == -1;
+         if (fManager->GetMultiplicity() >= 1) fMultiplicity = fManager->GetMultiplicity();
+      } else if (current != fTree || fChain->GetTreeNumber() != fTreeNumber) {
+         fManager->UpdateFormulaLeaves();
+      }
+      if (current != fTree || fChain->GetTreeNumber() != fTreeNumber) {
+         fTree = current;
+         fTreeNumber = fChain->GetTreeNumber();
+      }
+      const Double_t w = globalWeight ? weight : fTree->GetWeight();
+      if (rows && rows->fFirstEntry < 0)
+         rows->fFirstEntry = fChain->GetReadEntry();
+
+      Int_t ndata = 1;
+      if (fMultiplicity) {
+         ndata = fManager->GetNdata();
+         if (!ndata) continue;
+      } else if (fForceRead && fManager->GetNdata() <= 0) {
+         continue;
+      }
+
+      Double_t w0 = fSelect ? w * fSelect->EvalInstance(0) : w;
+      if (!w0 && !(fMultiplicity && fSelectMultiple)) continue;
+
+      Double_t v0[3] = {0., 0., 0.};
+      Double_t v[3];
+      Bool_t haveV0 = kFALSE;
+      if (w0) {
+         for (Int_t k = 0; k < dimension; ++k) v0[k] = fVars[k]->EvalInstance(0);
+         haveV0 = kTRUE;
+      } else {
+         for (auto &var : fVars) var->ResetLoading();
+      }
+
+      for (Int_t i = 0; i < ndata; ++i) {
+         Double_t ww = w0;
+         if (i == 0) {
+            if (!haveV0) continue;
+            for (Int_t k = 0; k < dimension; ++k) v[k] = v0[k];
+         } else {
+            if (fSelectMultiple) {
+               ww = w * fSelect->EvalInstance(i);
+               if (ww == 0) continue;
+               if (!haveV0) {
+                  for (Int_t k = 0; k < dimension; ++k) {
+                     if (!fVarMultiple[k]) v0[k] = fVars[k]->EvalInstance(0);
+                  }
+                  haveV0 = kTRUE;
+               }
+            }
+            for (Int_t k = 0; k < dimension; ++k) v[k] = fVarMultiple[k] ? fVars[k]->EvalInstance(i) : v0[k];
+         }
+         if (el)                  el->Enter(fTree->GetReadEntry());
+         else if (dimension == 1) h->Fill(v[0], ww);
+         else if (dimension == 2) static_cast<TH2 *>(h)->Fill(v[1], v[0], ww);
+         else                     static_cast<TH3 *>(h)->Fill(v[2], v[1], v[0], ww);
+         if (rows) {
+            for (Int_t k = 0; k < dimension; ++k) rows->fVal[k].push_back(v[k]);
+            rows->fW.push_back(ww);
+         }
+         ++nfilled;
+      }
+   }
+   return nfilled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The output object and the formulas of one thread of TTreePlayer::DrawSelectMT.
+
+struct TDrawMTSlot {
+   std::unique_ptr<TObject> fPartial;          ///< The histogram or entry list filled by the thread
+   std::unique_ptr<TDrawMTFormulas> fFormulas; ///< The formulas for the last chain read by the thread
+   Bool_t fBusy = kFALSE;                      ///< True while fFormulas are used for a cluster
+};
+
+} // anonymous namespace
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an existing histogram with the expression varexp, or a TEntryList with
+/// the entries passing the selection, in parallel.
+/// Returns the number of values filled, or -1 if the request cannot be
+/// handled by the multi-threaded path, in which case the caller falls back to
+/// the sequential TSelectorDraw loop.
+///
+/// The parallel path is taken only if:
+///  - implicit multi-threading is enabled,
+///  - varexp has the form `"e1[:e2[:e3]]>>[+]hname"` and `hname` is an existing
+///    TH1, TH2 or TH3 (not a profile) of matching dimension, without buffer,
+///    labels or extendable axes,
+///  - or varexp has the form `">>[+]elistname"` with option `"entrylist"`, the
+///    tree is not a TChain and `elistname` is not a TEntryListArray nor the
+///    entry list set on the tree,
+///  - all entries are requested, the tree is read from a file that is not open
+///    for writing, it has no friends and no aliases, and no TEventList (or
+///    TEntryList with sub-lists or with the cut to be reapplied) is set.
+///
+/// The entry range is split in clusters by ROOT::TTreeProcessorMT, each
+/// thread evaluates its own TTreeFormula instances, kept from one cluster to
+/// the next, and fills its own copy of the histogram or entry list; the copies
+/// are added to the output object at the end. The entries are weighted as by
+/// TSelectorDraw: with the weight of the tree, or for a TChain with its weight
+/// if set with the option "global" (see TChain::SetWeight), else with the
+/// weight of each of its trees.
+/// The values of the rows filled are also kept per cluster, as long as they
+/// may be among the last `GetSelectedRows() % GetEstimate()` rows, so that
+/// TTree::GetV1, GetV2, GetV3, GetVal and GetW return the same values as
+/// after the sequential loop. The formulas (TTree::GetVar1 etc.) are not kept.
+
+Long64_t TTreePlayer::DrawSelectMT(const char *varexp, const char *selection, Option_t *option,
+                                   Long64_t nentries, Long64_t firstentry)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled())
+      return -1;
+   if (firstentry != 0 || nentries < fTree->GetEntries())
+      return -1;
+   if (fTree->GetEventList())
+      return -1;
+   // The trees read by the threads are opened again, without the friends and aliases.
+   if ((fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetSize()) ||
+       (fTree->GetListOfAliases() && fTree->GetListOfAliases()->GetSize()))
+      return -1;
+   TEntryList *elist = fTree->GetEntryList();
+   if (elist && (elist->GetLists() || elist->InheritsFrom("TEntryListArray") || elist->GetReapplyCut()))
+      return -1;
+   const Bool_t isChain = fTree->IsA() == TChain::Class();
+   TString firstFile, treePath;
+   if (isChain) {
+      TObject *element = static_cast<TChain *>(fTree)->GetListOfFiles()->First();
+      if (!element)
+         return -1;
+      firstFile = element->GetTitle();
+      treePath = element->GetName();
+   } else {
+      TFile *file = fTree->GetCurrentFile();
+      if (!file || file->IsWritable())
+         return -1;
+      firstFile = file->GetName();
+      treePath = fTree->GetName();
+      for (TDirectory *dir = fTree->GetDirectory(); dir && dir != file; dir = dir->GetMotherDir())
+         treePath.Prepend(TString(dir->GetName()) + "/");
+   }
+
+   TTreeDrawArgsParser parser;
+   if (!parser.Parse(varexp, selection, option))
+      return -1;
+   const Int_t dimension = parser.GetDimension();
+   if (dimension < 0 || dimension > 3 || parser.GetObjectName().IsNull() || parser.GetNoParameters() > 0)
+      return -1;
+
+   TH1 *hist = nullptr;
+   TEntryList *enlist = nullptr;
+   if (dimension == 0) {
+      // Only plain TTrees: the sub-lists of a TChain would not be ordered as the trees.
+      TString opt = option;
+      opt.ToLower();
+      if (!opt.Contains("entrylist") || opt.Contains("entrylistarray") || isChain)
+         return -1;
+      TObject *oldObject = gDirectory->Get(parser.GetObjectName());
+      if (oldObject) {
+         enlist = dynamic_cast<TEntryList *>(oldObject);
+         if (!enlist || enlist == elist || enlist->InheritsFrom("TEntryListArray") || enlist->GetLists())
+            return -1;
+      }
+   } else {
+      hist = dynamic_cast<TH1 *>(gDirectory->Get(parser.GetObjectName()));
+      if (!hist || hist->GetDimension() != dimension || hist->GetBuffer())
+         return -1;
+      if (hist->GetXaxis()->CanExtend() || hist->GetYaxis()->CanExtend() || hist->GetZaxis()->CanExtend())
+         return -1;
+      if (hist->InheritsFrom(TProfile::Class()) || hist->InheritsFrom(TProfile2D::Class()) ||
+          hist->InheritsFrom(TProfile3D::Class()) || hist->InheritsFrom("TH2Poly"))
+         return -1;
+      if (hist->GetXaxis()->GetLabels() || hist->GetYaxis()->GetLabels() || hist->GetZaxis()->GetLabels())
+         return -1;
+   }
+
+   std::vector<TString> exprs;
+   for (Int_t i = 0; i < dimension; ++i)
+      exprs.emplace_back(parser.GetVarExp(i));
+   const TString select = parser.GetSelection();
+
+   // Validate the expressions on a separate copy of the first tree, so that the
+   // tree of the user is not modified and the errors, if any, are reported
+   // once, by TSelectorDraw.
+   {
+      TDirectory::TContext ctxt(nullptr);
+      Int_t errorLevel = gErrorIgnoreLevel;
+      gErrorIgnoreLevel = kFatal;
+      TChain check(treePath);
+      check.Add(firstFile);
+      Bool_t valid = check.LoadTree(0) >= 0;
+      std::vector<std::unique_ptr<TTreeFormula>> formulas;
+      if (valid && select.Length()) {
+         formulas.emplace_back(new TTreeFormula("Selection", select, &check));
+         valid &= formulas.back()->GetNdim() > 0 && !formulas.back()->EvalClass();
+      }
+      for (Int_t i = 0; valid && i < dimension; ++i) {
+         formulas.emplace_back(new TTreeFormula(TString::Format("Var%i", i + 1), exprs[i], &check));
+         valid &= formulas.back()->GetNdim() > 0 && !formulas.back()->EvalClass() && !formulas.back()->IsString();
+      }
+      formulas.clear();
+      gErrorIgnoreLevel = errorLevel;
+      if (!valid)
+         return -1;
+   }
+
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(elist ? new ROOT::TTreeProcessorMT(*fTree, *elist) : new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &) {
+      return -1;
+   }
+
+   if (hist) {
+      if (!parser.GetAdd())
+         hist->Reset();
+   } else {
+      TCut realSelection(selection);
+      if (!enlist) {
+         enlist = new TEntryList(parser.GetObjectName(), realSelection.GetTitle());
+      } else if (!parser.GetAdd()) {
+         enlist->Reset();
+         enlist->SetTitle(realSelection.GetTitle());
+      } else {
+         TCut old = enlist->GetTitle();
+         TCut upd = old || realSelection.GetTitle();
+         enlist->SetTitle(upd.GetTitle());
+      }
+   }
+
+   // Same weights as TSelectorDraw, see TChain::GetWeight.
+   const Bool_t globalWeight = !isChain || fTree->TestBit(TChain::kGlobalWeight);
+   const Double_t weight = globalWeight ? fTree->GetWeight() : 1.;
+   std::mutex slotsMutex;
+   std::map<std::thread::id, TDrawMTSlot> slots;
+   std::atomic<Long64_t> nfilled(0);
+
+   // The rows of the clusters, ordered by file and entry. The clusters followed
+   // by at least estimate rows are dropped: the values arrays only hold the
+   // last GetSelectedRows() % GetEstimate() rows.
+   const Long64_t estimate = fTree->GetEstimate();
+   std::map<TString, Int_t> fileIndices;
+   if (isChain) {
+      for (TObject *element : *static_cast<TChain *>(fTree)->GetListOfFiles())
+         fileIndices.emplace(element->GetTitle(), fileIndices.size());
+   }
+   std::multimap<std::pair<Int_t, Long64_t>, TDrawMTRows> clusterRows;
+
+   auto fillCluster = [&](TTreeReader &reader) {
+      TDrawMTSlot *slot = nullptr;
+      Bool_t nested = kFALSE;
+      {
+         std::lock_guard<std::mutex> lock(slotsMutex);
+         slot = &slots[std::this_thread::get_id()];
+         if (!slot->fPartial) {
+            TDirectory::TContext ctxt(nullptr);
+            if (hist) {
+               TH1 *clone = static_cast<TH1 *>(hist->Clone());
+               clone->SetDirectory(nullptr);
+               clone->Reset();
+               slot->fPartial.reset(clone);
+            } else {
+               slot->fPartial.reset(new TEntryList());
+            }
+         }
+         // A thread waiting for other tasks (e.g. while reading) may process
+         // another cluster, which then needs its own formulas.
+         nested = slot->fBusy;
+         slot->fBusy = kTRUE;
+      }
+      TH1 *h = hist ? static_cast<TH1 *>(slot->fPartial.get()) : nullptr;
+      TEntryList *el = hist ? nullptr : static_cast<TEntryList *>(slot->fPartial.get());
+
+      TTree *chain = reader.GetTree();
+      TDrawMTRows rows;
+      TDrawMTRows *keptRows = hist ? &rows : nullptr;
+      if (nested) {
+         TDrawMTFormulas formulas(chain, select, exprs);
+         nfilled += formulas.Fill(reader, h, el, globalWeight, weight, keptRows);
+      } else {
+         if (!slot->fFormulas || !slot->fFormulas->IsFor(chain))
+            slot->fFormulas.reset(new TDrawMTFormulas(chain, select, exprs));
+         nfilled += slot->fFormulas->Fill(reader, h, el, globalWeight, weight, keptRows);
+      }
+
+      std::lock_guard<std::mutex> lock(slotsMutex);
+      if (!nested)
+         slot->fBusy = kFALSE;
+      if (rows.fW.empty())
+         return;
+      auto fileIndex = fileIndices.find(TDrawMTFormulas::GetFirstFile(chain));
+      const Int_t file = fileIndex != fileIndices.end() ? fileIndex->second : 0;
+      clusterRows.emplace(std::make_pair(file, rows.fFirstEntry), std::move(rows));
+      Long64_t following = 0;
+      for (auto iter = clusterRows.rbegin(); iter != clusterRows.rend(); ++iter) {
+         if (following >= estimate) {
+            clusterRows.erase(clusterRows.begin(), iter.base());
+            break;
+         }
+         following += iter->second.fW.size();
+      }
+   };
+
+   processor->Process(fillCluster);
+
+   // the formulas refer to the chains of the processor
+   for (auto &slot : slots)
+      slot.second.fFormulas.reset();
+   processor.reset();
+
+   if (gDebug > 0)
+      Info("DrawSelect", "%lld values filled in parallel into %s", (Long64_t)nfilled, parser.GetObjectName().Data());
+
+   if (enlist) {
+      // The partial lists are merged a block at a time, see TEntryListBlock::Merge
+      for (auto &slot : slots)
+         enlist->Add(static_cast<TEntryList *>(slot.second.fPartial.get()));
+      enlist->OptimizeStorage();
+      fSelector->SetValues(fTree, 0, nfilled, 0, nullptr, nullptr);
+      fDimension = 0;
+      return nfilled;
+   }
+
+   TList partialList;
+   for (auto &slot : slots)
+      partialList.Add(slot.second.fPartial.get());
+   if (partialList.GetSize())
+      hist->Merge(&partialList);
+   partialList.Clear("nodelete");
+
+   // Same values arrays as left by TSelectorDraw: the last nfilled % estimate rows.
+   Long64_t skip = -(nfilled % estimate);
+   for (auto &cluster : clusterRows)
+      skip += cluster.second.fW.size();
+   std::vector<Double_t> values[3], weights;
+   for (auto &cluster : clusterRows) {
+      const TDrawMTRows &rows = cluster.second;
+      const Long64_t first = std::min<Long64_t>(skip, rows.fW.size());
+      skip -= first;
+      for (Int_t k = 0; k < dimension; ++k)
+         values[k].insert(values[k].end(), rows.fVal[k].begin() + first, rows.fVal[k].end());
+      weights.insert(weights.end(), rows.fW.begin() + first, rows.fW.end());
+   }
+   Double_t *valuesPtr[3] = {values[0].data(), values[1].data(), values[2].data()};
+   fSelector->SetValues(fTree, dimension, nfilled, weights.size(), valuesPtr, weights.data());
+
+   fDimension = dimension;
+   fHistogram = hist;
+   return nfilled;
+#else
+   (void)varexp; (void)selection; (void)option; (void)nentries; (void)firstentry;
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fit  a projected item(s) from a Tree.
 /// Returns -1 in case of error or number of selected events in case of success.
@@ -228,6 +228,15 @@ TTreeReader::~TTreeReader()
    if (fTree && fNotify.IsLinked())
       fNotify.RemoveLink(*fTree);
 
+   // The cache outlives the reader and might outlive its entry list.
+   if (fEntryList && fTree && fTree->GetTree()) {
+      if (const auto curFile = fTree->GetCurrentFile()) {
+         auto tc = fTree->GetTree()->GetReadCache(curFile);
+         if (tc && tc->GetEntryList() == fEntryList)
+            tc->SetEntryList(nullptr);
+      }
+   }
+
    // Need to clear the map of proxies before deleting the director otherwise
    // they will have a dangling pointer.
    fProxies.clear();
@@ -336,9 +345,13 @@ Bool_t TTreeReader::SetProxies() {
    //    upon creation of the TTreeReader{Value, Array}s
    // 3. We stop the learning phase.
    // Operations 1, 2 and 3 need to happen in this order. See: https://sft.its.cern.ch/jira/browse/ROOT-9773?focusedCommentId=87837
+   // If we read through a TEntryList, the cache prefetches only the baskets
+   // with selected entries. For a chain this needs the entries to be local to
+   // each tree, i.e. a list with sub-lists.
    if (fProxiesSet) {
       const auto curFile = fTree->GetCurrentFile();
-      if (curFile && fTree->GetTree()->GetReadCache(curFile, true)) {
+      if (auto tc = curFile ? fTree->GetTree()->GetReadCache(curFile, true) : nullptr) {
+         tc->SetEntryList((fEntryList && (!IsChain() || fEntryList->GetLists())) ? fEntryList : nullptr);
          if (!(-1LL == fEndEntry && 0ULL == fBeginEntry)) {
             // We need to avoid to pass -1 as end entry to the SetCacheEntryRange method
             const auto lastEntry = (-1LL == fEndEntry) ? fTree->GetEntriesFast() : fEndEntry;
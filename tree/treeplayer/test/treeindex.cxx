@@ -0,0 +1,270 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeHashIndex.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Write a tree with unsorted, partly duplicated (run, event) pairs.
+static std::map<std::pair<Long64_t, Long64_t>, Long64_t> WriteIndexTree(const char *filename)
+{
+   std::map<std::pair<Long64_t, Long64_t>, Long64_t> firstEntry;
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   Int_t run = 0;
+   Long64_t event = 0;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.SetAutoFlush(1000);
+   for (Long64_t i = 0; i < 10000; ++i) {
+      run = (i * 7919) % 13;
+      event = (i * 104729) % 3001;
+      firstEntry.emplace(std::make_pair(Long64_t(run), event), i);
+      t.Fill();
+   }
+   t.Write();
+   return firstEntry;
+}
+
+TEST(TTreeIndex, LookupMatchesContent)
+{
+   const char *filename = "treeindex_lookup.root";
+   auto expected = WriteIndexTree(filename);
+
+   std::unique_ptr<TFile> f(TFile::Open(filename));
+   auto t = f->Get<TTree>("t");
+   ASSERT_GT(t->BuildIndex("run", "event"), 0);
+   auto index = static_cast<TTreeIndex *>(t->GetTreeIndex());
+
+   Int_t run = 0;
+   Long64_t event = 0;
+   t->SetBranchAddress("run", &run);
+   t->SetBranchAddress("event", &event);
+   for (const auto &kv : expected) {
+      const auto entry = index->GetEntryNumberWithIndex(kv.first.first, kv.first.second);
+      ASSERT_GE(entry, 0);
+      t->GetEntry(entry);
+      EXPECT_EQ(run, kv.first.first);
+      EXPECT_EQ(event, kv.first.second);
+   }
+   EXPECT_EQ(index->GetEntryNumberWithIndex(13, 0), -1);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(-1, 0), -1);
+   EXPECT_EQ(index->GetEntryNumberWithBestIndex(-1, 0), -1);
+
+   // The sorted values must be non-decreasing
+   const auto n = index->GetN();
+   const auto major = index->GetIndexValues();
+   const auto minor = index->GetIndexValuesMinor();
+   for (Long64_t i = 1; i < n; ++i)
+      EXPECT_TRUE(major[i - 1] < major[i] || (major[i - 1] == major[i] && minor[i - 1] <= minor[i]));
+
+   f.reset();
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreeHashIndex, UnsortedChainAsFriend)
+{
+   // Two files covering interleaved event numbers, in reverse order
+   const char *filenames[] = {"treehashindex_0.root", "treehashindex_1.root"};
+   for (int file = 0; file < 2; ++file) {
+      TFile f(filenames[file], "RECREATE");
+      TTree t("reco", "reco");
+      Int_t run = 1;
+      Int_t event = 0;
+      Double_t energy = 0.;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      t.Branch("energy", &energy);
+      for (int i = 99; i >= 0; --i) {
+         event = 2 * i + file;
+         energy = 10. * event;
+         t.Fill();
+      }
+      t.Write();
+   }
+   {
+      TFile f("treehashindex_main.root", "RECREATE");
+      TTree t("main", "main");
+      Int_t run = 1;
+      Int_t event = 0;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      for (event = 0; event < 200; ++event)
+         t.Fill();
+      t.Write();
+   }
+
+   TChain reco("reco");
+   reco.Add(filenames[0]);
+   reco.Add(filenames[1]);
+   auto index = new TTreeHashIndex(&reco, "run", "event");
+   ASSERT_FALSE(index->IsZombie());
+   EXPECT_EQ(index->GetN(), 200);
+   reco.SetTreeIndex(index);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(1, 198), 0);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(1, 1), 199);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(1, 200), -1);
+
+   TChain main("main");
+   main.Add("treehashindex_main.root");
+   main.AddFriend(&reco);
+   Int_t event = 0;
+   Double_t energy = 0.;
+   main.SetBranchAddress("event", &event);
+   main.SetBranchAddress("reco.energy", &energy);
+   for (Long64_t i = 0; i < main.GetEntries(); ++i) {
+      main.GetEntry(i);
+      EXPECT_DOUBLE_EQ(energy, 10. * event);
+   }
+
+   main.RemoveFriend(&reco);
+   reco.SetTreeIndex(nullptr);
+   delete index;
+   for (auto name : filenames)
+      gSystem->Unlink(name);
+   gSystem->Unlink("treehashindex_main.root");
+}
+
+// Check all the lookups of 'index' against the first entry of each (run, event) pair.
+static void ExpectHashLookups(const TVirtualIndex &index, const std::map<std::pair<Long64_t, Long64_t>, Long64_t> &expected)
+{
+   for (const auto &kv : expected)
+      EXPECT_EQ(index.GetEntryNumberWithIndex(kv.first.first, kv.first.second), kv.second)
+         << "run " << kv.first.first << " event " << kv.first.second;
+   EXPECT_EQ(index.GetEntryNumberWithIndex(13, 0), -1);
+   EXPECT_EQ(index.GetEntryNumberWithBestIndex(13, 0), -1);
+}
+
+TEST(TTreeHashIndex, BuildIndexOption)
+{
+   const char *filename = "treehashindex_option.root";
+   auto expected = WriteIndexTree(filename);
+
+   std::unique_ptr<TFile> f(TFile::Open(filename));
+   auto t = f->Get<TTree>("t");
+   ASSERT_EQ(t->BuildIndex("run", "event", "hash"), 10000);
+   ASSERT_EQ(t->GetTreeIndex()->IsA(), TTreeHashIndex::Class());
+   ExpectHashLookups(*t->GetTreeIndex(), expected);
+   // the entries are the ones with the same values
+   Int_t run = 0;
+   Long64_t event = 0;
+   t->SetBranchAddress("run", &run);
+   t->SetBranchAddress("event", &event);
+   const auto last = *expected.rbegin();
+   ASSERT_GT(t->GetEntryWithIndex(last.first.first, last.first.second), 0);
+   EXPECT_EQ(run, last.first.first);
+   EXPECT_EQ(event, last.first.second);
+
+   f.reset();
+   gSystem->Unlink(filename);
+}
+
+// The index values are stored, the hash table is rebuilt when reading
+TEST(TTreeHashIndex, Streamer)
+{
+   const char *filename = "treehashindex_streamer.root";
+   auto expected = WriteIndexTree(filename);
+   {
+      std::unique_ptr<TFile> f(TFile::Open(filename, "UPDATE"));
+      auto t = f->Get<TTree>("t");
+      ASSERT_EQ(t->BuildIndex("run", "event", "hash"), 10000);
+      // with its tree and on its own
+      t->Write("", TObject::kOverwrite);
+      t->GetTreeIndex()->Write("hashindex");
+   }
+
+   std::unique_ptr<TFile> f(TFile::Open(filename));
+   auto t = f->Get<TTree>("t");
+   ASSERT_NE(t->GetTreeIndex(), nullptr);
+   ASSERT_EQ(t->GetTreeIndex()->IsA(), TTreeHashIndex::Class());
+   EXPECT_EQ(t->GetTreeIndex()->GetN(), 10000);
+   ExpectHashLookups(*t->GetTreeIndex(), expected);
+
+   std::unique_ptr<TTreeHashIndex> index(f->Get<TTreeHashIndex>("hashindex"));
+   ASSERT_NE(index, nullptr);
+   EXPECT_EQ(index->GetN(), 10000);
+   ExpectHashLookups(*index, expected);
+
+   f.reset();
+   gSystem->Unlink(filename);
+}
+
+#ifdef R__USE_IMT
+// With implicit MT, the files of a chain are read in parallel. The entries are
+// numbered as in the chain, only the number of entries the chain has for each
+// file are used, and the result is the same as the serial reading.
+TEST(TTreeHashIndex, ParallelChain)
+{
+   const int nfiles = 3;
+   const Long64_t nentries = 3000;
+   // the second file is used only in part
+   const Long64_t chainEntries[nfiles] = {nentries, 1000, nentries};
+   std::vector<std::string> filenames;
+   std::map<std::pair<Long64_t, Long64_t>, Long64_t> expected, expectedAll;
+   Long64_t offset = 0, offsetAll = 0;
+   for (int file = 0; file < nfiles; ++file) {
+      filenames.push_back("treehashindex_mt_" + std::to_string(file) + ".root");
+      TFile f(filenames.back().c_str(), "RECREATE");
+      TTree t("t", "t");
+      Int_t run = 0;
+      Long64_t event = 0;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      for (Long64_t i = 0; i < nentries; ++i) {
+         // values overlapping between the files
+         run = (i * 7919 + file) % 13;
+         event = (i * 104729 + 17 * file) % 3001;
+         if (i < chainEntries[file])
+            expected.emplace(std::make_pair(Long64_t(run), event), offset + i);
+         expectedAll.emplace(std::make_pair(Long64_t(run), event), offsetAll + i);
+         t.Fill();
+      }
+      t.Write();
+      offset += chainEntries[file];
+      offsetAll += nentries;
+   }
+
+   ROOT::EnableImplicitMT(2);
+
+   TChain limited("t");
+   for (int file = 0; file < nfiles; ++file)
+      limited.Add(filenames[file].c_str(), chainEntries[file]);
+   const Int_t oldDebug = gDebug;
+   gDebug = 1;
+   testing::internal::CaptureStderr();
+   TTreeHashIndex limitedIndex(&limited, "run", "event");
+   const std::string out = testing::internal::GetCapturedStderr();
+   gDebug = oldDebug;
+   EXPECT_NE(out.find("read in parallel"), std::string::npos) << out;
+   ASSERT_FALSE(limitedIndex.IsZombie());
+   EXPECT_EQ(limitedIndex.GetN(), offset);
+   ExpectHashLookups(limitedIndex, expected);
+
+   TChain chain("t");
+   for (const auto &name : filenames)
+      chain.Add(name.c_str());
+   TTreeHashIndex parallelIndex(&chain, "run", "event");
+   ROOT::DisableImplicitMT();
+   TTreeHashIndex serialIndex(&chain, "run", "event");
+   ASSERT_EQ(parallelIndex.GetN(), offsetAll);
+   ASSERT_EQ(serialIndex.GetN(), offsetAll);
+   for (Long64_t i = 0; i < offsetAll; ++i) {
+      ASSERT_EQ(parallelIndex.GetIndex()[i], serialIndex.GetIndex()[i]);
+      ASSERT_EQ(parallelIndex.GetIndexValues()[i], serialIndex.GetIndexValues()[i]);
+      ASSERT_EQ(parallelIndex.GetIndexValuesMinor()[i], serialIndex.GetIndexValuesMinor()[i]);
+   }
+   ExpectHashLookups(parallelIndex, expectedAll);
+
+   for (const auto &name : filenames)
+      gSystem->Unlink(name.c_str());
+}
+#endif
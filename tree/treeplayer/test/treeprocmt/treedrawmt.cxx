@@ -0,0 +1,234 @@
+#include <string>
+#include <vector>
+
+#include <TChain.h>
+#include <TDirectory.h>
+#include <TEntryList.h>
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+static void WriteDrawFiles(const std::string &treename, const std::vector<std::string> &filenames)
+{
+   int n = 0;
+   float x[10];
+   double y = 0.;
+   int entry = 0;
+   for (const auto &f : filenames) {
+      TFile file(f.c_str(), "recreate");
+      TTree t(treename.c_str(), treename.c_str());
+      t.Branch("n", &n);
+      t.Branch("x", x, "x[n]/F");
+      t.Branch("y", &y);
+      t.SetAutoFlush(100);
+      for (auto i = 0; i < 1000; ++i, ++entry) {
+         n = entry % 10;
+         for (auto j = 0; j < n; ++j)
+            x[j] = (entry * 7 + j * 13) % 100;
+         y = (entry % 50) - 25.;
+         t.Fill();
+      }
+      t.Write();
+   }
+}
+
+// Project with implicit multi-threading, checking that the parallel path was taken
+static Long64_t ProjectMT(TTree &t, const char *hname, const char *varexp, const char *selection)
+{
+   ROOT::EnableImplicitMT(4);
+   const auto debug = gDebug;
+   gDebug = 1;
+   testing::internal::CaptureStderr();
+   const auto n = t.Project(hname, varexp, selection);
+   const auto err = testing::internal::GetCapturedStderr();
+   gDebug = debug;
+   ROOT::DisableImplicitMT();
+   EXPECT_NE(err.find("filled in parallel"), std::string::npos) << err;
+   return n;
+}
+
+static void SetTreeWeight(const std::string &filename, const std::string &treename, double weight)
+{
+   TFile file(filename.c_str(), "update");
+   auto t = file.Get<TTree>(treename.c_str());
+   t->SetWeight(weight);
+   t->Write("", TObject::kOverwrite);
+}
+
+static void ExpectSameContent(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   for (auto i = 0; i < h1.GetNcells(); ++i)
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(i), h2.GetBinContent(i));
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   EXPECT_DOUBLE_EQ(h1.GetMean(), h2.GetMean());
+}
+
+TEST(TreeDrawMT, ProjectMatchesSequential)
+{
+   const std::vector<std::string> filenames{"treedrawmt_0.root", "treedrawmt_1.root", "treedrawmt_2.root"};
+   WriteDrawFiles("t", filenames);
+
+   TChain c("t");
+   for (const auto &f : filenames)
+      c.Add(f.c_str());
+
+   TH1D hseq("hseq", "", 100, 0, 100);
+   TH2D h2seq("h2seq", "", 100, 0, 100, 50, -25, 25);
+   const auto nseq = c.Project("hseq", "x", "y > 0");
+   const auto n2seq = c.Project("h2seq", "y:x", "x > 10");
+
+   // the chain of the user is not loaded by the parallel path
+   TChain cmt("t");
+   for (const auto &f : filenames)
+      cmt.Add(f.c_str());
+   TH1D hmt("hmt", "", 100, 0, 100);
+   TH2D h2mt("h2mt", "", 100, 0, 100, 50, -25, 25);
+   const auto nmt = ProjectMT(cmt, "hmt", "x", "y > 0");
+   const auto n2mt = ProjectMT(cmt, "h2mt", "y:x", "x > 10");
+   EXPECT_EQ(cmt.GetTreeNumber(), -1);
+   EXPECT_EQ(cmt.GetTree(), nullptr);
+
+   EXPECT_EQ(nseq, nmt);
+   EXPECT_EQ(n2seq, n2mt);
+   ExpectSameContent(hseq, hmt);
+   ExpectSameContent(h2seq, h2mt);
+
+   for (const auto &f : filenames)
+      gSystem->Unlink(f.c_str());
+}
+
+// The entries of a chain are weighted with the weight of their tree
+TEST(TreeDrawMT, ChainTreeWeights)
+{
+   const std::vector<std::string> filenames{"treedrawmt_w0.root", "treedrawmt_w1.root", "treedrawmt_w2.root"};
+   WriteDrawFiles("t", filenames);
+   SetTreeWeight(filenames[1], "t", 2.);
+   SetTreeWeight(filenames[2], "t", 0.5);
+
+   TChain c("t");
+   for (const auto &f : filenames)
+      c.Add(f.c_str());
+   TH1D hseq("hwseq", "", 100, 0, 100);
+   const auto nseq = c.Project("hwseq", "x", "y > 0");
+
+   TChain cmt("t");
+   for (const auto &f : filenames)
+      cmt.Add(f.c_str());
+   TH1D hmt("hwmt", "", 100, 0, 100);
+   const auto nmt = ProjectMT(cmt, "hwmt", "x", "y > 0");
+
+   EXPECT_EQ(nseq, nmt);
+   ExpectSameContent(hseq, hmt);
+   EXPECT_DOUBLE_EQ(hseq.GetSumOfWeights(), hmt.GetSumOfWeights());
+
+   for (const auto &f : filenames)
+      gSystem->Unlink(f.c_str());
+}
+
+// The global weight of a chain replaces the weights of its trees
+TEST(TreeDrawMT, ChainGlobalWeight)
+{
+   const std::vector<std::string> filenames{"treedrawmt_g0.root", "treedrawmt_g1.root"};
+   WriteDrawFiles("t", filenames);
+   SetTreeWeight(filenames[1], "t", 2.);
+
+   TChain c("t");
+   for (const auto &f : filenames)
+      c.Add(f.c_str());
+   c.SetWeight(3., "global");
+   TH1D hseq("hgseq", "", 100, 0, 100);
+   const auto nseq = c.Project("hgseq", "x", "y > 0");
+
+   TChain cmt("t");
+   for (const auto &f : filenames)
+      cmt.Add(f.c_str());
+   cmt.SetWeight(3., "global");
+   TH1D hmt("hgmt", "", 100, 0, 100);
+   const auto nmt = ProjectMT(cmt, "hgmt", "x", "y > 0");
+
+   EXPECT_EQ(nseq, nmt);
+   ExpectSameContent(hseq, hmt);
+   EXPECT_DOUBLE_EQ(hseq.GetSumOfWeights(), hmt.GetSumOfWeights());
+
+   for (const auto &f : filenames)
+      gSystem->Unlink(f.c_str());
+}
+
+// The values arrays hold the same last GetSelectedRows() % GetEstimate() rows as after the sequential loop
+TEST(TreeDrawMT, ValuesMatchSequential)
+{
+   const std::vector<std::string> filenames{"treedrawmt_v0.root", "treedrawmt_v1.root", "treedrawmt_v2.root"};
+   WriteDrawFiles("t", filenames);
+   SetTreeWeight(filenames[1], "t", 2.);
+
+   for (Long64_t estimate : {100000LL, 1234LL}) {
+      TChain c("t");
+      TChain cmt("t");
+      for (const auto &f : filenames) {
+         c.Add(f.c_str());
+         cmt.Add(f.c_str());
+      }
+      c.SetEstimate(estimate);
+      cmt.SetEstimate(estimate);
+
+      TH2D hseq("hvseq", "", 100, 0, 100, 50, -25, 25);
+      TH2D hmt("hvmt", "", 100, 0, 100, 50, -25, 25);
+      const auto nseq = c.Project("hvseq", "y:x", "x > 10");
+      const auto nmt = ProjectMT(cmt, "hvmt", "y:x", "x > 10");
+      ASSERT_EQ(nseq, nmt);
+      ASSERT_EQ(c.GetSelectedRows(), cmt.GetSelectedRows());
+      ASSERT_NE(cmt.GetV1(), nullptr);
+      ASSERT_NE(cmt.GetV2(), nullptr);
+      ASSERT_NE(cmt.GetW(), nullptr);
+      EXPECT_EQ(cmt.GetV3(), nullptr);
+
+      const auto nlast = c.GetSelectedRows() % estimate;
+      for (Long64_t i = 0; i < nlast; ++i) {
+         EXPECT_EQ(c.GetV1()[i], cmt.GetV1()[i]) << "estimate " << estimate << ", row " << i;
+         EXPECT_EQ(c.GetV2()[i], cmt.GetV2()[i]) << "estimate " << estimate << ", row " << i;
+         EXPECT_EQ(c.GetW()[i], cmt.GetW()[i]) << "estimate " << estimate << ", row " << i;
+      }
+   }
+
+   for (const auto &f : filenames)
+      gSystem->Unlink(f.c_str());
+}
+
+TEST(TreeDrawMT, EntryListMatchesSequential)
+{
+   const std::vector<std::string> filenames{"treedrawmt_elist.root"};
+   WriteDrawFiles("t", filenames);
+
+   TFile f(filenames[0].c_str());
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+
+   const auto nseq = t->Draw(">>elseq", "y > 0 && Sum$(x) > 100", "entrylist goff");
+   ROOT::EnableImplicitMT(4);
+   const auto debug = gDebug;
+   gDebug = 1;
+   testing::internal::CaptureStderr();
+   const auto nmt = t->Draw(">>elmt", "y > 0 && Sum$(x) > 100", "entrylist goff");
+   const auto err = testing::internal::GetCapturedStderr();
+   gDebug = debug;
+   ROOT::DisableImplicitMT();
+   EXPECT_NE(err.find("filled in parallel"), std::string::npos) << err;
+
+   auto elseq = static_cast<TEntryList *>(gDirectory->Get("elseq"));
+   auto elmt = static_cast<TEntryList *>(gDirectory->Get("elmt"));
+   ASSERT_NE(elseq, nullptr);
+   ASSERT_NE(elmt, nullptr);
+   EXPECT_EQ(nseq, nmt);
+   ASSERT_EQ(elseq->GetN(), elmt->GetN());
+   for (Long64_t i = 0; i < elseq->GetN(); ++i)
+      EXPECT_EQ(elseq->GetEntry(i), elmt->GetEntry(i));
+
+   f.Close();
+   gSystem->Unlink(filenames[0].c_str());
+}